@@ -0,0 +1,481 @@
+/**
+ * @file AsyncWriter.cpp
+ * @class AsyncWriter AsyncWriter.h "AsyncWriter.h"
+ * @author  Al Timofeyev
+ * @date    May 12, 2019
+ * @brief   Writes output files in the background, so saving results never
+ *          holds up the computation. Uses io_uring where the kernel
+ *          supports it, and a small pool of pwrite threads otherwise.
+ *
+ * The computing thread hands over the whole contents of a file and carries
+ * on. With io_uring, one writer thread keeps up to ASYNC_WRITER_RING_ENTRIES
+ * files in flight: each file gets a write (repeated if it comes back short)
+ * followed by an fsync, all submitted and reaped through the shared rings.
+ * Without it (another OS, an old kernel, or a sandbox that forbids it),
+ * ASYNC_WRITER_THREADS threads each pwrite and fsync one file at a time.
+ *
+ * Every file handed over is counted until its fsync completes, and drain()
+ * waits for the count to reach zero and then flushes the directories the
+ * files were created in, so everything is durable once it returns. finish()
+ * drains the writer a last time and reports the files that failed.
+ */
+
+#include "AsyncWriter.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#define ASYNC_WRITER_HAS_PWRITE
+#endif
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define ASYNC_WRITER_HAS_IO_URING
+#endif
+#endif
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief The constructor for the AsyncWriter class, starts the writer thread(s).
+ * @param tryRing If true io_uring is used when the kernel supports it, otherwise the pwrite threads are always used.
+ */
+AsyncWriter::AsyncWriter(bool tryRing)
+{
+    isStopping = false;
+    pendingFiles = 0;
+    failedFiles = 0;
+    hasRing = false;
+    ringFd = -1;
+    submissionRing = completionRing = submissionEntries = NULL;
+
+    if(tryRing && setupRing())
+    {
+        hasRing = true;
+        writers.emplace_back(&AsyncWriter::ringLoop, this);
+    }
+    else
+    {
+        for(int i = 0; i < ASYNC_WRITER_THREADS; i++)
+            writers.emplace_back(&AsyncWriter::poolLoop, this);
+    }
+}
+
+/**
+ * @brief The destructor for the AsyncWriter class.
+ * Waits for every file to be on disk, then stops the writer thread(s).
+ */
+AsyncWriter::~AsyncWriter()
+{
+    finish();
+
+    {
+        lock_guard<mutex> lock(requestsLock);
+        isStopping = true;
+    }
+    requestsSignal.notify_all();
+    for(int i = 0; i < writers.size(); i++)
+        writers[i].join();
+
+#ifdef ASYNC_WRITER_HAS_IO_URING
+    if(hasRing)
+    {
+        munmap(submissionEntries, submissionEntriesSize);
+        if(completionRing != submissionRing)
+            munmap(completionRing, completionRingSize);
+        munmap(submissionRing, submissionRingSize);
+        close(ringFd);
+    }
+#endif
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PUBLIC FUNCTIONS BELOW ------------------
+// ----------------------------------------------------------
+/**
+ * @brief Hands a file to the writer, returns right away.
+ *
+ * The file is created (or truncated) and written in the background; call
+ * finish() to wait for it.
+ *
+ * @param filename The file to (over)write.
+ * @param contents Everything that goes in the file.
+ */
+void AsyncWriter::write(string filename, string contents)
+{
+    unique_ptr<WriteRequest> request(new WriteRequest());
+    request->filename = filename;
+    request->contents = move(contents);
+    request->fd = -1;
+    request->written = 0;
+    request->isSyncing = false;
+
+    // Remember the directory, it's flushed too so the new file's entry is durable.
+    size_t slash = filename.find_last_of('/');
+    string directory = (slash == string::npos) ? "." : (slash == 0 ? "/" : filename.substr(0, slash));
+
+    {
+        lock_guard<mutex> lock(requestsLock);
+        requests.push(move(request));
+        directories.insert(directory);
+        pendingFiles++;
+    }
+    requestsSignal.notify_all();
+}
+
+/**
+ * @brief Waits until every file handed over so far is on disk.
+ *
+ * The writer keeps running, so more files can be handed over afterwards.
+ * Call this before recording that the files exist (in a checkpoint, say).
+ * Failures are kept, finish() still reports them.
+ *
+ * @return True if every file so far was written and flushed, false if any failed.
+ */
+bool AsyncWriter::drain()
+{
+    set<string> flushDirectories;
+    int failures;
+    {
+        unique_lock<mutex> lock(requestsLock);
+        doneSignal.wait(lock, [this]{ return pendingFiles == 0; });
+        flushDirectories.swap(directories);
+        failures = failedFiles;
+    }
+
+#ifdef ASYNC_WRITER_HAS_PWRITE
+    // Flush the directories, so the entries of newly created files are durable too.
+    for(set<string>::iterator it = flushDirectories.begin(); it != flushDirectories.end(); ++it)
+    {
+        int directoryFd = open(it->c_str(), O_RDONLY);
+        if(directoryFd >= 0)
+        {
+            fsync(directoryFd);
+            close(directoryFd);
+        }
+    }
+#endif
+
+    return failures == 0;
+}
+
+/**
+ * @brief Waits until every file handed over is on disk.
+ * @return True if every file was written and flushed, false if any failed.
+ */
+bool AsyncWriter::finish()
+{
+    drain();
+
+    int failures;
+    {
+        lock_guard<mutex> lock(requestsLock);
+        failures = failedFiles;
+        failedFiles = 0;
+    }
+
+    if(failures > 0)
+        cout << "Failed to write " << failures << " output file(s).\n";
+    return failures == 0;
+}
+
+/**
+ * @brief Returns the way the files are written.
+ * @return "io_uring" or "pwrite".
+ */
+string AsyncWriter::getBackend()
+{
+    return hasRing ? "io_uring" : "pwrite";
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PRIVATE FUNCTIONS BELOW -----------------
+// ----------------------------------------------------------
+/**
+ * @brief Creates and maps the io_uring.
+ *
+ * The kernel has to support the plain write operation (Linux 5.6 and up);
+ * a probe is used to check, since older rings only take vectored writes.
+ *
+ * @return True if the ring is ready, false if the kernel doesn't support or allow it.
+ */
+bool AsyncWriter::setupRing()
+{
+#ifdef ASYNC_WRITER_HAS_IO_URING
+    struct io_uring_params params = {};
+    ringFd = syscall(__NR_io_uring_setup, ASYNC_WRITER_RING_ENTRIES, &params);
+    if(ringFd < 0)
+        return false;
+
+    // Check that the write operation is supported.
+    vector<char> probeBuffer(sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op), 0);
+    struct io_uring_probe *probe = (struct io_uring_probe*)probeBuffer.data();
+    if(syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, 256) < 0 ||
+       probe->ops_len <= IORING_OP_WRITE || !(probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED))
+    {
+        close(ringFd);
+        return false;
+    }
+
+    // Map the submission and completion rings (one mapping on newer kernels) and the submission entries.
+    submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool isSingleMapping = params.features & IORING_FEAT_SINGLE_MMAP;
+    if(isSingleMapping)
+        submissionRingSize = completionRingSize = max(submissionRingSize, completionRingSize);
+
+    submissionRing = mmap(NULL, submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if(submissionRing == MAP_FAILED)
+    {
+        close(ringFd);
+        return false;
+    }
+    completionRing = submissionRing;
+    if(!isSingleMapping)
+    {
+        completionRing = mmap(NULL, completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        if(completionRing == MAP_FAILED)
+        {
+            munmap(submissionRing, submissionRingSize);
+            close(ringFd);
+            return false;
+        }
+    }
+    submissionEntriesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    submissionEntries = mmap(NULL, submissionEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if(submissionEntries == MAP_FAILED)
+    {
+        if(completionRing != submissionRing)
+            munmap(completionRing, completionRingSize);
+        munmap(submissionRing, submissionRingSize);
+        close(ringFd);
+        return false;
+    }
+
+    char *sq = (char*)submissionRing;
+    submissionHead = (unsigned*)(sq + params.sq_off.head);
+    submissionTail = (unsigned*)(sq + params.sq_off.tail);
+    submissionMask = (unsigned*)(sq + params.sq_off.ring_mask);
+    submissionArray = (unsigned*)(sq + params.sq_off.array);
+
+    char *cq = (char*)completionRing;
+    completionHead = (unsigned*)(cq + params.cq_off.head);
+    completionTail = (unsigned*)(cq + params.cq_off.tail);
+    completionMask = (unsigned*)(cq + params.cq_off.ring_mask);
+    completionEntries = cq + params.cq_off.cqes;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Writes the queued files through the io_uring.
+ *
+ * Every file in flight has exactly one operation on the ring (a write or its
+ * fsync), so the ring never holds more than ASYNC_WRITER_RING_ENTRIES
+ * operations. New files are only waited for when nothing is in flight.
+ */
+void AsyncWriter::ringLoop()
+{
+#ifdef ASYNC_WRITER_HAS_IO_URING
+    vector<unique_ptr<WriteRequest>> inFlight;
+    while(true)
+    {
+        // Take new files, as many as fit on the ring.
+        vector<unique_ptr<WriteRequest>> arrived;
+        {
+            unique_lock<mutex> lock(requestsLock);
+            if(inFlight.size() == 0)
+                requestsSignal.wait(lock, [this]{ return isStopping || requests.size() > 0; });
+            if(isStopping && requests.size() == 0 && inFlight.size() == 0)
+                return;
+            while(requests.size() > 0 && inFlight.size() + arrived.size() < ASYNC_WRITER_RING_ENTRIES)
+            {
+                arrived.push_back(move(requests.front()));
+                requests.pop();
+            }
+        }
+
+        // Open them and queue their first write.
+        for(int i = 0; i < arrived.size(); i++)
+        {
+            if(!openFile(arrived[i].get()) || !submitNext(arrived[i].get()))
+            {
+                completeFile(arrived[i].get(), false);
+                continue;
+            }
+            inFlight.push_back(move(arrived[i]));
+        }
+        if(inFlight.size() == 0)
+            continue;
+
+        // Submit everything queued on the ring, and wait for at least one operation to complete.
+        unsigned queued = *submissionTail - __atomic_load_n(submissionHead, __ATOMIC_ACQUIRE);
+        syscall(__NR_io_uring_enter, ringFd, queued, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+
+        // Reap the completions: continue a short write, move on to the fsync, or finish the file.
+        unsigned head = *completionHead;
+        while(head != __atomic_load_n(completionTail, __ATOMIC_ACQUIRE))
+        {
+            struct io_uring_cqe *completion = (struct io_uring_cqe*)completionEntries + (head & *completionMask);
+            WriteRequest *request = (WriteRequest*)(uintptr_t)completion->user_data;
+            int result = completion->res;
+            head++;
+
+            bool isDone = false, ok = true;
+            if(result == -EINTR || result == -EAGAIN)
+                ok = submitNext(request);
+            else if(result < 0)
+                isDone = true, ok = false;
+            else if(request->isSyncing)
+                isDone = true;
+            else
+            {
+                request->written += result;
+                request->isSyncing = request->written == request->contents.size();
+                ok = (result > 0 || request->isSyncing) && submitNext(request);
+            }
+            if(!ok)
+                isDone = true;
+
+            if(isDone)
+            {
+                completeFile(request, ok);
+                for(int i = 0; i < inFlight.size(); i++)
+                    if(inFlight[i].get() == request)
+                    {
+                        inFlight[i] = move(inFlight.back());
+                        inFlight.pop_back();
+                        break;
+                    }
+            }
+        }
+        __atomic_store_n(completionHead, head, __ATOMIC_RELEASE);
+    }
+#endif
+}
+
+/**
+ * @brief Queues the next write or flush of a file on the io_uring (without submitting it).
+ * @param request The file.
+ * @return True if an operation was queued, false if the ring is full.
+ */
+bool AsyncWriter::submitNext(WriteRequest *request)
+{
+#ifdef ASYNC_WRITER_HAS_IO_URING
+    unsigned tail = *submissionTail;
+    if(tail - __atomic_load_n(submissionHead, __ATOMIC_ACQUIRE) >= ASYNC_WRITER_RING_ENTRIES)
+        return false;
+
+    unsigned index = tail & *submissionMask;
+    struct io_uring_sqe *entry = (struct io_uring_sqe*)submissionEntries + index;
+    *entry = {};
+    entry->fd = request->fd;
+    entry->user_data = (uintptr_t)request;
+    if(request->isSyncing)
+        entry->opcode = IORING_OP_FSYNC;
+    else
+    {
+        entry->opcode = IORING_OP_WRITE;
+        entry->addr = (uintptr_t)(request->contents.data() + request->written);
+        entry->len = request->contents.size() - request->written;
+        entry->off = request->written;
+    }
+
+    submissionArray[index] = index;
+    __atomic_store_n(submissionTail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Writes the queued files with pwrite, one at a time, until the writer stops.
+ */
+void AsyncWriter::poolLoop()
+{
+    while(true)
+    {
+        unique_ptr<WriteRequest> request;
+        {
+            unique_lock<mutex> lock(requestsLock);
+            requestsSignal.wait(lock, [this]{ return isStopping || requests.size() > 0; });
+            if(requests.size() == 0)
+                return;
+            request = move(requests.front());
+            requests.pop();
+        }
+
+#ifdef ASYNC_WRITER_HAS_PWRITE
+        bool ok = openFile(request.get());
+        while(ok && request->written < request->contents.size())
+        {
+            ssize_t count = pwrite(request->fd, request->contents.data() + request->written,
+                                   request->contents.size() - request->written, request->written);
+            if(count < 0 && errno == EINTR)
+                continue;
+            ok = count > 0;
+            if(ok)
+                request->written += count;
+        }
+        ok = ok && fsync(request->fd) == 0;
+#else
+        ofstream outputFile(request->filename, ios::binary);
+        outputFile << request->contents;
+        outputFile.close();
+        bool ok = !outputFile.fail();
+#endif
+        completeFile(request.get(), ok);
+    }
+}
+
+/**
+ * @brief Opens (and truncates) the file of a request.
+ * @param request The file.
+ * @return True if the file is open.
+ */
+bool AsyncWriter::openFile(WriteRequest *request)
+{
+#ifdef ASYNC_WRITER_HAS_PWRITE
+    request->fd = open(request->filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    request->isSyncing = request->contents.size() == 0;
+    return request->fd >= 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Closes a finished file and updates the accounting.
+ * @param request The file.
+ * @param ok True if the file was written and flushed.
+ */
+void AsyncWriter::completeFile(WriteRequest *request, bool ok)
+{
+#ifdef ASYNC_WRITER_HAS_PWRITE
+    if(request->fd >= 0)
+        close(request->fd);
+#endif
+    request->fd = -1;
+
+    {
+        lock_guard<mutex> lock(requestsLock);
+        pendingFiles--;
+        if(!ok)
+        {
+            failedFiles++;
+            cout << "Failed to write file: " << request->filename << endl;
+        }
+    }
+    doneSignal.notify_all();
+}
@@ -0,0 +1,88 @@
+/**
+ * @file AsyncWriter.h
+ * @author  Al Timofeyev
+ * @date    May 12, 2019
+ * @brief   Writes output files in the background, so saving results never
+ *          holds up the computation. Uses io_uring where the kernel
+ *          supports it, and a small pool of pwrite threads otherwise.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_ASYNCWRITER_H
+#define BENCHMARKFUNCTIONS2_ASYNCWRITER_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** The number of submission queue entries of the io_uring (also the most files written at once). */
+#define ASYNC_WRITER_RING_ENTRIES 64
+/** The number of threads writing files when io_uring isn't available. */
+#define ASYNC_WRITER_THREADS 2
+
+/**
+ * @brief A file waiting to be written, and how far along it is.
+ */
+struct WriteRequest
+{
+    string filename;    /**< The file to (over)write.*/
+    string contents;    /**< Everything that goes in the file.*/
+    int fd;             /**< The open file, or -1.*/
+    size_t written;     /**< The number of bytes of contents written so far.*/
+    bool isSyncing;     /**< True once the contents are written and the file is being flushed to disk.*/
+};
+
+class AsyncWriter{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    AsyncWriter(bool tryRing);  // Starts the io_uring writer, or the pwrite threads if that's not possible.
+    ~AsyncWriter();             // Waits for every file to be on disk.
+
+    // --------------------- Functions Declarations ---------------------
+    void write(string filename, string contents);   /**< Hands a file to the writer, returns right away.*/
+    bool drain();                                   /**< Waits until every file handed over so far is on disk, the writer stays usable.*/
+    bool finish();                                  /**< Waits until every file handed over is on disk, and reports the failures.*/
+    string getBackend();                            /**< Returns "io_uring" or "pwrite".*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    queue<unique_ptr<WriteRequest>> requests;
+    mutex requestsLock;
+    condition_variable requestsSignal;
+    condition_variable doneSignal;
+    bool isStopping;
+    int pendingFiles;
+    int failedFiles;
+    set<string> directories;
+    vector<thread> writers;
+
+    bool hasRing;
+    int ringFd;
+    void *submissionRing, *completionRing, *submissionEntries;
+    size_t submissionRingSize, completionRingSize, submissionEntriesSize;
+    unsigned *submissionHead, *submissionTail, *submissionMask, *submissionArray;
+    unsigned *completionHead, *completionTail, *completionMask;
+    void *completionEntries;
+
+    // --------------------- Functions Declarations ---------------------
+    bool setupRing();                                   /**< Creates and maps the io_uring, returns false if the kernel doesn't allow it.*/
+    void ringLoop();                                    /**< Writes the queued files through the io_uring.*/
+    bool submitNext(WriteRequest *request);             /**< Queues the next write or flush of a file on the io_uring.*/
+    void poolLoop();                                    /**< Writes the queued files with pwrite, one at a time.*/
+    bool openFile(WriteRequest *request);               /**< Opens (and truncates) the file of a request.*/
+    void completeFile(WriteRequest *request, bool ok);  /**< Closes a finished file and updates the accounting.*/
+};
+
+
+#endif //BENCHMARKFUNCTIONS2_ASYNCWRITER_H
@@ -26,7 +26,7 @@ double schefelsFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size; ++i)
-        summedUp += (-vect[i]) * sin(sqrt(abs(vect[i])));
+        summedUp += schefelsTerm(vect[i]);
 
     answer = (418.9829 * size) - summedUp;
 
@@ -47,7 +47,7 @@ double deJongsFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size; ++i)
-        answer += pow(vect[i], 2);
+        answer += deJongsTerm(vect[i]);
 
     return answer;
 }
@@ -66,7 +66,7 @@ double rosenbrockFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size-1; ++i)
-        answer += 100 * pow((pow(vect[i], 2) - vect[i+1]), 2) + pow((1-vect[i]), 2);
+        answer += rosenbrockTerm(vect[i], vect[i+1]);
 
     return answer;
 }
@@ -86,7 +86,7 @@ double rastriginFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size; ++i)
-        summedUp += pow(vect[i], 2) - (10 * cos(2*M_PI*vect[i]));
+        summedUp += rastriginTerm(vect[i]);
 
     answer = 10 * size * summedUp;
 
@@ -134,7 +134,7 @@ double sineEnvelopeSineWaveFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size-1; ++i)
-        summedUp += 0.5 + pow(sin(pow(vect[i], 2) + pow(vect[i+1], 2) - 0.5), 2) / pow((1 + 0.001*(pow(vect[i], 2) + pow(vect[i+1], 2))), 2);
+        summedUp += sineEnvelopeSineWaveTerm(vect[i], vect[i+1]);
 
     answer = -summedUp;
 
@@ -155,7 +155,7 @@ double stretchedVSineWaveFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size-1; ++i)
-        answer += pow((pow(vect[i], 2) + pow(vect[i+1], 2)), 1.0/4) * pow(sin(50 * pow((pow(vect[i], 2) + pow(vect[i+1], 2)), 1.0/10)), 2) + 1;
+        answer += stretchedVSineWaveTerm(vect[i], vect[i+1]);
 
     return answer;
 }
@@ -174,7 +174,7 @@ double ackleysOneFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size-1; ++i)
-        answer += (1 / pow(exp(1.0), 0.2)) * sqrt(pow(vect[i] ,2) + pow(vect[i+1], 2)) + 3 * (cos(2*vect[i]) + sin(2*vect[i+1]));
+        answer += ackleysOneTerm(vect[i], vect[i+1]);
 
     return answer;
 }
@@ -193,8 +193,7 @@ double ackleysTwoFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size-1; ++i)
-        answer += 20 + exp(1.0) - (20 / pow(exp(1.0), (0.2 * sqrt((pow(vect[i], 2) + pow(vect[i+1], 2)) / 2))))
-                - pow(exp(1.0), (0.5 * (cos(2*M_PI*vect[i]) + cos(2*M_PI*vect[i+1]))));
+        answer += ackleysTwoTerm(vect[i], vect[i+1]);
 
     return answer;
 }
@@ -213,8 +212,7 @@ double eggHolderFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size-1; ++i)
-        answer += (-vect[i]) * sin(sqrt(abs(vect[i] - vect[i+1] - 47)))
-                - (vect[i+1] + 47) * sin(sqrt(abs(vect[i+1] + 47 + (vect[i] / 2))));
+        answer += eggHolderTerm(vect[i], vect[i+1]);
 
     return answer;
 }
@@ -233,8 +231,7 @@ double ranaFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size-1; ++i)
-        answer += vect[i] * sin(sqrt(abs(vect[i+1] - vect[i] + 1))) * cos(sqrt(abs(vect[i+1] + vect[i] + 1)))
-                + (vect[i+1] + 1) * cos(sqrt(abs(vect[i+1] - vect[i] + 1))) * sin(sqrt(abs(vect[i+1] + vect[i] + 1)));
+        answer += ranaTerm(vect[i], vect[i+1]);
 
     return answer;
 }
@@ -253,8 +250,7 @@ double pathologicalFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size-1; ++i)
-        answer += 0.5 + (pow(sin(sqrt(100 * pow(vect[i], 2) + pow(vect[i+1], 2))), 2) - 0.5)
-                / (1 + 0.001*pow((pow(vect[i], 2) - 2*vect[i] * vect[i+1] + pow(vect[i+1], 2)), 2));
+        answer += pathologicalTerm(vect[i], vect[i+1]);
 
     return answer;
 }
@@ -274,7 +270,7 @@ double michalewiczFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size; ++i)
-        summedUp += sin(vect[i]) * pow(sin(((i+1) * pow(vect[i], 2)) / M_PI), 20);
+        summedUp += michalewiczTerm(vect[i], i);
 
     answer = -summedUp;
 
@@ -296,8 +292,7 @@ double mastersCosWaveFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size-1; ++i)
-        summedUp += pow(exp(1.0), ((-1.0/8.0) * (pow(vect[i], 2) + pow(vect[i+1], 2) + 0.5 * vect[i+1] * vect[i])))
-                * cos(4 * sqrt(pow(vect[i], 2) + pow(vect[i+1], 2) + 0.5 * vect[i] * vect[i+1]));
+        summedUp += mastersCosWaveTerm(vect[i], vect[i+1]);
 
     answer = -summedUp;
 
@@ -318,7 +313,7 @@ double quarticFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size; ++i)
-        answer += (i+1) * pow(vect[i], 4);
+        answer += quarticTerm(vect[i], i);
 
     return answer;
 }
@@ -337,18 +332,13 @@ double levyFunc(vector<double> &vect, int size)
     double summedUp = 0;
 
     double w1 = vect[0];
-    double wi;
     double wn = vect[size-1];
 
     // perform function calculations.
     for(int i = 0; i < size-1; ++i)
-    {
-        wi = 1 + (vect[i] - 1) / 4;
-        summedUp += pow((wi - 1), 2) * (1 + 10 * pow(sin(M_PI*wi + 1), 2))
-                + pow((wn - 1), 2) * (1 + pow(sin(2*M_PI*wn), 2));
-    }
+        summedUp += levyTerm(vect[i]) + levyLastTerm(wn);
 
-    answer = pow(sin(M_PI * w1), 2) + summedUp;
+    answer = levyFirstTerm(w1) + summedUp;
 
     return answer;
 }
@@ -367,7 +357,7 @@ double stepFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size; ++i)
-        answer += pow((abs(vect[i]) + 0.5), 2);
+        answer += stepTerm(vect[i]);
 
     return answer;
 }
@@ -386,7 +376,419 @@ double alpineFunc(vector<double> &vect, int size)
 
     // perform function calculations.
     for(int i = 0; i < size; ++i)
-        answer += abs(vect[i] * sin(vect[i]) + 0.1 * vect[i]);
+        answer += alpineTerm(vect[i]);
+
+    return answer;
+}
+
+// **********************************************************************************
+// ************************* Benchmark Function Terms Below *************************
+// **********************************************************************************
+// Every benchmark function except Griewangk is a sum of local terms. Separable
+// functions add one term per element (some also depend on the element's index),
+// the others add one term per neighbouring pair of elements. Keeping the terms
+// separate lets a single changed element be re-scored without re-evaluating
+// the whole vector.
+
+/** @brief Schefel's term of one element: -x * sin(sqrt(|x|)). */
+double schefelsTerm(double x)
+{
+    return (-x) * sin(sqrt(abs(x)));
+}
+
+/** @brief 1st De Jong's term of one element: x^2. */
+double deJongsTerm(double x)
+{
+    return pow(x, 2);
+}
+
+/** @brief Rosenbrock term of a neighbouring pair (x = vect[i], y = vect[i+1]). */
+double rosenbrockTerm(double x, double y)
+{
+    return 100 * pow((pow(x, 2) - y), 2) + pow((1-x), 2);
+}
+
+/** @brief Rastrigin term of one element: x^2 - 10cos(2*pi*x). */
+double rastriginTerm(double x)
+{
+    return pow(x, 2) - (10 * cos(2*M_PI*x));
+}
+
+/** @brief Sine Envelope Sine Wave term of a neighbouring pair (x = vect[i], y = vect[i+1]). */
+double sineEnvelopeSineWaveTerm(double x, double y)
+{
+    return 0.5 + pow(sin(pow(x, 2) + pow(y, 2) - 0.5), 2) / pow((1 + 0.001*(pow(x, 2) + pow(y, 2))), 2);
+}
+
+/** @brief Stretched V Sine Wave term of a neighbouring pair (x = vect[i], y = vect[i+1]). */
+double stretchedVSineWaveTerm(double x, double y)
+{
+    return pow((pow(x, 2) + pow(y, 2)), 1.0/4) * pow(sin(50 * pow((pow(x, 2) + pow(y, 2)), 1.0/10)), 2) + 1;
+}
+
+/** @brief Ackley's One term of a neighbouring pair (x = vect[i], y = vect[i+1]). */
+double ackleysOneTerm(double x, double y)
+{
+    return (1 / pow(exp(1.0), 0.2)) * sqrt(pow(x ,2) + pow(y, 2)) + 3 * (cos(2*x) + sin(2*y));
+}
+
+/** @brief Ackley's Two term of a neighbouring pair (x = vect[i], y = vect[i+1]). */
+double ackleysTwoTerm(double x, double y)
+{
+    return 20 + exp(1.0) - (20 / pow(exp(1.0), (0.2 * sqrt((pow(x, 2) + pow(y, 2)) / 2))))
+           - pow(exp(1.0), (0.5 * (cos(2*M_PI*x) + cos(2*M_PI*y))));
+}
+
+/** @brief Egg Holder term of a neighbouring pair (x = vect[i], y = vect[i+1]). */
+double eggHolderTerm(double x, double y)
+{
+    return (-x) * sin(sqrt(abs(x - y - 47)))
+           - (y + 47) * sin(sqrt(abs(y + 47 + (x / 2))));
+}
+
+/** @brief Rana term of a neighbouring pair (x = vect[i], y = vect[i+1]). */
+double ranaTerm(double x, double y)
+{
+    return x * sin(sqrt(abs(y - x + 1))) * cos(sqrt(abs(y + x + 1)))
+           + (y + 1) * cos(sqrt(abs(y - x + 1))) * sin(sqrt(abs(y + x + 1)));
+}
+
+/** @brief Pathological term of a neighbouring pair (x = vect[i], y = vect[i+1]). */
+double pathologicalTerm(double x, double y)
+{
+    return 0.5 + (pow(sin(sqrt(100 * pow(x, 2) + pow(y, 2))), 2) - 0.5)
+           / (1 + 0.001*pow((pow(x, 2) - 2*x * y + pow(y, 2)), 2));
+}
+
+/** @brief Michalewicz term of the element x stored at index i. */
+double michalewiczTerm(double x, int i)
+{
+    return sin(x) * pow(sin(((i+1) * pow(x, 2)) / M_PI), 20);
+}
+
+/** @brief Masters Cosine Wave term of a neighbouring pair (x = vect[i], y = vect[i+1]). */
+double mastersCosWaveTerm(double x, double y)
+{
+    return pow(exp(1.0), ((-1.0/8.0) * (pow(x, 2) + pow(y, 2) + 0.5 * y * x)))
+           * cos(4 * sqrt(pow(x, 2) + pow(y, 2) + 0.5 * x * y));
+}
+
+/** @brief Quartic term of the element x stored at index i: (i+1) * x^4. */
+double quarticTerm(double x, int i)
+{
+    return (i+1) * pow(x, 4);
+}
 
+/** @brief Levy term of the element x stored at index i < size-1. */
+double levyTerm(double x)
+{
+    double wi = 1 + (x - 1) / 4;
+    return pow((wi - 1), 2) * (1 + 10 * pow(sin(M_PI*wi + 1), 2));
+}
+
+/** @brief Levy term of the first element, which is added once. */
+double levyFirstTerm(double x)
+{
+    return pow(sin(M_PI * x), 2);
+}
+
+/** @brief Levy term of the last element, which is added once per index i < size-1. */
+double levyLastTerm(double x)
+{
+    return pow((x - 1), 2) * (1 + pow(sin(2*M_PI*x), 2));
+}
+
+/** @brief Step term of one element: (|x| + 0.5)^2. */
+double stepTerm(double x)
+{
+    return pow((abs(x) + 0.5), 2);
+}
+
+/** @brief Alpine term of one element: |x * sin(x) + 0.1x|. */
+double alpineTerm(double x)
+{
+    return abs(x * sin(x) + 0.1 * x);
+}
+
+/**
+ * @brief Returns how a Benchmark Function splits into 1-D problems.
+ *
+ * A separable function is a sum of one term per element, so it is minimized
+ * by minimizing every term on its own. Schefel, De Jong, Rastrigin, Step and
+ * Alpine use the same term for every element; Michalewicz and Quartic weigh
+ * the term by the element's index, and Levy gives the first and last
+ * elements terms of their own. Every other function has pair terms (or, for
+ * Griewangk, a product) that couple the elements.
+ *
+ * @param functionID The ID that references which Benchmark Function to use.
+ * @return SEPARABLE_IDENTICAL, SEPARABLE_INDEXED or SEPARABLE_NONE.
+ */
+int functionSeparability(int functionID)
+{
+    switch(functionID)
+    {
+        case 1:
+        case 2:
+        case 4:
+        case 17:
+        case 18:
+            return SEPARABLE_IDENTICAL;
+        case 13:
+        case 15:
+        case 16:
+            return SEPARABLE_INDEXED;
+        default:
+            return SEPARABLE_NONE;
+    }
+}
+
+// **********************************************************************************
+// ************************ Bounded Benchmark Functions Below ***********************
+// **********************************************************************************
+// The functions below have terms with a known lower bound, so their sum can be
+// abandoned once the partial sum plus the smallest possible value of the
+// remaining terms already exceeds a threshold. The check is made once per
+// BOUNDED_EVALUATION_BLOCK terms so cheap terms are still summed in a tight loop.
+// A vector that isn't rejected gets exactly the fitness of the full function.
+
+/**
+ * @brief Sums term(i) for i in [0, count), giving up once the fitness can't reach threshold.
+ *
+ * @param term The term of the i-th element (or pair).
+ * @param count The number of terms.
+ * @param minTerm The smallest value a term can have.
+ * @param scale, offset The fitness is scale * sum + offset.
+ * @param threshold The fitness above which the sum is abandoned.
+ * @param sum Set to the sum of all the terms if it wasn't abandoned.
+ *
+ * @return False if the sum was abandoned, true otherwise.
+ */
+template <typename Term>
+static bool boundedSum(Term term, int count, double minTerm, double scale, double offset, double threshold, double &sum)
+{
+    double summedUp = 0;
+    for(int blockStart = 0; blockStart < count; blockStart += BOUNDED_EVALUATION_BLOCK)
+    {
+        int blockEnd = min(blockStart + BOUNDED_EVALUATION_BLOCK, count);
+        for(int i = blockStart; i < blockEnd; ++i)
+            summedUp += term(i);
+        if(scale * (summedUp + minTerm * (count - blockEnd)) + offset > threshold)
+            return false;
+    }
+
+    sum = summedUp;
+    return true;
+}
+
+/** @brief 1st De Jong's Function, or FITNESS_REJECTED once it is certain to be above threshold. */
+double deJongsFuncBounded(vector<double> &vect, int size, double threshold)
+{
+    double answer;
+    if(!boundedSum([&vect](int i) { return deJongsTerm(vect[i]); }, size, 0.0, 1.0, 0.0, threshold, answer))
+        return FITNESS_REJECTED;
+    return answer;
+}
+
+/** @brief Rosenbrock Function, or FITNESS_REJECTED once it is certain to be above threshold. */
+double rosenbrockFuncBounded(vector<double> &vect, int size, double threshold)
+{
+    double answer;
+    if(!boundedSum([&vect](int i) { return rosenbrockTerm(vect[i], vect[i+1]); }, size-1, 0.0, 1.0, 0.0, threshold, answer))
+        return FITNESS_REJECTED;
     return answer;
-}
\ No newline at end of file
+}
+
+/** @brief Rastrigin Function (every term is at least -10), or FITNESS_REJECTED once it is certain to be above threshold. */
+double rastriginFuncBounded(vector<double> &vect, int size, double threshold)
+{
+    double summedUp;
+    if(!boundedSum([&vect](int i) { return rastriginTerm(vect[i]); }, size, -10.0, 10 * size, 0.0, threshold, summedUp))
+        return FITNESS_REJECTED;
+    return 10 * size * summedUp;
+}
+
+/** @brief Quartic Function, or FITNESS_REJECTED once it is certain to be above threshold. */
+double quarticFuncBounded(vector<double> &vect, int size, double threshold)
+{
+    double answer;
+    if(!boundedSum([&vect](int i) { return quarticTerm(vect[i], i); }, size, 0.0, 1.0, 0.0, threshold, answer))
+        return FITNESS_REJECTED;
+    return answer;
+}
+
+/** @brief Levy Function, or FITNESS_REJECTED once it is certain to be above threshold. */
+double levyFuncBounded(vector<double> &vect, int size, double threshold)
+{
+    double summedUp;
+    double firstTerm = levyFirstTerm(vect[0]);
+    double lastTerm = levyLastTerm(vect[size-1]);
+    if(!boundedSum([&vect, lastTerm](int i) { return levyTerm(vect[i]) + lastTerm; }, size-1, 0.0, 1.0, firstTerm, threshold, summedUp))
+        return FITNESS_REJECTED;
+    return firstTerm + summedUp;
+}
+
+/** @brief Step Function, or FITNESS_REJECTED once it is certain to be above threshold. */
+double stepFuncBounded(vector<double> &vect, int size, double threshold)
+{
+    double answer;
+    if(!boundedSum([&vect](int i) { return stepTerm(vect[i]); }, size, 0.0, 1.0, 0.0, threshold, answer))
+        return FITNESS_REJECTED;
+    return answer;
+}
+
+/** @brief Alpine Function, or FITNESS_REJECTED once it is certain to be above threshold. */
+double alpineFuncBounded(vector<double> &vect, int size, double threshold)
+{
+    double answer;
+    if(!boundedSum([&vect](int i) { return alpineTerm(vect[i]); }, size, 0.0, 1.0, 0.0, threshold, answer))
+        return FITNESS_REJECTED;
+    return answer;
+}
+
+// **********************************************************************************
+// *********************** Benchmark Function Gradients Below ***********************
+// **********************************************************************************
+// The smooth functions below calculate their gradient in the same pass as
+// their fitness, which is exactly the fitness of the plain function. The
+// gradient is written to the first size elements of gradient, which the
+// caller sizes.
+
+/** @brief 1st De Jong's Function and its gradient: d/dx_i = 2x_i. */
+double deJongsFuncGradient(vector<double> &vect, int size, vector<double> &gradient)
+{
+    double answer = 0;
+
+    for(int i = 0; i < size; ++i)
+    {
+        answer += deJongsTerm(vect[i]);
+        gradient[i] = 2 * vect[i];
+    }
+
+    return answer;
+}
+
+/**
+ * @brief Rosenbrock Function and its gradient.
+ *
+ * Each pair term 100(x^2 - y)^2 + (1 - x)^2 adds 400x(x^2 - y) - 2(1 - x)
+ * to the derivative of its first element and -200(x^2 - y) to its second.
+ */
+double rosenbrockFuncGradient(vector<double> &vect, int size, vector<double> &gradient)
+{
+    double answer = 0;
+
+    fill(gradient.begin(), gradient.begin() + size, 0.0);
+    for(int i = 0; i < size-1; ++i)
+    {
+        double x = vect[i], y = vect[i+1];
+        double valley = pow(x, 2) - y;
+        answer += 100 * pow(valley, 2) + pow((1-x), 2);
+        gradient[i] += 400 * x * valley - 2 * (1-x);
+        gradient[i+1] += -200 * valley;
+    }
+
+    return answer;
+}
+
+/**
+ * @brief Griewangk Function and its gradient.
+ *
+ * The derivative of the product by x_i is the product of every other
+ * cosine, kept as a running prefix times a suffix, so no cosine is divided
+ * out (it may be zero).
+ */
+double griewangkFuncGradient(vector<double> &vect, int size, vector<double> &gradient)
+{
+    double summedUp = 0;
+    double productUp = 1;
+
+    // The suffix products are kept in gradient until they are used.
+    for(int i = 0; i < size; ++i)
+        summedUp += pow(vect[i], 2) / 4000;
+
+    gradient[size-1] = 1;
+    for(int i = size-1; i > 0; --i)
+        gradient[i-1] = gradient[i] * cos(vect[i] / sqrt(i+1));
+
+    for(int i = 0; i < size; ++i)
+    {
+        double root = sqrt(i+1);
+        double others = productUp * gradient[i];
+        productUp *= cos(vect[i] / root);
+        gradient[i] = vect[i] / 2000 + others * sin(vect[i] / root) / root;
+    }
+
+    return 1 + summedUp - productUp;
+}
+
+/**
+ * @brief Masters Cosine Wave Function and its gradient.
+ *
+ * Each pair term is e^(-q/8) * cos(4sqrt(q)) with q = x^2 + y^2 + 0.5xy, so
+ * its derivative by q is e^(-q/8) * (-cos(4sqrt(q))/8 - 2sin(4sqrt(q))/sqrt(q)),
+ * whose last part tends to 8 as q goes to 0.
+ */
+double mastersCosWaveFuncGradient(vector<double> &vect, int size, vector<double> &gradient)
+{
+    double summedUp = 0;
+
+    fill(gradient.begin(), gradient.begin() + size, 0.0);
+    for(int i = 0; i < size-1; ++i)
+    {
+        double x = vect[i], y = vect[i+1];
+        double envelope = pow(exp(1.0), ((-1.0/8.0) * (pow(x, 2) + pow(y, 2) + 0.5 * y * x)));
+        double root = sqrt(pow(x, 2) + pow(y, 2) + 0.5 * x * y);
+        double wave = cos(4 * root);
+        summedUp += envelope * wave;
+
+        double dq = envelope * (-wave / 8 - ((root > 0) ? 2 * sin(4 * root) / root : 8.0));
+        gradient[i] -= dq * (2 * x + 0.5 * y);
+        gradient[i+1] -= dq * (2 * y + 0.5 * x);
+    }
+
+    return -summedUp;
+}
+
+/** @brief Quartic Function and its gradient: d/dx_i = 4(i+1)x_i^3. */
+double quarticFuncGradient(vector<double> &vect, int size, vector<double> &gradient)
+{
+    double answer = 0;
+
+    for(int i = 0; i < size; ++i)
+    {
+        answer += quarticTerm(vect[i], i);
+        gradient[i] = 4 * (i+1) * pow(vect[i], 3);
+    }
+
+    return answer;
+}
+
+/**
+ * @brief Returns true if a Benchmark Function has an analytic gradient.
+ *
+ * These are the smooth functions: De Jong, Rosenbrock, Griewangk, Masters
+ * Cosine Wave and Quartic.
+ *
+ * @param functionID The ID that references which Benchmark Function to use.
+ * @return True if the function has a ...FuncGradient() above.
+ */
+bool functionHasGradient(int functionID)
+{
+    return functionID == 2 || functionID == 3 || functionID == 5 || functionID == 14 || functionID == 15;
+}
+
+/**
+ * @brief Returns true if a Benchmark Function costs more to evaluate than a memo lookup.
+ *
+ * Every function with a trigonometric, exponential or root term is. De Jong,
+ * Rosenbrock, Quartic and Step are a few multiplications per element, about
+ * what hashing and comparing the vector costs, so memoizing them only adds
+ * the lookup.
+ *
+ * @param functionID The ID that references which Benchmark Function to use.
+ * @return True if the function is worth memoizing.
+ */
+bool functionIsExpensive(int functionID)
+{
+    return functionID != 2 && functionID != 3 && functionID != 15 && functionID != 17;
+}
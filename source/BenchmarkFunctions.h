@@ -15,9 +15,23 @@
 #include <vector>
 #include <math.h>   // Sine and Cosine, square root
 #include <cmath>    // Absolute value of doubles
+#include <algorithm>    // Min of the bounded blocks
 
 using namespace std;
 
+// -------------- CONSTANTS --------------
+/** The fitness a bounded function returns for a vector it gave up on (worse than any real fitness). */
+#define FITNESS_REJECTED HUGE_VAL
+/** The number of terms a bounded function sums between checks against its threshold. */
+#define BOUNDED_EVALUATION_BLOCK 16
+
+/** The function couples its elements, so it can't be split into 1-D problems. */
+#define SEPARABLE_NONE 0
+/** Every element has the same term, so a single 1-D problem solves every element. */
+#define SEPARABLE_IDENTICAL 1
+/** Every element has a term of its own (it depends on the index), so each element is its own 1-D problem. */
+#define SEPARABLE_INDEXED 2
+
 /** Performs the Schefel's Function on a vector of elements. */
 double schefelsFunc(vector<double> &vect, int size);
 
@@ -72,4 +86,80 @@ double stepFunc(vector<double> &vect, int size);
 /** Performs the Alpine Function on a vector of elements. */
 double alpineFunc(vector<double> &vect, int size);
 
+// ---------- BENCHMARK FUNCTION TERMS ----------
+/** Schefel's term of a single element. */
+double schefelsTerm(double x);
+/** 1st De Jong's term of a single element. */
+double deJongsTerm(double x);
+/** Rosenbrock term of a neighbouring pair of elements. */
+double rosenbrockTerm(double x, double y);
+/** Rastrigin term of a single element. */
+double rastriginTerm(double x);
+/** Sine Envelope Sine Wave term of a neighbouring pair of elements. */
+double sineEnvelopeSineWaveTerm(double x, double y);
+/** Stretched V Sine Wave term of a neighbouring pair of elements. */
+double stretchedVSineWaveTerm(double x, double y);
+/** Ackley's One term of a neighbouring pair of elements. */
+double ackleysOneTerm(double x, double y);
+/** Ackley's Two term of a neighbouring pair of elements. */
+double ackleysTwoTerm(double x, double y);
+/** Egg Holder term of a neighbouring pair of elements. */
+double eggHolderTerm(double x, double y);
+/** Rana term of a neighbouring pair of elements. */
+double ranaTerm(double x, double y);
+/** Pathological term of a neighbouring pair of elements. */
+double pathologicalTerm(double x, double y);
+/** Michalewicz term of a single element at index i. */
+double michalewiczTerm(double x, int i);
+/** Masters Cosine Wave term of a neighbouring pair of elements. */
+double mastersCosWaveTerm(double x, double y);
+/** Quartic term of a single element at index i. */
+double quarticTerm(double x, int i);
+/** Levy term of a single element (all but the last). */
+double levyTerm(double x);
+/** Levy term of the first element. */
+double levyFirstTerm(double x);
+/** Levy term of the last element. */
+double levyLastTerm(double x);
+/** Step term of a single element. */
+double stepTerm(double x);
+/** Alpine term of a single element. */
+double alpineTerm(double x);
+
+/** Returns how a function splits into 1-D problems (one of the SEPARABLE_ constants). */
+int functionSeparability(int functionID);
+
+// ---------- BOUNDED BENCHMARK FUNCTIONS ----------
+/** 1st De Jong's Function, abandoned once it is certain to be above threshold. */
+double deJongsFuncBounded(vector<double> &vect, int size, double threshold);
+/** Rosenbrock Function, abandoned once it is certain to be above threshold. */
+double rosenbrockFuncBounded(vector<double> &vect, int size, double threshold);
+/** Rastrigin Function, abandoned once it is certain to be above threshold. */
+double rastriginFuncBounded(vector<double> &vect, int size, double threshold);
+/** Quartic Function, abandoned once it is certain to be above threshold. */
+double quarticFuncBounded(vector<double> &vect, int size, double threshold);
+/** Levy Function, abandoned once it is certain to be above threshold. */
+double levyFuncBounded(vector<double> &vect, int size, double threshold);
+/** Step Function, abandoned once it is certain to be above threshold. */
+double stepFuncBounded(vector<double> &vect, int size, double threshold);
+/** Alpine Function, abandoned once it is certain to be above threshold. */
+double alpineFuncBounded(vector<double> &vect, int size, double threshold);
+
+// ---------- BENCHMARK FUNCTION GRADIENTS ----------
+/** 1st De Jong's Function and its gradient, calculated in the same pass. */
+double deJongsFuncGradient(vector<double> &vect, int size, vector<double> &gradient);
+/** Rosenbrock Function and its gradient, calculated in the same pass. */
+double rosenbrockFuncGradient(vector<double> &vect, int size, vector<double> &gradient);
+/** Griewangk Function and its gradient, calculated in the same pass. */
+double griewangkFuncGradient(vector<double> &vect, int size, vector<double> &gradient);
+/** Masters Cosine Wave Function and its gradient, calculated in the same pass. */
+double mastersCosWaveFuncGradient(vector<double> &vect, int size, vector<double> &gradient);
+/** Quartic Function and its gradient, calculated in the same pass. */
+double quarticFuncGradient(vector<double> &vect, int size, vector<double> &gradient);
+/** Returns true if a function has an analytic gradient (one of the functions above). */
+bool functionHasGradient(int functionID);
+
+/** Returns true if a function costs more to evaluate than looking its fitness up in a memo. */
+bool functionIsExpensive(int functionID);
+
 #endif //BENCHMARKFUNCTIONS_BENCHMARKFUNCTIONS_H
\ No newline at end of file
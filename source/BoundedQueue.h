@@ -0,0 +1,101 @@
+/**
+ * @file BoundedQueue.h
+ * @author  Al Timofeyev
+ * @date    May 11, 2019
+ * @brief   A bounded, lock-free queue that connects two stages of a
+ *          pipeline: one thread pushes, one thread pops.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_BOUNDEDQUEUE_H
+#define BENCHMARKFUNCTIONS2_BOUNDEDQUEUE_H
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** The number of times a waiting stage yields before it starts sleeping between checks. */
+#define QUEUE_SPIN_YIELDS 64
+/** How long, in microseconds, a waiting stage sleeps between checks. */
+#define QUEUE_WAIT_MICROSECONDS 200
+
+/**
+ * @brief A bounded single-producer, single-consumer queue.
+ *
+ * The items live in a ring of capacity + 1 slots. The producer only moves the
+ * tail and the consumer only moves the head, so neither ever takes a lock: an
+ * item is published by the release store of the tail and picked up by the
+ * acquire load of it (and the other way round for freed slots). A full queue
+ * holds the producer back, which is what bounds the work in flight.
+ *
+ * A stage waiting on the queue yields for a while, then sleeps between
+ * checks, so a stage blocked behind a long search doesn't keep a core busy.
+ */
+template <typename T>
+class BoundedQueue{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    /** Creates an empty queue that holds at most capacity items (at least 1). */
+    BoundedQueue(int capacity) : slots(max(capacity, 1) + 1), head(0), tail(0), isClosed(false) {}
+
+    // --------------------- Functions Declarations ---------------------
+    /** Moves an item into the queue, waiting while the queue is full. Called by the producer only. */
+    void push(T &item)
+    {
+        size_t position = tail.load(memory_order_relaxed);
+        size_t next = (position + 1) % slots.size();
+        for(int waits = 0; next == head.load(memory_order_acquire); waits++)
+            wait(waits);
+
+        slots[position] = move(item);
+        tail.store(next, memory_order_release);
+    }
+
+    /** Moves the next item out of the queue, waiting while it's empty. Returns false once it's closed and empty. Called by the consumer only. */
+    bool pop(T &item)
+    {
+        size_t position = head.load(memory_order_relaxed);
+        for(int waits = 0; position == tail.load(memory_order_acquire); waits++)
+        {
+            // Check the tail again after seeing the close, the last push may have come just before it.
+            if(isClosed.load(memory_order_acquire) && position == tail.load(memory_order_acquire))
+                return false;
+            wait(waits);
+        }
+
+        item = move(slots[position]);
+        slots[position] = T();
+        head.store((position + 1) % slots.size(), memory_order_release);
+        return true;
+    }
+
+    /** Tells the consumer no more items are coming. Called by the producer only. */
+    void close()
+    {
+        isClosed.store(true, memory_order_release);
+    }
+
+private:
+    // --------------------------- Variables ----------------------------
+    vector<T> slots;
+    atomic<size_t> head;        /**< The next slot to pop, moved by the consumer.*/
+    atomic<size_t> tail;        /**< The next slot to push, moved by the producer.*/
+    atomic<bool> isClosed;
+
+    // --------------------- Functions Declarations ---------------------
+    /** Waits a little before checking the queue again. */
+    void wait(int waits)
+    {
+        if(waits < QUEUE_SPIN_YIELDS)
+            this_thread::yield();
+        else
+            this_thread::sleep_for(chrono::microseconds(QUEUE_WAIT_MICROSECONDS));
+    }
+};
+
+
+#endif //BENCHMARKFUNCTIONS2_BOUNDEDQUEUE_H
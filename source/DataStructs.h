@@ -56,8 +56,30 @@ struct SearchAlgorithmResults
     double timeBS;              /**< The time it took to execute the Blind Search Algorithm in milliseconds.*/
     double fitnessLS;           /**< The best fitness found in Local Search Algorithm.*/
     double timeLS;              /**< The time it took to execute the Local Search Algorithm in milliseconds.*/
+    double evalsPerSecLS = 0;   /**< The number of fitness evaluations per second performed by the Local Search Algorithm.*/
+    long long evaluationsLS = 0;/**< The number of fitness evaluations performed by the Local Search Algorithm.*/
     vector<double> fitnessILS;  /**< List of the best fitness' found in Iterative Local Search Algorithm.*/
     double timeILS;             /**< The time it took to execute the Iterative Local Search Algorithm in milliseconds.*/
+    double evalsPerSecILS = 0;  /**< The number of fitness evaluations per second performed by the Iterative Local Search Algorithm.*/
+    long long evaluationsILS = 0;/**< The number of fitness evaluations performed by the Iterative Local Search Algorithm.*/
+    vector<double> fitnessPSO;  /**< List of the best fitness' found after each iteration of Particle Swarm Optimization.*/
+    double timePSO;             /**< The time it took to execute the Particle Swarm Optimization in milliseconds.*/
+    double evalsPerSecPSO;      /**< The number of fitness evaluations per second performed by Particle Swarm Optimization.*/
+    vector<double> fitnessSA;   /**< List of the best fitness' found by each Simulated Annealing chain.*/
+    double timeSA;              /**< The time it took to execute the Simulated Annealing in milliseconds.*/
+    double evalsPerSecSA;       /**< The number of moves (fitness evaluations) per second performed by Simulated Annealing.*/
+    vector<double> fitnessCMAES;/**< List of the best fitness' found after each generation of CMA-ES.*/
+    double timeCMAES;           /**< The time it took to execute CMA-ES in milliseconds.*/
+    double evalsPerSecCMAES;    /**< The number of fitness evaluations per second performed by CMA-ES.*/
+    vector<double> fitnessGA;   /**< List of the best fitness' found after each generation of the Genetic Algorithm.*/
+    double timeGA;              /**< The time it took to execute the Genetic Algorithm in milliseconds.*/
+    double evalsPerSecGA;       /**< The number of fitness evaluations per second performed by the Genetic Algorithm.*/
+    vector<double> fitnessDS;   /**< List of the best fitness' found after each cycle of the Decomposition Search.*/
+    double timeDS;              /**< The time it took to execute the Decomposition Search in milliseconds.*/
+    double evalsPerSecDS;       /**< The number of term and fitness evaluations per second performed by the Decomposition Search.*/
+    vector<double> fitnessLBFGS;/**< List of the best fitness' found from each start of L-BFGS.*/
+    double timeLBFGS;           /**< The time it took to execute L-BFGS in milliseconds.*/
+    double evalsPerSecLBFGS;    /**< The number of fitness and gradient evaluations per second performed by L-BFGS.*/
 };
 
 /**
@@ -69,8 +91,10 @@ struct SearchAlgorithmResults
  */
 struct SearchAlgorithmResultsAnalysis
 {
-    string mainHeader = " ,Blind Search, , , , , ,Local Search, , , , , ,Iterative Local Search, , , , ,\n";
-    string header = "Function ID,Average Fitness,Standard Deviation,Range(min),Range(max),Median,Time(ms),Average Fitness,Standard Deviation,Range(min),Range(max),Median,Time(ms),Average Fitness,Standard Deviation,Range(min),Range(max),Median,Time(ms)\n";
+    string idHeader = "Function ID";                                                                    /**< Header of the function ID column.*/
+    string statsHeader = "Average Fitness,Standard Deviation,Range(min),Range(max),Median,Time(ms)";   /**< Header of the columns every algorithm saves.*/
+    string throughputHeader = "Evaluations/Second";                                                    /**< Header of the throughput column some algorithms save.*/
+    string countHeader = "Evaluations";                                                                /**< Header of the evaluation count column the local searches save.*/
     vector<int> functionIDs;                /**< List of function IDs.*/
 
     vector<double> avgBSFitness;            /**< List of the average Blind Search fitness per SearchAlgorithmResults structure.*/
@@ -84,13 +108,123 @@ struct SearchAlgorithmResultsAnalysis
     vector<vector<double>> rangesLS;        /**< List of ranges for each Local Search result per SearchAlgorithmResults structure.*/
     vector<double> medianLSFitness;         /**< List of the Median Local Search fitness from each SearchAlgorithmResults structure.*/
     vector<double> processTimesLS;          /**< List of process times in ms for each Local Search in SearchAlgorithmResults structure.*/
+    vector<double> evalsPerSecLS;           /**< List of Local Search fitness evaluations per second for each SearchAlgorithmResults structure.*/
+    vector<long long> evaluationsLS;        /**< List of Local Search fitness evaluation counts for each SearchAlgorithmResults structure.*/
 
     vector<double> avgILSFitness;           /**< List of the average Iterative Local Search fitness per SearchAlgorithmResults structure.*/
     vector<double> standardDeviationILS;    /**< List of standard Iterative Local Search fitness deviations per SearchAlgorithmResults structure.*/
     vector<vector<double>> rangesILS;       /**< List of ranges for each Iterative Local Search result per SearchAlgorithmResults structure.*/
     vector<double> medianILSFitness;        /**< List of the Median Iterative Local Search fitness from each SearchAlgorithmResults structure.*/
     vector<double> processTimesILS;         /**< List of process times in ms for each Iterative Local Search in SearchAlgorithmResults structure.*/
+    vector<double> evalsPerSecILS;          /**< List of Iterative Local Search fitness evaluations per second for each SearchAlgorithmResults structure.*/
+    vector<long long> evaluationsILS;       /**< List of Iterative Local Search fitness evaluation counts for each SearchAlgorithmResults structure.*/
+
+    vector<double> avgPSOFitness;           /**< List of the average Particle Swarm fitness per SearchAlgorithmResults structure.*/
+    vector<double> standardDeviationPSO;    /**< List of standard Particle Swarm fitness deviations per SearchAlgorithmResults structure.*/
+    vector<vector<double>> rangesPSO;       /**< List of ranges for each Particle Swarm result per SearchAlgorithmResults structure.*/
+    vector<double> medianPSOFitness;        /**< List of the Median Particle Swarm fitness from each SearchAlgorithmResults structure.*/
+    vector<double> processTimesPSO;         /**< List of process times in ms for each Particle Swarm in SearchAlgorithmResults structure.*/
+    vector<double> evalsPerSecPSO;          /**< List of Particle Swarm fitness evaluations per second for each SearchAlgorithmResults structure.*/
+
+    vector<double> avgSAFitness;            /**< List of the average Simulated Annealing fitness per SearchAlgorithmResults structure.*/
+    vector<double> standardDeviationSA;     /**< List of standard Simulated Annealing fitness deviations per SearchAlgorithmResults structure.*/
+    vector<vector<double>> rangesSA;        /**< List of ranges for each Simulated Annealing result per SearchAlgorithmResults structure.*/
+    vector<double> medianSAFitness;         /**< List of the Median Simulated Annealing fitness from each SearchAlgorithmResults structure.*/
+    vector<double> processTimesSA;          /**< List of process times in ms for each Simulated Annealing in SearchAlgorithmResults structure.*/
+    vector<double> evalsPerSecSA;           /**< List of Simulated Annealing moves per second for each SearchAlgorithmResults structure.*/
+
+    vector<double> avgCMAESFitness;         /**< List of the average CMA-ES fitness per SearchAlgorithmResults structure.*/
+    vector<double> standardDeviationCMAES;  /**< List of standard CMA-ES fitness deviations per SearchAlgorithmResults structure.*/
+    vector<vector<double>> rangesCMAES;     /**< List of ranges for each CMA-ES result per SearchAlgorithmResults structure.*/
+    vector<double> medianCMAESFitness;      /**< List of the Median CMA-ES fitness from each SearchAlgorithmResults structure.*/
+    vector<double> processTimesCMAES;       /**< List of process times in ms for each CMA-ES in SearchAlgorithmResults structure.*/
+    vector<double> evalsPerSecCMAES;        /**< List of CMA-ES fitness evaluations per second for each SearchAlgorithmResults structure.*/
+
+    vector<double> avgGAFitness;            /**< List of the average Genetic Algorithm fitness per SearchAlgorithmResults structure.*/
+    vector<double> standardDeviationGA;     /**< List of standard Genetic Algorithm fitness deviations per SearchAlgorithmResults structure.*/
+    vector<vector<double>> rangesGA;        /**< List of ranges for each Genetic Algorithm result per SearchAlgorithmResults structure.*/
+    vector<double> medianGAFitness;         /**< List of the Median Genetic Algorithm fitness from each SearchAlgorithmResults structure.*/
+    vector<double> processTimesGA;          /**< List of process times in ms for each Genetic Algorithm in SearchAlgorithmResults structure.*/
+    vector<double> evalsPerSecGA;           /**< List of Genetic Algorithm fitness evaluations per second for each SearchAlgorithmResults structure.*/
+
+    vector<double> avgDSFitness;            /**< List of the average Decomposition Search fitness per SearchAlgorithmResults structure.*/
+    vector<double> standardDeviationDS;     /**< List of standard Decomposition Search fitness deviations per SearchAlgorithmResults structure.*/
+    vector<vector<double>> rangesDS;        /**< List of ranges for each Decomposition Search result per SearchAlgorithmResults structure.*/
+    vector<double> medianDSFitness;         /**< List of the Median Decomposition Search fitness from each SearchAlgorithmResults structure.*/
+    vector<double> processTimesDS;          /**< List of process times in ms for each Decomposition Search in SearchAlgorithmResults structure.*/
+    vector<double> evalsPerSecDS;           /**< List of Decomposition Search evaluations per second for each SearchAlgorithmResults structure.*/
+
+    vector<double> avgLBFGSFitness;         /**< List of the average L-BFGS fitness per SearchAlgorithmResults structure.*/
+    vector<double> standardDeviationLBFGS;  /**< List of standard L-BFGS fitness deviations per SearchAlgorithmResults structure.*/
+    vector<vector<double>> rangesLBFGS;     /**< List of ranges for each L-BFGS result per SearchAlgorithmResults structure.*/
+    vector<double> medianLBFGSFitness;      /**< List of the Median L-BFGS fitness from each SearchAlgorithmResults structure.*/
+    vector<double> processTimesLBFGS;       /**< List of process times in ms for each L-BFGS in SearchAlgorithmResults structure.*/
+    vector<double> evalsPerSecLBFGS;        /**< List of L-BFGS fitness and gradient evaluations per second for each SearchAlgorithmResults structure.*/
+};
+
+
+/**
+ * @brief Search Job
+ * Search Job Structure, one search requested from the job server:
+ * which algorithm to run, on which function, and with what budget.
+ */
+struct SearchJob
+{
+    string id;                  /**< The ID the client gave the job, echoed back with its result.*/
+    int functionID;             /**< The ID used to determine which of the 18 Benchmark Functions to use.*/
+    double minBound, maxBound;  /**< The max and min bound of the search space.*/
+    int dimensions;             /**< The number of elements in each vector.*/
+    string algorithm;           /**< The name of the search algorithm (one of the ALG_ constants).*/
+    int budget;                 /**< The number of iterations, as in the first line of SearchAlgorithmConfig.txt.*/
+    unsigned int seed;          /**< The seed of the random number generators, so a job can be repeated.*/
+    double alpha;               /**< The alpha value for neighborhood mutation.*/
+    int threads = 1;            /**< The number of threads the search algorithm uses.*/
+    int coolingSchedule = 1;    /**< The Simulated Annealing cooling schedule (COOLING_EXPONENTIAL by default).*/
+    int crossoverType = 2;      /**< The Genetic Algorithm crossover (GA_CROSSOVER_SBX by default).*/
+    int sampler = 0;            /**< Where Blind Search and the ILS restarts draw their points (SAMPLER_RANDOM by default).*/
+    int localSearchMode = 0;    /**< The descent of Local Search and ILS (LS_MODE_FIXED by default).*/
 };
 
+/**
+ * @brief L-BFGS History
+ * L-BFGS History Structure, the limited memory of an L-BFGS descent and
+ * its work vectors, allocated once and reused by every descent on a thread.
+ */
+struct LBFGSHistory
+{
+    vector<double> steps;           /**< The remembered steps, one row of the vector size each, used as a ring.*/
+    vector<double> gradientChanges; /**< The change in gradient of each remembered step, in the same rows.*/
+    vector<double> rho;             /**< 1 / (step . change in gradient) of each remembered step.*/
+    vector<double> alpha;           /**< The coefficients of the first loop of the two-loop recursion.*/
+    vector<double> gradient;        /**< The gradient at the current vector.*/
+    vector<double> direction;       /**< The search direction.*/
+    vector<double> trial;           /**< The vector tried by the line search.*/
+    vector<double> trialGradient;   /**< The gradient at the trial vector.*/
+};
+
+/**
+ * @brief Pipeline Item
+ * Pipeline Item Structure, one function on its way through the stages of
+ * the pipeline: generated, evaluated and analyzed, searched, then saved.
+ */
+struct PipelineItem
+{
+    int functionIndex;              /**< The position of the function among the valid functions of the configuration file.*/
+    FunctionData data;              /**< The matrix of the function and its fitness.*/
+    SearchAlgorithmResults results; /**< The results of the search algorithms on the function.*/
+};
+
+/**
+ * @brief Sweep Shard
+ * Sweep Shard Structure, one unit of work of a sharded sweep:
+ * a single function line of the configuration file, run at one
+ * of the listed dimensions.
+ */
+struct SweepShard
+{
+    string name;        /**< The name of the shard, used for its claim and result files.*/
+    int dimensions;     /**< The number of elements in each vector.*/
+    string configLine;  /**< The function line of the configuration file (functionID,minBound,maxBound).*/
+};
 
 #endif //BENCHMARKFUNCTIONS2_DATASTRUCTS_H
@@ -0,0 +1,292 @@
+/**
+ * @file FitnessMemo.cpp
+ * @class FitnessMemo FitnessMemo.h "FitnessMemo.h"
+ * @author  Al Timofeyev
+ * @date    May 18, 2019
+ * @brief   A bounded table of the vectors evaluated during a search and
+ *          their fitness, so a vector the search comes back to isn't
+ *          evaluated again. Buckets of open addressing slots, with CLOCK
+ *          eviction inside each bucket once the table is full.
+ *
+ * A vector's key is the bits of its elements (a quantum of 0, only
+ * bit-identical vectors match) or the number of the quantum-sized cell
+ * each element falls in (a nearby vector gets the fitness of the first
+ * vector of its cell). The hash of the key picks a bucket, and the vector
+ * can take any of its FITNESS_MEMO_WAYS slots. Keys are compared in full, so
+ * a hash collision is only a miss.
+ *
+ * Once a bucket is full, its CLOCK hand goes round the slots clearing their
+ * referenced bits, and the first slot found clear is replaced: an entry that
+ * was hit since the hand last passed gets another turn, which approximates
+ * least recently used without keeping an order.
+ *
+ * Each bucket has its own spin lock, so the threads of a population share
+ * one memo and rarely wait for each other.
+ *
+ * A memo is only consulted by the threads it's installed on: the thread
+ * that runs the searches, and the workers the searches start, which install
+ * their starter's memo with a FitnessMemoScope. Other threads evaluating at
+ * the same time (the pipeline's matrix evaluation) never see it.
+ */
+
+#include "FitnessMemo.h"
+
+/** The memo calculateFitnessOfVector() consults on this thread. */
+static thread_local FitnessMemo *activeMemo = nullptr;
+
+/**
+ * @brief Holds the spin lock of a bucket for as long as it lives.
+ */
+class FitnessMemoLock{
+public:
+    FitnessMemoLock(atomic_flag &lock) : lock(lock)
+    {
+        while(lock.test_and_set(memory_order_acquire));
+    }
+    ~FitnessMemoLock()
+    {
+        lock.clear(memory_order_release);
+    }
+private:
+    atomic_flag &lock;
+};
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief The constructor for the FitnessMemo class.
+ *
+ * @param capacity The number of entries, rounded up to a power of two buckets of FITNESS_MEMO_WAYS slots.
+ * @param dimensions The size of the vectors, vectors of other sizes are never memoized.
+ * @param quantum The size of a cell of the quantized keys, 0 to memoize bit-identical vectors only.
+ */
+FitnessMemo::FitnessMemo(long long capacity, int dimensions, double quantum)
+    : lookups(0), hits(0), evictions(0)
+{
+    this->dimensions = dimensions;
+    this->quantum = quantum;
+
+    buckets = 1;
+    while(buckets * FITNESS_MEMO_WAYS < capacity)
+        buckets *= 2;
+
+    slots.resize(buckets * FITNESS_MEMO_WAYS);
+    keys.resize(slots.size() * dimensions);
+    hands.resize(buckets, 0);
+    bucketLocks.reset(new atomic_flag[buckets]);
+    for(size_t b = 0; b < buckets; b++)
+        bucketLocks[b].clear();
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PUBLIC FUNCTIONS BELOW ------------------
+// ----------------------------------------------------------
+/**
+ * @brief Finds the fitness of a vector.
+ *
+ * @param functionID The ID of the function the fitness is of.
+ * @param vect The vector.
+ * @param fitness Set to the memoized fitness, if there is one.
+ * @param hash Set to the hash of the vector's key, for insert().
+ *
+ * @return True if the fitness was found, false otherwise.
+ */
+bool FitnessMemo::lookup(int functionID, vector<double> &vect, double &fitness, uint64_t &hash)
+{
+    if(vect.size() != dimensions)
+        return false;
+
+    // 64-bit FNV-1a of the key, one element at a time, then mixed so the low bits pick the bucket well.
+    hash = 14695981039346656037ULL;
+    for(int i = 0; i < vect.size(); i++)
+        hash = (hash ^ keyOf(vect[i])) * 1099511628211ULL;
+    hash ^= (hash >> 32) ^ (uint64_t)functionID;
+
+    lookups.fetch_add(1, memory_order_relaxed);
+    size_t bucket = hash & (buckets - 1);
+    FitnessMemoLock lock(bucketLocks[bucket]);
+    for(size_t s = bucket * FITNESS_MEMO_WAYS; s < (bucket + 1) * FITNESS_MEMO_WAYS; s++)
+    {
+        if(isMatch(s, functionID, vect, hash))
+        {
+            fitness = slots[s].fitness;
+            slots[s].isReferenced = true;
+            hits.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Stores the fitness of a vector, replacing an entry of its bucket if the bucket is full.
+ *
+ * @param functionID The ID of the function the fitness is of.
+ * @param vect The vector.
+ * @param fitness The fitness of the vector.
+ * @param hash The hash lookup() returned for the vector.
+ */
+void FitnessMemo::insert(int functionID, vector<double> &vect, double fitness, uint64_t hash)
+{
+    if(vect.size() != dimensions)
+        return;
+
+    size_t bucket = hash & (buckets - 1);
+    FitnessMemoLock lock(bucketLocks[bucket]);
+
+    // Another thread may have stored the vector since the lookup.
+    size_t first = bucket * FITNESS_MEMO_WAYS, slot = first + FITNESS_MEMO_WAYS;
+    for(size_t s = first; s < first + FITNESS_MEMO_WAYS; s++)
+    {
+        if(isMatch(s, functionID, vect, hash))
+            return;
+        if(slot == first + FITNESS_MEMO_WAYS && slots[s].functionID == 0)
+            slot = s;
+    }
+
+    // The bucket is full: the CLOCK hand finds a slot that wasn't hit since it last passed.
+    if(slot == first + FITNESS_MEMO_WAYS)
+    {
+        while(slots[first + hands[bucket]].isReferenced)
+        {
+            slots[first + hands[bucket]].isReferenced = false;
+            hands[bucket] = (hands[bucket] + 1) % FITNESS_MEMO_WAYS;
+        }
+        slot = first + hands[bucket];
+        hands[bucket] = (hands[bucket] + 1) % FITNESS_MEMO_WAYS;
+        evictions.fetch_add(1, memory_order_relaxed);
+    }
+
+    slots[slot].hash = hash;
+    slots[slot].fitness = fitness;
+    slots[slot].functionID = functionID;
+    slots[slot].isReferenced = false;
+    for(int i = 0; i < dimensions; i++)
+        keys[slot * dimensions + i] = keyOf(vect[i]);
+}
+
+/**
+ * @brief Returns the number of lookups.
+ * @return The number of lookups.
+ */
+long long FitnessMemo::getLookups()
+{
+    return lookups;
+}
+
+/**
+ * @brief Returns the number of lookups that found the fitness.
+ * @return The number of hits.
+ */
+long long FitnessMemo::getHits()
+{
+    return hits;
+}
+
+/**
+ * @brief Returns the number of entries replaced to make room for others.
+ * @return The number of evictions.
+ */
+long long FitnessMemo::getEvictions()
+{
+    return evictions;
+}
+
+/**
+ * @brief Returns the number of entries the memo holds.
+ * @return The number of slots.
+ */
+long long FitnessMemo::getCapacity()
+{
+    return slots.size();
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PRIVATE FUNCTIONS BELOW -----------------
+// ----------------------------------------------------------
+/**
+ * @brief Returns the key of one element of a vector.
+ * @param value The element.
+ * @return The bits of the value, or the number of the quantum cell it falls in.
+ */
+uint64_t FitnessMemo::keyOf(double value)
+{
+    if(quantum > 0)
+        return (uint64_t)llround(value / quantum);
+
+    uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(value), "a double must be 64 bits");
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief Checks if a slot holds the fitness of a vector.
+ *
+ * @param slot The slot.
+ * @param functionID The ID of the function.
+ * @param vect The vector.
+ * @param hash The hash of the vector's key.
+ *
+ * @return True if the slot holds the same function and key, false otherwise.
+ */
+bool FitnessMemo::isMatch(size_t slot, int functionID, vector<double> &vect, uint64_t hash)
+{
+    if(slots[slot].functionID != functionID || slots[slot].hash != hash)
+        return false;
+    const uint64_t *key = &keys[slot * dimensions];
+    for(int i = 0; i < dimensions; i++)
+        if(key[i] != keyOf(vect[i]))
+            return false;
+    return true;
+}
+
+// ----------------------------------------------------------
+// ----------------- FREE FUNCTIONS BELOW -------------------
+// ----------------------------------------------------------
+/**
+ * @brief Makes calculateFitnessOfVector() consult a memo on the calling thread.
+ *
+ * Only vectors of the memo's size are memoized, and only for the functions
+ * that cost more to evaluate than a lookup (see functionIsExpensive()).
+ *
+ * @param memo The memo, or nullptr to stop consulting one.
+ */
+void setFitnessMemo(FitnessMemo *memo)
+{
+    activeMemo = memo;
+}
+
+/**
+ * @brief Returns the memo calculateFitnessOfVector() consults on the calling thread.
+ * @return The memo, or nullptr.
+ */
+FitnessMemo *getFitnessMemo()
+{
+    return activeMemo;
+}
+
+
+// ----------------------------------------------
+// ------------- FITNESS MEMO SCOPE -------------
+// ----------------------------------------------
+/**
+ * @brief Makes the calling thread consult a memo.
+ * @param memo The memo, or nullptr for none.
+ */
+FitnessMemoScope::FitnessMemoScope(FitnessMemo *memo)
+{
+    previousMemo = getFitnessMemo();
+    setFitnessMemo(memo);
+}
+
+/**
+ * @brief Makes the calling thread consult the memo it consulted before.
+ */
+FitnessMemoScope::~FitnessMemoScope()
+{
+    setFitnessMemo(previousMemo);
+}
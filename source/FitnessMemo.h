@@ -0,0 +1,90 @@
+/**
+ * @file FitnessMemo.h
+ * @author  Al Timofeyev
+ * @date    May 18, 2019
+ * @brief   A bounded table of the vectors evaluated during a search and
+ *          their fitness, so a vector the search comes back to isn't
+ *          evaluated again. Buckets of open addressing slots, with CLOCK
+ *          eviction inside each bucket once the table is full.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_FITNESSMEMO_H
+#define BENCHMARKFUNCTIONS2_FITNESSMEMO_H
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** The number of slots of a bucket, a vector can only be stored in the bucket its hash picks. */
+#define FITNESS_MEMO_WAYS 8
+
+/**
+ * @brief One slot of the memo: which vector it holds (its elements are in the key table) and its fitness.
+ */
+struct FitnessMemoSlot
+{
+    uint64_t hash = 0;          /**< The hash of the vector's key.*/
+    double fitness = 0;         /**< The fitness of the vector.*/
+    int functionID = 0;         /**< The function the fitness is of, 0 if the slot is empty.*/
+    bool isReferenced = false;  /**< Set by every hit, cleared as the CLOCK hand passes.*/
+};
+
+class FitnessMemo{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    FitnessMemo(long long capacity, int dimensions, double quantum);   // A quantum of 0 memoizes bit-identical vectors only.
+
+    // --------------------- Functions Declarations ---------------------
+    bool lookup(int functionID, vector<double> &vect, double &fitness, uint64_t &hash);     /**< Finds the fitness of a vector, and returns the hash insert() needs.*/
+    void insert(int functionID, vector<double> &vect, double fitness, uint64_t hash);       /**< Stores the fitness of a vector looked up before.*/
+    long long getLookups();             /**< Returns the number of lookups.*/
+    long long getHits();                /**< Returns the number of lookups that found the fitness.*/
+    long long getEvictions();           /**< Returns the number of entries replaced to make room.*/
+    long long getCapacity();            /**< Returns the number of entries the memo holds.*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    int dimensions;
+    double quantum;
+    size_t buckets;                             /**< A power of two.*/
+    vector<FitnessMemoSlot> slots;              /**< FITNESS_MEMO_WAYS slots per bucket.*/
+    vector<uint64_t> keys;                      /**< The key of every slot's vector, dimensions values per slot.*/
+    vector<unsigned char> hands;                /**< The CLOCK hand of every bucket.*/
+    unique_ptr<atomic_flag[]> bucketLocks;      /**< A spin lock per bucket, the searches evaluate on several threads.*/
+    atomic<long long> lookups;
+    atomic<long long> hits;
+    atomic<long long> evictions;
+
+    // --------------------- Functions Declarations ---------------------
+    uint64_t keyOf(double value);                           /**< The bits of a value, or the number of its quantum cell.*/
+    bool isMatch(size_t slot, int functionID, vector<double> &vect, uint64_t hash);    /**< Checks if a slot holds a vector.*/
+};
+
+/**
+ * @brief Makes the calling thread consult a memo for as long as it lives.
+ *
+ * A search that starts worker threads gives each of them a scope with its
+ * own getFitnessMemo(), so the workers share the memo of the search.
+ */
+class FitnessMemoScope{
+public:
+    FitnessMemoScope(FitnessMemo *memo);    // Installs the memo on the calling thread.
+    ~FitnessMemoScope();                    // Reinstalls the memo the thread had before.
+
+private:
+    FitnessMemo *previousMemo;
+};
+
+/** Makes calculateFitnessOfVector() consult a memo on the calling thread (nullptr for none). */
+void setFitnessMemo(FitnessMemo *memo);
+/** Returns the memo calculateFitnessOfVector() consults on the calling thread, or nullptr. */
+FitnessMemo *getFitnessMemo();
+
+
+#endif //BENCHMARKFUNCTIONS2_FITNESSMEMO_H
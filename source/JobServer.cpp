@@ -0,0 +1,466 @@
+/**
+ * @file JobServer.cpp
+ * @class JobServer JobServer.h "JobServer.h"
+ * @author  Al Timofeyev
+ * @date    May 9, 2019
+ * @brief   A long-running server that reads search jobs, one per line,
+ *          from stdin or a Unix domain socket, runs them on a persistent
+ *          pool of worker threads and streams back each result as soon
+ *          as its job finishes.
+ *
+ * A job is one line of comma separated values:
+ *      id,functionID,minBound,maxBound,dimensions,algorithm,budget,seed[,alpha]
+ * where algorithm is one of BS, LS, ILS, PSO, SA, CMAES, GA, DS or LBFGS, and budget is
+ * the number of iterations (scaled per algorithm the same way as the first
+ * line of SearchAlgorithmConfig.txt). Each result is one line:
+ *      id,OK,algorithm,bestFitness,time(ms)
+ * or
+ *      id,ERROR,message
+ * Results come back in the order the jobs finish, not the order they were sent.
+ *
+ * The worker threads live as long as the server, so thread start-up is paid
+ * once and each worker keeps its warm heap arena between jobs. Every job runs
+ * on a single worker thread; the pool runs jobs side by side.
+ */
+
+#include "JobServer.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#define JOB_SERVER_HAS_SOCKETS
+#endif
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief The constructor for the JobConnection class.
+ * @param fd The connected socket, or -1 to write results to stdout.
+ */
+JobConnection::JobConnection(int fd)
+{
+    this->fd = fd;
+}
+
+/**
+ * @brief The destructor for the JobConnection class, closes the socket.
+ */
+JobConnection::~JobConnection()
+{
+#ifdef JOB_SERVER_HAS_SOCKETS
+    if(fd >= 0)
+        close(fd);
+#endif
+}
+
+/**
+ * @brief The constructor for the JobServer class, starts the worker threads.
+ * @param threads The number of jobs that run at the same time (at least 1).
+ */
+JobServer::JobServer(int threads)
+{
+    isStopping = false;
+    isShutdown = false;
+    listenerFd = -1;
+    activeReaders = 0;
+
+    if(threads < 1)
+        threads = 1;
+    for(int t = 0; t < threads; t++)
+        workers.emplace_back(&JobServer::workerLoop, this);
+}
+
+/**
+ * @brief The destructor for the JobServer class.
+ * Lets the workers finish every queued job, then joins them.
+ */
+JobServer::~JobServer()
+{
+    {
+        lock_guard<mutex> lock(queueLock);
+        isStopping = true;
+    }
+    queueSignal.notify_all();
+
+    for(int t = 0; t < workers.size(); t++)
+        workers[t].join();
+}
+
+// -------------------------------------------------------------------------------------------
+// --------------------------------- PUBLIC FUNCTIONS BELOW ----------------------------------
+// -------------------------------------------------------------------------------------------
+/**
+ * @brief Writes a line to the client.
+ * @param line The line to write, without the newline.
+ */
+void JobConnection::send(string line)
+{
+    line += "\n";
+    lock_guard<mutex> lock(writeLock);
+
+    if(fd < 0)
+    {
+        cout << line << flush;
+        return;
+    }
+
+#ifdef JOB_SERVER_HAS_SOCKETS
+    // Keep writing until the whole line is out (or the client is gone).
+    size_t written = 0;
+    while(written < line.size())
+    {
+        ssize_t count = ::send(fd, line.data() + written, line.size() - written, MSG_NOSIGNAL);
+        if(count <= 0)
+            return;
+        written += count;
+    }
+#endif
+}
+
+/**
+ * @brief Unblocks a read waiting on the socket, results can still be written.
+ */
+void JobConnection::stopReading()
+{
+#ifdef JOB_SERVER_HAS_SOCKETS
+    if(fd >= 0)
+        shutdown(fd, SHUT_RD);
+#endif
+}
+
+/**
+ * @brief Returns the socket of the connection.
+ * @return The socket, or -1 for stdin/stdout.
+ */
+int JobConnection::getFd()
+{
+    return fd;
+}
+
+/**
+ * @brief Serves jobs read from stdin, writing the results to stdout.
+ *
+ * Returns at the end of input or on a shutdown command. Jobs still queued
+ * at that point are finished when the server is destroyed.
+ */
+void JobServer::serveStream()
+{
+    shared_ptr<JobConnection> connection = make_shared<JobConnection>(-1);
+
+    string line;
+    while(!isShutdown && getline(cin, line))
+        handleLine(line, connection);
+}
+
+/**
+ * @brief Serves jobs sent to a Unix domain socket.
+ *
+ * Every client connection gets its own reader thread, and the results of a
+ * client's jobs are written back on its connection. Returns once a client
+ * sends the shutdown command; jobs still queued at that point are finished
+ * when the server is destroyed.
+ *
+ * @param socketPath The path of the socket (an existing file there is replaced).
+ *
+ * @return False if the socket couldn't be opened, true otherwise.
+ */
+bool JobServer::serveSocket(string socketPath)
+{
+#ifdef JOB_SERVER_HAS_SOCKETS
+    // Create, bind and listen on the socket.
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if(socketPath.size() >= sizeof(address.sun_path))
+    {
+        cout << "Socket path is too long: " << socketPath << endl;
+        return false;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+
+    listenerFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socketPath.c_str());
+    if(listenerFd < 0 || ::bind(listenerFd, (sockaddr *)&address, sizeof(address)) < 0 || listen(listenerFd, JOB_SOCKET_BACKLOG) < 0)
+    {
+        cout << "Failed to open socket: " << socketPath << endl;
+        if(listenerFd >= 0)
+            close(listenerFd);
+        return false;
+    }
+
+    // Accept clients until the shutdown command closes the listener.
+    while(!isShutdown)
+    {
+        int fd = accept(listenerFd, NULL, NULL);
+        if(fd < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            break;
+        }
+
+        // Forget the clients that are gone, and start a reader for the new one.
+        shared_ptr<JobConnection> connection = make_shared<JobConnection>(fd);
+        lock_guard<mutex> lock(connectionsLock);
+        connections.erase(remove_if(connections.begin(), connections.end(),
+                                    [](weak_ptr<JobConnection> &c) { return c.expired(); }), connections.end());
+        connections.push_back(connection);
+        activeReaders++;
+        thread(&JobServer::readConnection, this, connection).detach();
+    }
+
+    // Stop reading from the clients that are still connected, and wait for their readers.
+    {
+        unique_lock<mutex> lock(connectionsLock);
+        for(int c = 0; c < connections.size(); c++)
+            if(shared_ptr<JobConnection> connection = connections[c].lock())
+                connection->stopReading();
+        readersSignal.wait(lock, [this]() { return activeReaders == 0; });
+        connections.clear();
+    }
+
+    close(listenerFd);
+    unlink(socketPath.c_str());
+    return true;
+#else
+    cout << "Unix domain sockets aren't available on this platform, use --serve without a path.\n";
+    return false;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------
+// --------------------------------- PRIVATE FUNCTIONS BELOW ---------------------------------
+// -------------------------------------------------------------------------------------------
+/**
+ * @brief Runs queued jobs, sending each result back as soon as its job finishes.
+ * Returns once the server is stopping and the queue is empty.
+ */
+void JobServer::workerLoop()
+{
+    while(true)
+    {
+        pair<SearchJob, shared_ptr<JobConnection>> job;
+        {
+            unique_lock<mutex> lock(queueLock);
+            queueSignal.wait(lock, [this]() { return isStopping || !jobs.empty(); });
+            if(jobs.empty())
+                return;
+
+            job = jobs.front();
+            jobs.pop();
+        }
+
+        job.second->send(runJob(job.first));
+    }
+}
+
+/**
+ * @brief Reads the jobs a client sends on its socket, one per line.
+ * @param connection The client's connection.
+ */
+void JobServer::readConnection(shared_ptr<JobConnection> connection)
+{
+#ifdef JOB_SERVER_HAS_SOCKETS
+    char buffer[4096];
+    string pending;
+
+    ssize_t count;
+    while((count = recv(connection->getFd(), buffer, sizeof(buffer), 0)) > 0)
+    {
+        pending.append(buffer, count);
+
+        // Handle every complete line.
+        size_t start = 0, end;
+        while((end = pending.find('\n', start)) != string::npos)
+        {
+            handleLine(pending.substr(start, end - start), connection);
+            start = end + 1;
+        }
+        pending.erase(0, start);
+    }
+
+    // A last line without a newline.
+    if(!pending.empty())
+        handleLine(pending, connection);
+#endif
+
+    // Let serveSocket() know this reader is done.
+    lock_guard<mutex> lock(connectionsLock);
+    activeReaders--;
+    readersSignal.notify_all();
+}
+
+/**
+ * @brief Queues the job on a line, or runs the shutdown command.
+ *
+ * Blank lines are ignored, and a line that isn't a valid job gets an
+ * ERROR result right away.
+ *
+ * @param line The line the client sent.
+ * @param connection Where the result of the job goes.
+ */
+void JobServer::handleLine(string line, shared_ptr<JobConnection> connection)
+{
+    // Ignore the carriage return of Windows line endings.
+    if(!line.empty() && line[line.size()-1] == '\r')
+        line.erase(line.size()-1);
+    if(line.find_first_not_of(" \t") == string::npos)
+        return;
+
+    if(line == JOB_SHUTDOWN_COMMAND)
+    {
+        isShutdown = true;
+#ifdef JOB_SERVER_HAS_SOCKETS
+        if(listenerFd >= 0)
+            shutdown(listenerFd, SHUT_RDWR);
+#endif
+        return;
+    }
+
+    SearchJob job;
+    string error;
+    if(!parseJob(line, job, error))
+    {
+        connection->send(job.id + ",ERROR," + error);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(queueLock);
+        jobs.push(make_pair(job, connection));
+    }
+    queueSignal.notify_one();
+}
+
+/**
+ * @brief Parses a job description.
+ *
+ * @note This function makes a call to utilities.h --> nextToken() and parseNumber().
+ *
+ * @param line id,functionID,minBound,maxBound,dimensions,algorithm,budget,seed[,alpha]
+ * @param job Where the job is stored.
+ * @param error Set to the reason the line isn't a valid job.
+ *
+ * @return True if the line is a valid job, false otherwise.
+ */
+bool JobServer::parseJob(string line, SearchJob &job, string &error)
+{
+    // Split the line into its fields, without copying them.
+    string_view text = line, fields[10];
+    int count = 0;
+    while(count < 10 && nextToken(text, ", \t", fields[count]))
+        count++;
+    job.id = count > 0 ? string(fields[0]) : "";
+    if(count != 8 && count != 9)
+    {
+        error = "expected id,functionID,minBound,maxBound,dimensions,algorithm,budget,seed[,alpha]";
+        return false;
+    }
+
+    // Parse the numbers, naming the first one that isn't valid.
+    job.algorithm = string(fields[5]);
+    job.alpha = JOB_DEFAULT_ALPHA;
+    if(!parseNumber(fields[1], job.functionID))
+        error = "invalid functionID";
+    else if(!parseNumber(fields[2], job.minBound))
+        error = "invalid minBound";
+    else if(!parseNumber(fields[3], job.maxBound))
+        error = "invalid maxBound";
+    else if(!parseNumber(fields[4], job.dimensions))
+        error = "invalid dimensions";
+    else if(!parseNumber(fields[6], job.budget))
+        error = "invalid budget";
+    else if(!parseNumber(fields[7], job.seed))
+        error = "invalid seed";
+    else if(count == 9 && !parseNumber(fields[8], job.alpha))
+        error = "invalid alpha";
+    if(!error.empty())
+        return false;
+
+    if(job.functionID < 1 || job.functionID > 18)
+        error = "function ID must be 1 - 18";
+    else if(job.dimensions < 2)
+        error = "dimensions must be at least 2";
+    else if(job.budget < 1)
+        error = "budget must be at least 1";
+    else if(!(job.minBound < job.maxBound))
+        error = "minBound must be less than maxBound";
+    else if(job.algorithm != ALG_BLIND_SEARCH && job.algorithm != ALG_LOCAL_SEARCH && job.algorithm != ALG_ITERATIVE_LOCAL_SEARCH &&
+            job.algorithm != ALG_PARTICLE_SWARM && job.algorithm != ALG_SIMULATED_ANNEALING && job.algorithm != ALG_CMAES &&
+            job.algorithm != ALG_GENETIC && job.algorithm != ALG_DECOMPOSITION && job.algorithm != ALG_LBFGS)
+        error = "unknown algorithm " + job.algorithm;
+
+    return error.empty();
+}
+
+/**
+ * @brief Runs a job on the calling thread.
+ *
+ * @note This function makes a call to runSearch().
+ *
+ * @param job The job to run.
+ *
+ * @return The result line of the job.
+ */
+string JobServer::runJob(SearchJob &job)
+{
+    double elapsedTimeMS;
+    double bestFitness = runSearch(job, elapsedTimeMS);
+    return job.id + ",OK," + job.algorithm + "," + to_string(bestFitness) + "," + to_string(elapsedTimeMS);
+}
+
+/**
+ * @brief Runs the search of a job on the calling thread (and job.threads - 1 helpers).
+ *
+ * The job seeds this thread's random number generators, so the same job
+ * always gives the same result. The algorithms are given the same budgets
+ * as in performAllSearchAlgorithms(), with a population of
+ * DEFAULT_NUM_OF_VECTORS.
+ *
+ * @note This function makes a call to utilities.h --> setRandomSeed().
+ * @note This function makes a call to SearchAlgorithms.h.
+ *
+ * @param job The job to run.
+ * @param elapsedTimeMS Set to the time the search took in milliseconds.
+ *
+ * @return The best fitness found.
+ */
+double JobServer::runSearch(SearchJob &job, double &elapsedTimeMS)
+{
+    setRandomSeed(job.seed);
+
+    int rows = DEFAULT_NUM_OF_VECTORS, columns = job.dimensions;
+    double minBound = job.minBound, maxBound = job.maxBound;
+    long long evaluations;
+    vector<double> fitnessList;
+
+    // The single-point searches start from a random vector.
+    vector<double> start = createMatrix(1, columns, minBound, maxBound)[0];
+
+    auto startTime = chrono::high_resolution_clock::now();
+    if(job.algorithm == ALG_BLIND_SEARCH)
+        fitnessList.push_back(blindSearch(job.budget, start, calculateFitnessOfVector(start, job.functionID), job.functionID, rows, columns, minBound, maxBound, job.sampler));
+    else if(job.algorithm == ALG_LOCAL_SEARCH)
+        fitnessList.push_back(localSearch(start, job.functionID, job.alpha, evaluations, job.localSearchMode));
+    else if(job.algorithm == ALG_ITERATIVE_LOCAL_SEARCH)
+        fitnessList = iterativeLocalSearch(job.budget, start, job.functionID, job.alpha, minBound, maxBound, job.threads, evaluations, job.sampler, job.localSearchMode);
+    else if(job.algorithm == ALG_PARTICLE_SWARM)
+        fitnessList = particleSwarmOptimization(job.budget, rows, job.functionID, columns, minBound, maxBound, job.threads, evaluations);
+    else if(job.algorithm == ALG_SIMULATED_ANNEALING)
+        fitnessList = simulatedAnnealing(rows, (long long)job.budget * columns * SA_MOVES_PER_DIMENSION, job.functionID, columns, minBound, maxBound, job.coolingSchedule, job.threads, evaluations);
+    else if(job.algorithm == ALG_CMAES)
+        fitnessList = covarianceMatrixAdaptation(job.budget * CMAES_GENERATIONS_PER_ITERATION, job.functionID, columns, minBound, maxBound, job.threads, evaluations);
+    else if(job.algorithm == ALG_GENETIC)
+        fitnessList = geneticAlgorithm(job.budget * GA_GENERATIONS_PER_ITERATION, rows, job.functionID, columns, minBound, maxBound, job.crossoverType, job.threads, evaluations);
+    else if(job.algorithm == ALG_DECOMPOSITION)
+        fitnessList = decompositionSearch(job.budget, job.functionID, columns, minBound, maxBound, job.threads, evaluations);
+    else if(job.algorithm == ALG_LBFGS)
+        fitnessList = limitedMemoryBFGS(job.budget, job.functionID, columns, minBound, maxBound, job.threads, evaluations);
+    auto endTime = chrono::high_resolution_clock::now();
+
+    elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count();
+    return *min_element(fitnessList.begin(), fitnessList.end());
+}
@@ -0,0 +1,96 @@
+/**
+ * @file JobServer.h
+ * @author  Al Timofeyev
+ * @date    May 9, 2019
+ * @brief   A long-running server that reads search jobs, one per line,
+ *          from stdin or a Unix domain socket, runs them on a persistent
+ *          pool of worker threads and streams back each result as soon
+ *          as its job finishes.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_JOBSERVER_H
+#define BENCHMARKFUNCTIONS2_JOBSERVER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include "ProcessFunctions.h"
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** The alpha value used by jobs that don't give one. */
+#define JOB_DEFAULT_ALPHA 0.11
+/** The command that stops the server once the queued jobs are finished. */
+#define JOB_SHUTDOWN_COMMAND "shutdown"
+/** The number of pending connections the socket keeps. */
+#define JOB_SOCKET_BACKLOG 64
+
+/**
+ * @brief A client of the job server: where the results of its jobs are written.
+ *
+ * The results are written one line at a time under a lock, so lines from
+ * jobs that finish at the same time don't interleave.
+ */
+class JobConnection{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    JobConnection(int fd);  // A socket, or -1 for stdout.
+    ~JobConnection();       // Closes the socket.
+
+    // --------------------- Functions Declarations ---------------------
+    void send(string line);     /**< Writes a line to the client.*/
+    void stopReading();         /**< Unblocks a read waiting on the socket.*/
+    int getFd();                /**< Returns the socket (-1 for stdin/stdout).*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    int fd;
+    mutex writeLock;
+};
+
+class JobServer{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    JobServer(int threads); // Starts the worker threads.
+    ~JobServer();           // Finishes the queued jobs and stops the worker threads.
+
+    // --------------------- Functions Declarations ---------------------
+    void serveStream();                     /**< Serves jobs from stdin until the end of input.*/
+    bool serveSocket(string socketPath);    /**< Serves jobs from a Unix domain socket until a shutdown command.*/
+
+    static double runSearch(SearchJob &job, double &elapsedTimeMS);    /**< Runs the search of a job and returns the best fitness found.*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    vector<thread> workers;
+    queue<pair<SearchJob, shared_ptr<JobConnection>>> jobs;
+    mutex queueLock;
+    condition_variable queueSignal;
+    bool isStopping;
+
+    atomic<bool> isShutdown;
+    int listenerFd;
+    vector<weak_ptr<JobConnection>> connections;
+    int activeReaders;
+    mutex connectionsLock;
+    condition_variable readersSignal;
+
+    // --------------------- Functions Declarations ---------------------
+    void workerLoop();                                                  /**< Runs queued jobs until the server stops.*/
+    void readConnection(shared_ptr<JobConnection> connection);          /**< Reads the jobs sent on a socket.*/
+    void handleLine(string line, shared_ptr<JobConnection> connection); /**< Queues the job (or runs the command) on one line.*/
+    bool parseJob(string line, SearchJob &job, string &error);          /**< Parses a job description.*/
+    string runJob(SearchJob &job);                                      /**< Runs a job and returns its result line.*/
+};
+
+
+#endif //BENCHMARKFUNCTIONS2_JOBSERVER_H
@@ -0,0 +1,360 @@
+/**
+ * @file LinearAlgebra.cpp
+ * @author  Al Timofeyev
+ * @date    May 2, 2019
+ * @brief   A small library of dense linear algebra routines used by the
+ *          search algorithms. Matrices are square, stored row-major in a
+ *          flat vector (element (i, j) of an n x n matrix is at i*n + j).
+ */
+
+#include "LinearAlgebra.h"
+
+/**
+ * @brief Multiplies count vectors by an n x n matrix using cache blocking.
+ *
+ * Computes Y[k] = A * Z[k] for every k. Instead of streaming the whole of A
+ * once per vector, A is walked in LA_BLOCK_SIZE x LA_BLOCK_SIZE tiles and each
+ * tile is applied to all count vectors while it is still in cache, so A is
+ * read from memory about once per call no matter how many vectors there are.
+ *
+ * @param A The n x n row-major matrix.
+ * @param n The size of the matrix and of every vector.
+ * @param Z The count input vectors, stored one after another (count x n).
+ * @param Y The count output vectors, stored one after another (resized to count x n).
+ * @param count The number of vectors.
+ */
+void blockedMatrixVectorProduct(vector<double> &A, int n, vector<double> &Z, vector<double> &Y, int count)
+{
+    // Clear the output vectors, the tiles add into them.
+    Y.assign((long)count * n, 0.0);
+
+    for(int rowBlock = 0; rowBlock < n; rowBlock += LA_BLOCK_SIZE)
+    {
+        int rowEnd = min(rowBlock + LA_BLOCK_SIZE, n);
+        for(int colBlock = 0; colBlock < n; colBlock += LA_BLOCK_SIZE)
+        {
+            int colEnd = min(colBlock + LA_BLOCK_SIZE, n);
+
+            // Apply this tile of A to every vector.
+            for(int k = 0; k < count; k++)
+            {
+                const double *z = &Z[(long)k * n];
+                double *y = &Y[(long)k * n];
+                for(int i = rowBlock; i < rowEnd; i++)
+                {
+                    const double *a = &A[(long)i * n];
+                    double sum = 0;
+                    for(int j = colBlock; j < colEnd; j++)
+                        sum += a[j] * z[j];
+                    y[i] += sum;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Applies a scaled rank-count update to a symmetric matrix.
+ *
+ * Computes C = scale*C + sum over k of weights[k] * V[k] * V[k]^T. The vectors
+ * are transposed first so every element of the update is a contiguous dot
+ * product over k, and the upper triangle is computed tile by tile and then
+ * mirrored into the lower triangle.
+ *
+ * @param C The n x n symmetric row-major matrix that is updated.
+ * @param n The size of the matrix and of every vector.
+ * @param scale The factor applied to C before the update.
+ * @param V The count update vectors, stored one after another (count x n).
+ * @param weights The weight of each update vector.
+ * @param count The number of update vectors.
+ */
+void symmetricRankUpdate(vector<double> &C, int n, double scale, vector<double> &V, vector<double> &weights, int count)
+{
+    // Transpose the vectors (and a weighted copy) so element i of every vector is contiguous.
+    vector<double> columns((long)n * count), weightedColumns((long)n * count);
+    for(int k = 0; k < count; k++)
+        for(int i = 0; i < n; i++)
+        {
+            columns[(long)i * count + k] = V[(long)k * n + i];
+            weightedColumns[(long)i * count + k] = weights[k] * V[(long)k * n + i];
+        }
+
+    // Update the upper triangle one tile at a time.
+    for(int rowBlock = 0; rowBlock < n; rowBlock += LA_BLOCK_SIZE)
+    {
+        int rowEnd = min(rowBlock + LA_BLOCK_SIZE, n);
+        for(int colBlock = rowBlock; colBlock < n; colBlock += LA_BLOCK_SIZE)
+        {
+            int colEnd = min(colBlock + LA_BLOCK_SIZE, n);
+            for(int i = rowBlock; i < rowEnd; i++)
+            {
+                const double *wi = &weightedColumns[(long)i * count];
+                for(int j = max(colBlock, i); j < colEnd; j++)
+                {
+                    const double *vj = &columns[(long)j * count];
+                    double sum = 0;
+                    for(int k = 0; k < count; k++)
+                        sum += wi[k] * vj[k];
+                    C[(long)i * n + j] = scale * C[(long)i * n + j] + sum;
+                }
+            }
+        }
+    }
+
+    // Mirror the upper triangle into the lower triangle.
+    for(int i = 0; i < n; i++)
+        for(int j = 0; j < i; j++)
+            C[(long)i * n + j] = C[(long)j * n + i];
+}
+
+/**
+ * @brief Computes the eigenvalues and eigenvectors of a symmetric matrix.
+ *
+ * Uses a Householder reduction to tridiagonal form followed by implicit QL
+ * iterations (the EISPACK tred2/tql2 pair, as used in JAMA). No external BLAS
+ * or LAPACK is needed.
+ *
+ * @param C The n x n symmetric row-major matrix (not modified).
+ * @param n The size of the matrix.
+ * @param eigenvalues Set to the n eigenvalues in ascending order.
+ * @param eigenvectors Set to the n unit eigenvectors, one per row (row i belongs to eigenvalues[i]).
+ */
+void symmetricEigenDecomposition(vector<double> &C, int n, vector<double> &eigenvalues, vector<double> &eigenvectors)
+{
+    vector<double> V = C;
+    vector<double> d(n), e(n);
+
+    // Reduce to tridiagonal form, accumulating the transformations in V (columns).
+    tridiagonalize(V, n, d, e);
+
+    // Transpose so each eigenvector is a contiguous row for the QL rotations.
+    eigenvectors.resize((long)n * n);
+    for(int i = 0; i < n; i++)
+        for(int j = 0; j < n; j++)
+            eigenvectors[(long)j * n + i] = V[(long)i * n + j];
+
+    // Diagonalize the tridiagonal matrix.
+    tridiagonalQL(eigenvectors, n, d, e);
+
+    // Sort the eigenvalues (and their eigenvectors) in ascending order.
+    for(int i = 0; i < n-1; i++)
+    {
+        int k = i;
+        for(int j = i+1; j < n; j++)
+            if(d[j] < d[k])
+                k = j;
+        if(k != i)
+        {
+            swap(d[i], d[k]);
+            swap_ranges(eigenvectors.begin() + (long)i * n, eigenvectors.begin() + (long)(i+1) * n, eigenvectors.begin() + (long)k * n);
+        }
+    }
+    eigenvalues = d;
+}
+
+/**
+ * @brief Householder reduction of a symmetric matrix to tridiagonal form.
+ *
+ * @param V On input the symmetric matrix, on output the orthogonal transformation (columns).
+ * @param n The size of the matrix.
+ * @param d Set to the diagonal of the tridiagonal matrix.
+ * @param e Set to the subdiagonal of the tridiagonal matrix (e[0] is 0).
+ */
+void tridiagonalize(vector<double> &V, int n, vector<double> &d, vector<double> &e)
+{
+    for(int j = 0; j < n; j++)
+        d[j] = V[(long)(n-1) * n + j];
+
+    // Householder reduction to tridiagonal form.
+    for(int i = n-1; i > 0; i--)
+    {
+        // Scale to avoid under/overflow.
+        double scale = 0.0;
+        double h = 0.0;
+        for(int k = 0; k < i; k++)
+            scale += abs(d[k]);
+
+        if(scale == 0.0)
+        {
+            e[i] = d[i-1];
+            for(int j = 0; j < i; j++)
+            {
+                d[j] = V[(long)(i-1) * n + j];
+                V[(long)i * n + j] = 0.0;
+                V[(long)j * n + i] = 0.0;
+            }
+        }
+        else
+        {
+            // Generate the Householder vector.
+            for(int k = 0; k < i; k++)
+            {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            double f = d[i-1];
+            double g = sqrt(h);
+            if(f > 0)
+                g = -g;
+            e[i] = scale * g;
+            h = h - f * g;
+            d[i-1] = f - g;
+            for(int j = 0; j < i; j++)
+                e[j] = 0.0;
+
+            // Apply the similarity transformation to the remaining columns.
+            for(int j = 0; j < i; j++)
+            {
+                f = d[j];
+                V[(long)j * n + i] = f;
+                g = e[j] + V[(long)j * n + j] * f;
+                for(int k = j+1; k <= i-1; k++)
+                {
+                    g += V[(long)k * n + j] * d[k];
+                    e[k] += V[(long)k * n + j] * f;
+                }
+                e[j] = g;
+            }
+            f = 0.0;
+            for(int j = 0; j < i; j++)
+            {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            double hh = f / (h + h);
+            for(int j = 0; j < i; j++)
+                e[j] -= hh * d[j];
+            for(int j = 0; j < i; j++)
+            {
+                f = d[j];
+                g = e[j];
+                for(int k = j; k <= i-1; k++)
+                    V[(long)k * n + j] -= (f * e[k] + g * d[k]);
+                d[j] = V[(long)(i-1) * n + j];
+                V[(long)i * n + j] = 0.0;
+            }
+        }
+        d[i] = h;
+    }
+
+    // Accumulate the transformations.
+    for(int i = 0; i < n-1; i++)
+    {
+        V[(long)(n-1) * n + i] = V[(long)i * n + i];
+        V[(long)i * n + i] = 1.0;
+        double h = d[i+1];
+        if(h != 0.0)
+        {
+            for(int k = 0; k <= i; k++)
+                d[k] = V[(long)k * n + i+1] / h;
+            for(int j = 0; j <= i; j++)
+            {
+                double g = 0.0;
+                for(int k = 0; k <= i; k++)
+                    g += V[(long)k * n + i+1] * V[(long)k * n + j];
+                for(int k = 0; k <= i; k++)
+                    V[(long)k * n + j] -= g * d[k];
+            }
+        }
+        for(int k = 0; k <= i; k++)
+            V[(long)k * n + i+1] = 0.0;
+    }
+    for(int j = 0; j < n; j++)
+    {
+        d[j] = V[(long)(n-1) * n + j];
+        V[(long)(n-1) * n + j] = 0.0;
+    }
+    V[(long)(n-1) * n + n-1] = 1.0;
+    e[0] = 0.0;
+}
+
+/**
+ * @brief Implicit QL iterations on a symmetric tridiagonal matrix.
+ *
+ * @note Unlike tridiagonalize(), the eigenvectors in V are stored as rows, so
+ *       every Givens rotation works on two contiguous rows.
+ *
+ * @param V On input the transformation from tridiagonalize() (transposed), on output the eigenvectors (rows).
+ * @param n The size of the matrix.
+ * @param d On input the diagonal, on output the (unsorted) eigenvalues.
+ * @param e On input the subdiagonal, destroyed on output.
+ */
+void tridiagonalQL(vector<double> &V, int n, vector<double> &d, vector<double> &e)
+{
+    for(int i = 1; i < n; i++)
+        e[i-1] = e[i];
+    e[n-1] = 0.0;
+
+    double f = 0.0;
+    double tst1 = 0.0;
+    double eps = pow(2.0, -52.0);
+    for(int l = 0; l < n; l++)
+    {
+        // Find a small subdiagonal element.
+        tst1 = max(tst1, abs(d[l]) + abs(e[l]));
+        int m = l;
+        while(m < n)
+        {
+            if(abs(e[m]) <= eps * tst1)
+                break;
+            m++;
+        }
+
+        // If m == l, d[l] is already an eigenvalue, otherwise iterate.
+        if(m > l)
+        {
+            do
+            {
+                // Compute the implicit shift.
+                double g = d[l];
+                double p = (d[l+1] - g) / (2.0 * e[l]);
+                double r = hypot(p, 1.0);
+                if(p < 0)
+                    r = -r;
+                d[l] = e[l] / (p + r);
+                d[l+1] = e[l] * (p + r);
+                double dl1 = d[l+1];
+                double h = g - d[l];
+                for(int i = l+2; i < n; i++)
+                    d[i] -= h;
+                f += h;
+
+                // Implicit QL transformation.
+                p = d[m];
+                double c = 1.0, c2 = c, c3 = c;
+                double el1 = e[l+1];
+                double s = 0.0, s2 = 0.0;
+                for(int i = m-1; i >= l; i--)
+                {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = hypot(p, e[i]);
+                    e[i+1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i+1] = h + s * (c * g + s * d[i]);
+
+                    // Rotate eigenvectors i and i+1.
+                    double *vi = &V[(long)i * n];
+                    double *vi1 = &V[(long)(i+1) * n];
+                    for(int k = 0; k < n; k++)
+                    {
+                        h = vi1[k];
+                        vi1[k] = s * vi[k] + c * h;
+                        vi[k] = c * vi[k] - s * h;
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            }
+            while(abs(e[l]) > eps * tst1);
+        }
+        d[l] = d[l] + f;
+        e[l] = 0.0;
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * @file LinearAlgebra.h
+ * @author  Al Timofeyev
+ * @date    May 2, 2019
+ * @brief   A small library of dense linear algebra routines used by the
+ *          search algorithms. Matrices are square, stored row-major in a
+ *          flat vector (element (i, j) of an n x n matrix is at i*n + j).
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_LINEARALGEBRA_H
+#define BENCHMARKFUNCTIONS2_LINEARALGEBRA_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** The width of the square tiles the blocked routines work on (64x64 doubles = 32KB). */
+#define LA_BLOCK_SIZE 64
+
+/** Multiplies count vectors by an n x n matrix: Y[k] = A * Z[k], using cache blocking.*/
+void blockedMatrixVectorProduct(vector<double> &A, int n, vector<double> &Z, vector<double> &Y, int count);
+
+/** Applies a scaled rank-count update to a symmetric matrix: C = scale*C + sum(weights[k] * V[k] * V[k]^T).*/
+void symmetricRankUpdate(vector<double> &C, int n, double scale, vector<double> &V, vector<double> &weights, int count);
+
+/** Computes the eigenvalues and eigenvectors of a symmetric n x n matrix.*/
+void symmetricEigenDecomposition(vector<double> &C, int n, vector<double> &eigenvalues, vector<double> &eigenvectors);
+
+/** Householder reduction of a symmetric matrix to tridiagonal form.*/
+void tridiagonalize(vector<double> &V, int n, vector<double> &d, vector<double> &e);
+
+/** Implicit QL iterations on a tridiagonal matrix.*/
+void tridiagonalQL(vector<double> &V, int n, vector<double> &d, vector<double> &e);
+
+#endif //BENCHMARKFUNCTIONS2_LINEARALGEBRA_H
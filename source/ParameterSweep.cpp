@@ -0,0 +1,784 @@
+/**
+ * @file ParameterSweep.cpp
+ * @class ParameterSweep ParameterSweep.h "ParameterSweep.h"
+ * @author  Al Timofeyev
+ * @date    May 14, 2019
+ * @brief   Expands a sweep specification (lists and ranges of dimensions,
+ *          functions, alphas, iteration budgets, trials, thread counts and
+ *          algorithms) into a list of search jobs, and runs them on a pool
+ *          of threads, largest job first.
+ *
+ * A sweep file has one key = value pair per line, and # starts a comment:
+ *      dimensions = 10, 20:30:10       # lists and start:end[:step] ranges
+ *      function   = 1, -512, 512       # functionID, minBound, maxBound (repeat for more)
+ *      function   = 5, -100, 100
+ *      alpha      = 0.05:0.2:0.05
+ *      iterations = 30, 100
+ *      trials     = 5
+ *      threads    = 1, 4
+ *      algorithms = ILS, PSO, SA       # or all
+ *      cooling    = exponential        # linear, logarithmic, or 1 - 3
+ *      crossover  = blend              # sbx (the default) or blend, the crossover of GA
+ *      sampler    = sobol              # random (the default), halton or lhs, for BS and ILS
+ *      localsearch = adaptive          # fixed (the default) or adaptive, the descent of LS and ILS
+ *      seed       = 42
+ *      output     = results.csv
+ *      cache      = sweeps.cache       # reuse the results of jobs run before
+ * Only dimensions and function are required. The list keys can be given
+ * more than once, their values add up.
+ *
+ * Every combination is one job (run as by JobServer::runSearch()), except
+ * that the values an algorithm ignores aren't repeated: only LS and ILS use
+ * alpha, LS has no iterations, and BS and LS run on a single thread. Each job
+ * gets its own seed derived from the sweep seed and its place in the grid, so
+ * a sweep is repeatable no matter how its jobs are scheduled (except for ILS
+ * on more than one thread, whose threads race to share their best vector).
+ * The trials of a fixed Local Search make one batch, run in lockstep by
+ * localSearchBatch(), which gives every trial the result it gets on its own.
+ *
+ * With a cache, a job that was run before (the same job, with the same seed,
+ * by the same build) takes its best fitness and time from the cache, and
+ * every job that runs adds its result to it as soon as it's done. ILS jobs
+ * on more than one thread aren't repeatable, so they're never cached.
+ *
+ * A file without any key = value lines is a classic configuration file: its
+ * dimensions and functions are swept once with the iterations, alpha, cooling
+ * schedule, algorithms and crossover of the search configuration file.
+ */
+
+#include "ParameterSweep.h"
+
+/** Returns the full specification of a job, the key of its result in the result cache (empty if its result can't be repeated). */
+static string jobCacheKey(SearchJob &job)
+{
+    // The threads of ILS race to share their best vector, so its result depends on their timing.
+    if(job.algorithm == ALG_ITERATIVE_LOCAL_SEARCH && job.threads > 1)
+        return "";
+
+    ostringstream key;
+    key << setprecision(17) << "job," << ResultCache::buildVersion() << "," << job.functionID << "," << job.minBound << "," << job.maxBound << ","
+        << job.dimensions << "," << job.algorithm << "," << job.budget << "," << job.seed << "," << job.alpha << "," << job.threads << ","
+        << job.coolingSchedule << "," << job.crossoverType << "," << job.sampler << "," << job.localSearchMode;
+    return key.str();
+}
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief The constructor for the ParameterSweep class.
+ */
+ParameterSweep::ParameterSweep()
+{
+    coolingSchedule = COOLING_EXPONENTIAL;
+    crossoverType = GA_CROSSOVER_SBX;
+    samplerType = SAMPLER_RANDOM;
+    localSearchMode = LS_MODE_FIXED;
+    seed = random_device()();
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PUBLIC FUNCTIONS BELOW ------------------
+// ----------------------------------------------------------
+/**
+ * @brief Reads a sweep file, or a classic configuration file and its search configuration file.
+ *
+ * @param sweepFilename         The sweep file, or a classic configuration file.
+ * @param searchConfigFilename  The search configuration file used with a classic configuration file.
+ *
+ * @return True if the sweep was read and is valid, false otherwise.
+ */
+bool ParameterSweep::load(string sweepFilename, string searchConfigFilename)
+{
+    ifstream sweepFile;
+    sweepFile.open(sweepFilename);
+    if(sweepFile.fail())
+    {
+        cout << "Failed to open file: " << sweepFilename << endl;
+        return false;
+    }
+
+    // A sweep file has key = value lines, a classic configuration file never does.
+    string line;
+    bool isSpec = false;
+    while(!isSpec && getline(sweepFile, line))
+        isSpec = line.substr(0, line.find('#')).find('=') != string::npos;
+    sweepFile.close();
+
+    dimensions.resize(0);
+    functions.resize(0);
+    alphas.resize(0);
+    iterations.resize(0);
+    trials.resize(0);
+    threads.resize(0);
+    algorithms.resize(0);
+    outputFilename = "";
+    cacheFilename = "";
+
+    if(!(isSpec ? loadSpec(sweepFilename) : loadClassic(sweepFilename, searchConfigFilename)))
+        return false;
+
+    // Fill in the defaults.
+    if(alphas.size() == 0)
+        alphas.push_back(JOB_DEFAULT_ALPHA);
+    if(iterations.size() == 0)
+        iterations.push_back(SWEEP_DEFAULT_ITERATIONS);
+    if(trials.size() == 0)
+        trials.push_back(1);
+    if(threads.size() == 0)
+        threads.push_back(1);
+    if(algorithms.size() == 0)
+        algorithms = {ALG_BLIND_SEARCH, ALG_LOCAL_SEARCH, ALG_ITERATIVE_LOCAL_SEARCH, ALG_PARTICLE_SWARM,
+                      ALG_SIMULATED_ANNEALING, ALG_CMAES, ALG_GENETIC, ALG_DECOMPOSITION, ALG_LBFGS};
+    if(outputFilename.empty())
+        outputFilename = parseStringStr(sweepFilename, ".")[0] + SWEEP_RESULTS_SUFFIX;
+
+    string error;
+    if(!validate(error))
+    {
+        cout << sweepFilename << ": " << error << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns every job of the sweep, in grid order.
+ *
+ * The grid is walked dimensions first, then functions, algorithms,
+ * iterations, alphas, threads and trials. The values an algorithm ignores
+ * are not repeated. The seed of each job comes from the sweep seed and the
+ * position of the job in the grid.
+ *
+ * @return The jobs of the sweep, their id is their position in the grid.
+ */
+vector<SearchJob> ParameterSweep::expand()
+{
+    vector<SearchJob> jobs;
+    for(int d = 0; d < dimensions.size(); d++)
+    {
+        for(int f = 0; f < functions.size(); f++)
+        {
+            for(int a = 0; a < algorithms.size(); a++)
+            {
+                string algorithm = algorithms[a];
+                bool usesAlpha = algorithm == ALG_LOCAL_SEARCH || algorithm == ALG_ITERATIVE_LOCAL_SEARCH;
+                bool usesIterations = algorithm != ALG_LOCAL_SEARCH;
+                bool usesThreads = algorithm != ALG_LOCAL_SEARCH && algorithm != ALG_BLIND_SEARCH;
+
+                for(int i = 0; i < (usesIterations ? iterations.size() : 1); i++)
+                {
+                    for(int al = 0; al < (usesAlpha ? alphas.size() : 1); al++)
+                    {
+                        for(int t = 0; t < (usesThreads ? threads.size() : 1); t++)
+                        {
+                            for(int trial = 0; trial < trials[0]; trial++)
+                            {
+                                SearchJob job;
+                                job.id = to_string(jobs.size());
+                                job.functionID = (int)functions[f][0];
+                                job.minBound = functions[f][1];
+                                job.maxBound = functions[f][2];
+                                job.dimensions = dimensions[d];
+                                job.algorithm = algorithm;
+                                job.budget = iterations[i];
+                                job.alpha = alphas[al];
+                                job.threads = usesThreads ? threads[t] : 1;
+                                job.coolingSchedule = coolingSchedule;
+                                job.crossoverType = crossoverType;
+                                job.sampler = samplerType;
+                                job.localSearchMode = localSearchMode;
+
+                                seed_seq jobSeed{seed, (unsigned int)jobs.size()};
+                                jobSeed.generate(&job.seed, &job.seed + 1);
+                                jobs.push_back(job);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return jobs;
+}
+
+/**
+ * @brief Runs every job of the sweep and saves the results.
+ *
+ * Jobs found in the result cache (if there is one) aren't run. The trials
+ * of a fixed Local Search (same dimensions, function and alpha) are
+ * run together as one batch, by runLocalSearchBatch(). The jobs and batches
+ * are sorted largest first (by estimateCost()), so the long jobs don't end
+ * up running alone at the end of the sweep, and handed out one at a time to
+ * a pool of threads sized so that the jobs running at once don't ask for
+ * more threads than the hardware has. The results file has one row per job,
+ * in grid order.
+ *
+ * @note This function makes a call to JobServer.h --> runSearch().
+ * @note This function makes a call to ParameterSweep.h --> runLocalSearchBatch().
+ *
+ * @return True if every job ran and the results were saved, false otherwise.
+ */
+bool ParameterSweep::run()
+{
+    vector<SearchJob> jobs = expand();
+    vector<double> bestFitness(jobs.size()), elapsedTimeMS(jobs.size());
+
+    // The jobs run before come from the result cache.
+    ResultCache cache;
+    vector<string> cacheKeys(jobs.size());
+    vector<bool> isCached(jobs.size(), false);
+    int cachedJobs = 0;
+    if(!cacheFilename.empty())
+    {
+        if(!cache.open(cacheFilename))
+            return false;
+        string value;
+        for(int j = 0; j < jobs.size(); j++)
+        {
+            cacheKeys[j] = jobCacheKey(jobs[j]);
+            if(!cacheKeys[j].empty() && cache.lookup(cacheKeys[j], value) && value.size() == 2 * sizeof(double))
+            {
+                memcpy(&bestFitness[j], value.data(), sizeof(double));
+                memcpy(&elapsedTimeMS[j], value.data() + sizeof(double), sizeof(double));
+                isCached[j] = true;
+                cachedJobs++;
+            }
+        }
+    }
+
+    // One task per job, except the trials of a fixed Local Search (next to each other in grid order), which make one batch.
+    vector<vector<int>> tasks;
+    int jobThreads = 1;
+    for(int j = 0; j < jobs.size(); j++)
+    {
+        SearchJob &job = jobs[j];
+        if(isCached[j])
+            continue;
+        if(!tasks.empty() && job.algorithm == ALG_LOCAL_SEARCH && job.localSearchMode == LS_MODE_FIXED)
+        {
+            SearchJob &last = jobs[tasks.back().back()];
+            if(last.algorithm == ALG_LOCAL_SEARCH && last.dimensions == job.dimensions && last.functionID == job.functionID
+               && last.minBound == job.minBound && last.maxBound == job.maxBound && last.alpha == job.alpha)
+            {
+                tasks.back().push_back(j);
+                continue;
+            }
+        }
+        tasks.push_back({j});
+        jobThreads = max(jobThreads, job.threads);
+    }
+
+    // Largest task first, ties in grid order.
+    vector<int> order(tasks.size());
+    vector<double> costs(tasks.size(), 0.0);
+    for(int t = 0; t < tasks.size(); t++)
+    {
+        order[t] = t;
+        for(int j : tasks[t])
+            costs[t] += estimateCost(jobs[j]);
+    }
+    stable_sort(order.begin(), order.end(), [&costs](int x, int y) { return costs[x] > costs[y]; });
+
+    int hardwareThreads = max((int)thread::hardware_concurrency(), 1);
+    int poolSize = min(max(hardwareThreads / jobThreads, 1), (int)tasks.size());
+    cout << "Sweep: " << jobs.size() << " jobs";
+    if(cache.isOpen())
+        cout << " (" << cachedJobs << " cached)";
+    cout << " on " << poolSize << " threads, seed " << seed << endl;
+
+    // Every thread takes the next task in line until there are none left.
+    atomic<size_t> nextTask(0);
+    auto worker = [&]() {
+        for(size_t next = nextTask++; next < order.size(); next = nextTask++)
+        {
+            vector<int> &task = tasks[order[next]];
+            if(task.size() > 1)
+                runLocalSearchBatch(jobs, task, bestFitness, elapsedTimeMS);
+            else
+                bestFitness[task[0]] = JobServer::runSearch(jobs[task[0]], elapsedTimeMS[task[0]]);
+
+            // Keep the results for the next sweep that repeats these jobs.
+            for(int j : task)
+            {
+                if(!cache.isOpen())
+                    break;
+                if(cacheKeys[j].empty())
+                    continue;
+                string value(2 * sizeof(double), '\0');
+                memcpy(&value[0], &bestFitness[j], sizeof(double));
+                memcpy(&value[sizeof(double)], &elapsedTimeMS[j], sizeof(double));
+                cache.store(cacheKeys[j], value);
+            }
+        }
+    };
+    vector<thread> pool;
+    for(int t = 1; t < poolSize; t++)
+        pool.emplace_back(worker);
+    worker();
+    for(int t = 0; t < pool.size(); t++)
+        pool[t].join();
+
+    // Save the results, one row per job.
+    ostringstream outputFile;
+    outputFile << "Dimensions,Function ID,Min Bound,Max Bound,Algorithm,Iterations,Alpha,Threads,Sampler,Trial,Seed,Best Fitness,Time(ms)\n";
+    for(int j = 0; j < jobs.size(); j++)
+    {
+        SearchJob &job = jobs[j];
+        outputFile << job.dimensions << "," << job.functionID << "," << job.minBound << "," << job.maxBound << ","
+                   << job.algorithm << "," << job.budget << "," << job.alpha << "," << job.threads << "," << Sampler::getTypeName(job.sampler) << ","
+                   << j % trials[0] << "," << job.seed << ",";
+        outputFile.precision(17);
+        outputFile << bestFitness[j];
+        outputFile.precision(6);
+        outputFile << "," << elapsedTimeMS[j] << "\n";
+    }
+
+    ofstream resultsFile(outputFilename);
+    resultsFile << outputFile.str();
+    resultsFile.close();
+    if(resultsFile.fail())
+    {
+        cout << "Failed to write file: " << outputFilename << endl;
+        return false;
+    }
+
+    cout << "Sweep results saved to " << outputFilename << endl;
+    return true;
+}
+
+/**
+ * @brief Returns the rough cost of a job, used to schedule the largest jobs first.
+ *
+ * The cost is the number of fitness evaluations the algorithm does with the
+ * job's budget, times the dimensions (the cost of one evaluation), shared
+ * between the job's threads. Only the order of the costs matters.
+ *
+ * @param job The job to estimate.
+ *
+ * @return The estimated cost.
+ */
+double ParameterSweep::estimateCost(SearchJob &job)
+{
+    double evaluations = (double)job.budget * DEFAULT_NUM_OF_VECTORS;
+    if(job.algorithm == ALG_LOCAL_SEARCH)
+        evaluations = (double)job.dimensions * DEFAULT_NUM_OF_VECTORS;
+    else if(job.algorithm == ALG_ITERATIVE_LOCAL_SEARCH)
+        evaluations = (double)job.budget * job.dimensions * DEFAULT_NUM_OF_VECTORS;
+    else if(job.algorithm == ALG_SIMULATED_ANNEALING)
+        evaluations = (double)job.budget * job.dimensions * SA_MOVES_PER_DIMENSION;
+    else if(job.algorithm == ALG_CMAES)
+        evaluations = (double)job.budget * CMAES_GENERATIONS_PER_ITERATION * (4 + 3 * log(job.dimensions));
+    else if(job.algorithm == ALG_GENETIC)
+        evaluations = (double)job.budget * GA_GENERATIONS_PER_ITERATION * DEFAULT_NUM_OF_VECTORS;
+    else if(job.algorithm == ALG_DECOMPOSITION)
+        evaluations = (double)job.budget * (DS_BLOCK_SCAN_POINTS + DS_REFINE_STEPS);   // Single terms, so a cycle costs about as much as this many full evaluations.
+    else if(job.algorithm == ALG_LBFGS)
+        evaluations = (double)job.budget * job.dimensions;     // A descent takes in the order of dimensions steps.
+
+    return evaluations * job.dimensions / max(job.threads, 1);
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PRIVATE FUNCTIONS BELOW -----------------
+// ----------------------------------------------------------
+/**
+ * @brief Reads the key = value lines of a sweep file.
+ *
+ * @note This function makes a call to utilities.h --> lineError().
+ *
+ * @param sweepFilename The sweep file.
+ *
+ * @return True if every line was understood, false otherwise.
+ */
+bool ParameterSweep::loadSpec(string sweepFilename)
+{
+    ifstream sweepFile;
+    sweepFile.open(sweepFilename);
+    if(sweepFile.fail())
+    {
+        cout << "Failed to open file: " << sweepFilename << endl;
+        return false;
+    }
+
+    string line, error;
+    for(int lineNumber = 1; getline(sweepFile, line); lineNumber++)
+    {
+        // Drop the comment, skip the line if nothing is left.
+        string_view text(line), key, value;
+        text = text.substr(0, text.find('#'));
+        if(text.find_first_not_of(" \t\r") == string_view::npos)
+            continue;
+
+        size_t equals = text.find('=');
+        string_view keyText = text.substr(0, equals);
+        if(equals == string_view::npos || !nextToken(keyText, " \t", key) || keyText.find_first_not_of(" \t") != string_view::npos)
+        {
+            cout << lineError(sweepFilename, lineNumber, "expected key = value") << endl;
+            return false;
+        }
+
+        // Trim the value (nextToken() would stop at its first comma).
+        value = text.substr(equals + 1);
+        size_t first = value.find_first_not_of(" \t\r");
+        value = first == string_view::npos ? string_view() : value.substr(first, value.find_last_not_of(" \t\r") - first + 1);
+
+        if(!parseKey(key, value, error))
+        {
+            cout << lineError(sweepFilename, lineNumber, error) << endl;
+            return false;
+        }
+    }
+    sweepFile.close();
+
+    return true;
+}
+
+/**
+ * @brief Turns a classic configuration file into a single-trial sweep.
+ *
+ * The dimensions and functions come from the configuration file, the
+ * iterations, alpha, cooling schedule and algorithms from the search
+ * configuration file. Every job may use all the hardware threads.
+ *
+ * @note This function makes a call to ProcessFunctions.h --> readSearchAlgorithmConfig().
+ *
+ * @param configFilename        The classic configuration file.
+ * @param searchConfigFilename  The search configuration file.
+ *
+ * @return True if both files were read, false otherwise.
+ */
+bool ParameterSweep::loadClassic(string configFilename, string searchConfigFilename)
+{
+    ifstream configFile;
+    configFile.open(configFilename);
+    if(configFile.fail())
+    {
+        cout << "Failed to open file: " << configFilename << endl;
+        return false;
+    }
+
+    // The first line holds the dimensions, every other line a function.
+    string line, error;
+    vector<double> vals;
+    getline(configFile, line);
+    if(!parseNumbers(line, ",", dimensions, error))
+    {
+        cout << lineError(configFilename, 1, error) << endl;
+        return false;
+    }
+    for(int lineNumber = 2; getline(configFile, line); lineNumber++)
+    {
+        if(!parseNumbers(line, ",", vals, error))
+        {
+            cout << lineError(configFilename, lineNumber, error) << endl;
+            return false;
+        }
+        if(vals.size() == 0)
+            continue;
+        prepForFunctionMatrix(vals);
+        functions.push_back(vals);
+    }
+    configFile.close();
+
+    ProcessFunctions procFuncs;
+    procFuncs.setSearchConfigFile(searchConfigFilename);
+    if(!procFuncs.readSearchAlgorithmConfig())
+        return false;
+
+    iterations.push_back(procFuncs.getSearchIterations());
+    alphas.push_back(procFuncs.getSearchAlpha());
+    coolingSchedule = procFuncs.getSearchCoolingSchedule();
+    crossoverType = procFuncs.getSearchCrossoverType();
+    algorithms = procFuncs.getSelectedAlgorithms();
+    threads.push_back(max((int)thread::hardware_concurrency(), 1));
+    return true;
+}
+
+/**
+ * @brief Applies one key = value line of a sweep file.
+ *
+ * @param key   The key, trimmed.
+ * @param value The value, trimmed.
+ * @param error Set to what is wrong with the line, if anything.
+ *
+ * @return True if the line was applied, false otherwise.
+ */
+bool ParameterSweep::parseKey(string_view key, string_view value, string &error)
+{
+    if(key == "dimensions")
+        return parseRanges(value, dimensions, error);
+    if(key == "alpha" || key == "alphas")
+        return parseRanges(value, alphas, error);
+    if(key == "iterations")
+        return parseRanges(value, iterations, error);
+    if(key == "threads")
+        return parseRanges(value, threads, error);
+
+    if(key == "function")
+    {
+        vector<double> vals;
+        if(!parseNumbers(value, ",", vals, error))
+            return false;
+        if(vals.size() < 3)
+        {
+            error = "expected function = functionID, minBound, maxBound";
+            return false;
+        }
+        prepForFunctionMatrix(vals);
+        functions.push_back(vals);
+        return true;
+    }
+
+    if(key == "trials")
+    {
+        trials.resize(1);
+        if(!parseNumber(value, trials[0]))
+            error = "expected a number of trials but found '" + string(value) + "'";
+        return error.empty();
+    }
+
+    if(key == "seed")
+    {
+        if(!parseNumber(value, seed))
+            error = "expected a seed but found '" + string(value) + "'";
+        return error.empty();
+    }
+
+    if(key == "cooling")
+    {
+        if(value == "exponential" || value == "1")
+            coolingSchedule = COOLING_EXPONENTIAL;
+        else if(value == "linear" || value == "2")
+            coolingSchedule = COOLING_LINEAR;
+        else if(value == "logarithmic" || value == "3")
+            coolingSchedule = COOLING_LOGARITHMIC;
+        else
+            error = "unknown cooling schedule '" + string(value) + "'";
+        return error.empty();
+    }
+
+    if(key == "crossover")
+    {
+        if(value == "blend" || value == "blx" || value == "1")
+            crossoverType = GA_CROSSOVER_BLEND;
+        else if(value == "sbx" || value == "2")
+            crossoverType = GA_CROSSOVER_SBX;
+        else
+            error = "unknown crossover '" + string(value) + "'";
+        return error.empty();
+    }
+
+    if(key == "algorithms")
+    {
+        string_view token;
+        while(nextToken(value, ",", token))
+        {
+            if(token == "all")
+                algorithms.insert(algorithms.end(), {ALG_BLIND_SEARCH, ALG_LOCAL_SEARCH, ALG_ITERATIVE_LOCAL_SEARCH,
+                                  ALG_PARTICLE_SWARM, ALG_SIMULATED_ANNEALING, ALG_CMAES, ALG_GENETIC, ALG_DECOMPOSITION, ALG_LBFGS});
+            else if(!token.empty())
+                algorithms.push_back(string(token));
+        }
+        return true;
+    }
+
+    if(key == "sampler")
+    {
+        samplerType = Sampler::parseType(string(value));
+        if(samplerType < 0)
+            error = "unknown sampler '" + string(value) + "'";
+        return error.empty();
+    }
+
+    if(key == "localsearch")
+    {
+        localSearchMode = parseLocalSearchMode(string(value));
+        if(localSearchMode < 0)
+            error = "unknown local search '" + string(value) + "'";
+        return error.empty();
+    }
+
+    if(key == "output")
+    {
+        outputFilename = string(value);
+        return true;
+    }
+
+    if(key == "cache")
+    {
+        cacheFilename = string(value);
+        return true;
+    }
+
+    error = "unknown key '" + string(key) + "'";
+    return false;
+}
+
+/**
+ * @brief Parses a list of numbers and start:end[:step] ranges.
+ *
+ * A range runs from start to end (included) in steps of step, 1 by default.
+ *
+ * @note This function makes a call to utilities.h --> nextToken() and parseNumber().
+ *
+ * @param value     The comma separated list.
+ * @param values    The numbers are appended to this vector.
+ * @param error     Set to what is wrong with the list, if anything.
+ *
+ * @return True if the whole list was parsed, false otherwise.
+ */
+bool ParameterSweep::parseRanges(string_view value, vector<double> &values, string &error)
+{
+    string_view item, bound;
+    while(nextToken(value, ",", item))
+    {
+        if(item.empty())
+            continue;
+
+        // Split the item into start, end and step.
+        double range[3] = {0, 0, 1};
+        int count = 0;
+        while(nextToken(item, ":", bound))
+        {
+            if(count == 3 || !parseNumber(bound, range[count]))
+            {
+                error = "expected a number or start:end[:step] but found '" + string(bound) + "'";
+                return false;
+            }
+            count++;
+        }
+
+        if(count == 1)
+            values.push_back(range[0]);
+        else if(count == 2 || count == 3)
+        {
+            if(!(range[2] > 0) || range[1] < range[0])
+            {
+                error = "a range needs start <= end and a step above 0";
+                return false;
+            }
+
+            // Count the steps up front, so rounding never adds or drops the end.
+            long long steps = (long long)floor((range[1] - range[0]) / range[2] + 1e-9);
+            for(long long s = 0; s <= steps; s++)
+                values.push_back(range[0] + s * range[2]);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Parses a list of integers and start:end[:step] ranges.
+ *
+ * @note This function makes a call to parseRanges() for doubles.
+ *
+ * @param value     The comma separated list.
+ * @param values    The integers are appended to this vector.
+ * @param error     Set to what is wrong with the list, if anything.
+ *
+ * @return True if the whole list was parsed and holds only integers, false otherwise.
+ */
+bool ParameterSweep::parseRanges(string_view value, vector<int> &values, string &error)
+{
+    vector<double> numbers;
+    if(!parseRanges(value, numbers, error))
+        return false;
+
+    for(int i = 0; i < numbers.size(); i++)
+    {
+        if(numbers[i] != floor(numbers[i]))
+        {
+            error = "expected whole numbers but found " + to_string(numbers[i]);
+            return false;
+        }
+        values.push_back((int)numbers[i]);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks the sweep is complete and every value is usable.
+ *
+ * @param error Set to what is wrong with the sweep, if anything.
+ *
+ * @return True if the sweep can run, false otherwise.
+ */
+bool ParameterSweep::validate(string &error)
+{
+    if(dimensions.size() == 0)
+        error = "no dimensions to sweep";
+    else if(functions.size() == 0)
+        error = "no functions to sweep";
+    else if(trials[0] < 1)
+        error = "trials must be at least 1";
+
+    for(int d = 0; error.empty() && d < dimensions.size(); d++)
+        if(dimensions[d] < 2)
+            error = "dimensions must be at least 2";
+    for(int f = 0; error.empty() && f < functions.size(); f++)
+    {
+        if(functions[f][0] != floor(functions[f][0]) || functions[f][0] < 1 || functions[f][0] > 18)
+            error = "function ID must be 1 - 18";
+        else if(!(functions[f][1] < functions[f][2]))
+            error = "minBound must be less than maxBound";
+    }
+    for(int i = 0; error.empty() && i < iterations.size(); i++)
+        if(iterations[i] < 1)
+            error = "iterations must be at least 1";
+    for(int t = 0; error.empty() && t < threads.size(); t++)
+        if(threads[t] < 1)
+            error = "threads must be at least 1";
+    for(int a = 0; error.empty() && a < algorithms.size(); a++)
+    {
+        string &algorithm = algorithms[a];
+        if(algorithm != ALG_BLIND_SEARCH && algorithm != ALG_LOCAL_SEARCH && algorithm != ALG_ITERATIVE_LOCAL_SEARCH &&
+           algorithm != ALG_PARTICLE_SWARM && algorithm != ALG_SIMULATED_ANNEALING && algorithm != ALG_CMAES &&
+           algorithm != ALG_GENETIC && algorithm != ALG_DECOMPOSITION && algorithm != ALG_LBFGS)
+            error = "unknown algorithm " + algorithm;
+    }
+
+    return error.empty();
+}
+
+/**
+ * @brief Runs the trials of a Local Search together, in lockstep.
+ *
+ * Each trial starts from the vector JobServer::runSearch() would start it
+ * from (its own seed), and localSearchBatch() makes the same descent from
+ * it, so every trial gets the same result as when it's run on its own. The
+ * batch is timed as a whole, and each trial is given an equal share.
+ *
+ * @note This function makes a call to SearchAlgorithms.h --> localSearchBatch().
+ *
+ * @param jobs Every job of the sweep.
+ * @param batch The jobs of the trials.
+ * @param bestFitness Where the best fitness of each job is stored.
+ * @param elapsedTimeMS Where the time of each job is stored.
+ */
+void ParameterSweep::runLocalSearchBatch(vector<SearchJob> &jobs, vector<int> &batch, vector<double> &bestFitness, vector<double> &elapsedTimeMS)
+{
+    SearchJob &first = jobs[batch[0]];
+    vector<vector<double>> starts;
+    for(int j : batch)
+    {
+        setRandomSeed(jobs[j].seed);
+        starts.push_back(createMatrix(1, first.dimensions, first.minBound, first.maxBound)[0]);
+    }
+
+    auto startTime = chrono::high_resolution_clock::now();
+    vector<double> fitnessList = localSearchBatch(starts, first.functionID, first.alpha);
+    auto endTime = chrono::high_resolution_clock::now();
+
+    double batchTimeMS = chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count();
+    for(int b = 0; b < batch.size(); b++)
+    {
+        bestFitness[batch[b]] = fitnessList[b];
+        elapsedTimeMS[batch[b]] = batchTimeMS / batch.size();
+    }
+}
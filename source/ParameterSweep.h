@@ -0,0 +1,75 @@
+/**
+ * @file ParameterSweep.h
+ * @author  Al Timofeyev
+ * @date    May 14, 2019
+ * @brief   Expands a sweep specification (lists and ranges of dimensions,
+ *          functions, alphas, iteration budgets, trials, thread counts and
+ *          algorithms) into a list of search jobs, and runs them on a pool
+ *          of threads, largest job first.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_PARAMETERSWEEP_H
+#define BENCHMARKFUNCTIONS2_PARAMETERSWEEP_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <cstring>
+#include "JobServer.h"
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** The number of iterations of a sweep that doesn't list any. */
+#define SWEEP_DEFAULT_ITERATIONS 30
+/** Appended to the name of the sweep file to name its results file. */
+#define SWEEP_RESULTS_SUFFIX "-SweepResults.csv"
+
+class ParameterSweep{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    ParameterSweep();
+
+    // --------------------- Functions Declarations ---------------------
+    bool load(string sweepFilename, string searchConfigFilename);   /**< Reads a sweep file, or a classic configuration file and its search configuration file.*/
+    vector<SearchJob> expand();                                     /**< Returns every job of the sweep, in grid order.*/
+    bool run();                                                     /**< Runs every job of the sweep and saves the results.*/
+
+    static double estimateCost(SearchJob &job);                     /**< Returns the rough cost of a job, used to schedule the largest jobs first.*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    vector<int> dimensions;
+    vector<vector<double>> functions;   /**< functionID, minBound, maxBound of each function.*/
+    vector<double> alphas;
+    vector<int> iterations;
+    vector<int> trials;                 /**< Always a single value, the number of trials of every combination.*/
+    vector<int> threads;
+    vector<string> algorithms;
+    int coolingSchedule;
+    int crossoverType;
+    int samplerType;
+    int localSearchMode;
+    unsigned int seed;
+    string outputFilename;
+    string cacheFilename;               /**< The result cache of the jobs, or empty for none.*/
+
+    // --------------------- Functions Declarations ---------------------
+    bool loadSpec(string sweepFilename);                                            /**< Reads the key = value lines of a sweep file.*/
+    bool loadClassic(string configFilename, string searchConfigFilename);           /**< Turns a classic configuration file into a single-trial sweep.*/
+    bool parseKey(string_view key, string_view value, string &error);               /**< Applies one key = value line of a sweep file.*/
+    bool parseRanges(string_view value, vector<double> &values, string &error);     /**< Parses a list of numbers and start:end[:step] ranges.*/
+    bool parseRanges(string_view value, vector<int> &values, string &error);        /**< Parses a list of integers and start:end[:step] ranges.*/
+    bool validate(string &error);                                                   /**< Checks the sweep is complete and every value is usable.*/
+    void runLocalSearchBatch(vector<SearchJob> &jobs, vector<int> &batch, vector<double> &bestFitness, vector<double> &elapsedTimeMS);  /**< Runs the trials of a Local Search together, in lockstep.*/
+};
+
+
+#endif //BENCHMARKFUNCTIONS2_PARAMETERSWEEP_H
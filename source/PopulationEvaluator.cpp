@@ -0,0 +1,183 @@
+/**
+ * @file PopulationEvaluator.cpp
+ * @class PopulationEvaluator PopulationEvaluator.h "PopulationEvaluator.h"
+ * @author  Al Timofeyev
+ * @date    May 20, 2019
+ * @brief   Evaluates the flat populations of the population based searches
+ *          (PSO, CMA-ES and GA) on a set of threads that is started once per
+ *          run and reused by every generation.
+ *
+ * A population is stored row-major in one contiguous vector, so row r
+ * occupies population[r*columns] to population[(r+1)*columns - 1]. The rows
+ * are split into equal chunks, one per thread, and each thread copies its
+ * rows into its own scratch row before evaluating them, so every row gets
+ * the fitness calculateFitnessOfVector() gives it, whatever the number of
+ * threads.
+ *
+ * The workers and their scratch rows are created once, when the evaluator
+ * is, and wait on a condition variable between generations, so a
+ * generation's evaluation neither starts threads nor allocates memory. Each
+ * worker is placed by the thread placement policy (see WorkerPlacement)
+ * before it creates its scratch row, and the calling thread, worker 0, keeps
+ * its placement until the evaluator is destroyed. The workers consult the
+ * fitness memo of the thread that created the evaluator.
+ */
+
+#include "PopulationEvaluator.h"
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief The constructor for the PopulationEvaluator class, starts the workers.
+ *
+ * @note Must be destroyed by the thread that created it, which is worker 0.
+ *
+ * @param numThreads The number of threads used to evaluate a population, the calling thread included.
+ * @param rows The number of vectors in the populations (never more threads than that).
+ * @param columns The number of elements in each vector of the populations.
+ */
+PopulationEvaluator::PopulationEvaluator(int numThreads, int rows, int columns)
+{
+    this->numThreads = max(1, min(numThreads, rows));
+    this->columns = columns;
+    memo = getFitnessMemo();
+    generation = 0;
+    pendingWorkers = 0;
+    isStopping = false;
+    population = fitnessList = nullptr;
+    this->rows = functionID = firstRow = chunkSize = 0;
+
+    // Place the calling thread before it creates its scratch row.
+    callerPlacement.reset(new WorkerPlacement(0));
+    callerRow.resize(columns);
+
+    for(int t = 1; t < this->numThreads; t++)
+        workers.emplace_back(&PopulationEvaluator::workerLoop, this, t);
+}
+
+/**
+ * @brief The destructor for the PopulationEvaluator class, stops the workers and restores the calling thread's placement.
+ */
+PopulationEvaluator::~PopulationEvaluator()
+{
+    {
+        lock_guard<mutex> lock(evaluatorLock);
+        isStopping = true;
+    }
+    startSignal.notify_all();
+    for(int t = 0; t < workers.size(); t++)
+        workers[t].join();
+    callerPlacement.reset();
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PUBLIC FUNCTIONS BELOW ------------------
+// ----------------------------------------------------------
+/**
+ * @brief Calculates the fitness of the rows of a flat population.
+ *
+ * Rows before firstRow are skipped, their fitness is left untouched.
+ *
+ * @note This function makes a call to utilities.h --> calculateFitnessOfVector().
+ *
+ * @param population The flat row-major population of vectors.
+ * @param fitnessList The list where the fitness of each row is stored (resized to rows).
+ * @param rows The number of vectors in the population.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param firstRow The first row to evaluate (0 evaluates the whole population).
+ */
+void PopulationEvaluator::evaluate(vector<double> &population, vector<double> &fitnessList, int rows, int functionID, int firstRow)
+{
+    // Make sure there is room for every fitness value.
+    fitnessList.resize(rows);
+    if(rows <= firstRow)
+        return;
+
+    // Never use more threads than there are rows to evaluate.
+    int activeThreads = max(1, min(numThreads, rows - firstRow));
+    int chunk = (rows - firstRow + activeThreads - 1) / activeThreads;
+
+    // Single threaded evaluation doesn't need to wake anything.
+    if(workers.empty())
+    {
+        this->population = &population;
+        this->fitnessList = &fitnessList;
+        this->rows = rows;
+        this->functionID = functionID;
+        this->firstRow = firstRow;
+        chunkSize = chunk;
+        evaluateChunk(0, callerRow);
+        return;
+    }
+
+    // Hand the population to the workers, evaluate the first chunk, and wait for the others.
+    {
+        lock_guard<mutex> lock(evaluatorLock);
+        this->population = &population;
+        this->fitnessList = &fitnessList;
+        this->rows = rows;
+        this->functionID = functionID;
+        this->firstRow = firstRow;
+        chunkSize = chunk;
+        pendingWorkers = workers.size();
+        generation++;
+    }
+    startSignal.notify_all();
+
+    evaluateChunk(0, callerRow);
+
+    unique_lock<mutex> lock(evaluatorLock);
+    doneSignal.wait(lock, [this]() { return pendingWorkers == 0; });
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PRIVATE FUNCTIONS BELOW -----------------
+// ----------------------------------------------------------
+/**
+ * @brief Evaluates the worker's chunk of every generation, until the evaluator is destroyed.
+ * @param worker The number of the worker, from 1.
+ */
+void PopulationEvaluator::workerLoop(int worker)
+{
+    // Place the worker before it creates its scratch row, so the row is on its node.
+    WorkerPlacement placement(worker);
+    FitnessMemoScope memoScope(memo);
+    vector<double> vect(columns);
+
+    long long seenGeneration = 0;
+    while(true)
+    {
+        {
+            unique_lock<mutex> lock(evaluatorLock);
+            startSignal.wait(lock, [&]() { return isStopping || generation != seenGeneration; });
+            if(isStopping)
+                return;
+            seenGeneration = generation;
+        }
+
+        evaluateChunk(worker, vect);
+
+        lock_guard<mutex> lock(evaluatorLock);
+        if(--pendingWorkers == 0)
+            doneSignal.notify_one();
+    }
+}
+
+/**
+ * @brief Evaluates the rows of one worker's chunk of the current population.
+ * @param worker The number of the worker, from 0.
+ * @param vect The worker's scratch row.
+ */
+void PopulationEvaluator::evaluateChunk(int worker, vector<double> &vect)
+{
+    int chunkStart = firstRow + worker * chunkSize;
+    int chunkEnd = min(chunkStart + chunkSize, rows);
+    for(int row = chunkStart; row < chunkEnd; row++)
+    {
+        copy(population->begin() + (long)row * columns, population->begin() + (long)(row + 1) * columns, vect.begin());
+        (*fitnessList)[row] = calculateFitnessOfVector(vect, functionID);
+    }
+}
@@ -0,0 +1,61 @@
+/**
+ * @file PopulationEvaluator.h
+ * @author  Al Timofeyev
+ * @date    May 20, 2019
+ * @brief   Evaluates the flat populations of the population based searches
+ *          (PSO, CMA-ES and GA) on a set of threads that is started once per
+ *          run and reused by every generation.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_POPULATIONEVALUATOR_H
+#define BENCHMARKFUNCTIONS2_POPULATIONEVALUATOR_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <algorithm>
+#include "utilities.h"
+#include "FitnessMemo.h"
+#include "Topology.h"
+
+using namespace std;
+
+class PopulationEvaluator{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    PopulationEvaluator(int numThreads, int rows, int columns);     // Starts the workers, the calling thread is worker 0.
+    ~PopulationEvaluator();                                         // Stops the workers and waits for them.
+
+    // --------------------- Functions Declarations ---------------------
+    void evaluate(vector<double> &population, vector<double> &fitnessList, int rows, int functionID, int firstRow = 0);  /**< Calculates the fitness of the rows of a flat population.*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    int numThreads;
+    int columns;
+    vector<thread> workers;
+    vector<double> callerRow;                       /**< The scratch row of the calling thread (the workers keep their own).*/
+    unique_ptr<WorkerPlacement> callerPlacement;    /**< Where the calling thread runs while the evaluator lives.*/
+    FitnessMemo *memo;                              /**< The fitness memo of the calling thread, the workers consult it too.*/
+
+    mutex evaluatorLock;
+    condition_variable startSignal;
+    condition_variable doneSignal;
+    long long generation;       /**< Counts the calls to evaluate(), a worker starts when it changes.*/
+    int pendingWorkers;         /**< The workers that haven't finished their chunk of this generation.*/
+    bool isStopping;
+
+    // The population being evaluated, and the chunk of rows of every worker.
+    vector<double> *population;
+    vector<double> *fitnessList;
+    int rows, functionID, firstRow, chunkSize;
+
+    // --------------------- Functions Declarations ---------------------
+    void workerLoop(int worker);                                /**< Evaluates the worker's chunk of every generation.*/
+    void evaluateChunk(int worker, vector<double> &vect);       /**< Evaluates the rows of one worker's chunk.*/
+};
+
+
+#endif //BENCHMARKFUNCTIONS2_POPULATIONEVALUATOR_H
@@ -10,17 +10,130 @@
 #include "FilenameConstants.h"
 #include "ProcessFunctions.h"
 
+// ----------------------------------------------
+// ------------- CHECKPOINT HELPERS -------------
+// ----------------------------------------------
+/** Writes a value to a binary file (or string stream) as its raw bytes. */
+template <typename T>
+static void writeBinary(ostream &file, const T &value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/** Writes a list of doubles to a binary file, preceded by its size. */
+static void writeBinary(ostream &file, const vector<double> &values)
+{
+    writeBinary(file, (unsigned int)values.size());
+    file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+}
+
+/** Reads a value written by writeBinary(), returns false at the end of the file. */
+template <typename T>
+static bool readBinary(istream &file, T &value)
+{
+    return (bool)file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+/** Reads a list of doubles written by writeBinary(), returns false at the end of the file. */
+static bool readBinary(istream &file, vector<double> &values)
+{
+    unsigned int size;
+    if(!readBinary(file, size))
+        return false;
+    values.resize(size);
+    return (bool)file.read(reinterpret_cast<char*>(values.data()), size * sizeof(double));
+}
+
+/** Writes the results of all the search algorithms on one function to a binary file. */
+static void writeBinary(ostream &file, const SearchAlgorithmResults &results)
+{
+    writeBinary(file, results.functionID);
+    writeBinary(file, results.fitnessBS);
+    writeBinary(file, results.timeBS);
+    writeBinary(file, results.fitnessLS);
+    writeBinary(file, results.timeLS);
+    writeBinary(file, results.evalsPerSecLS);
+    writeBinary(file, results.evaluationsLS);
+    writeBinary(file, results.fitnessILS);
+    writeBinary(file, results.timeILS);
+    writeBinary(file, results.evalsPerSecILS);
+    writeBinary(file, results.evaluationsILS);
+    writeBinary(file, results.fitnessPSO);
+    writeBinary(file, results.timePSO);
+    writeBinary(file, results.evalsPerSecPSO);
+    writeBinary(file, results.fitnessSA);
+    writeBinary(file, results.timeSA);
+    writeBinary(file, results.evalsPerSecSA);
+    writeBinary(file, results.fitnessCMAES);
+    writeBinary(file, results.timeCMAES);
+    writeBinary(file, results.evalsPerSecCMAES);
+    writeBinary(file, results.fitnessGA);
+    writeBinary(file, results.timeGA);
+    writeBinary(file, results.evalsPerSecGA);
+    writeBinary(file, results.fitnessDS);
+    writeBinary(file, results.timeDS);
+    writeBinary(file, results.evalsPerSecDS);
+    writeBinary(file, results.fitnessLBFGS);
+    writeBinary(file, results.timeLBFGS);
+    writeBinary(file, results.evalsPerSecLBFGS);
+}
+
+/** Reads the results written by writeBinary(), returns false at the end of the file. */
+static bool readBinary(istream &file, SearchAlgorithmResults &results)
+{
+    return readBinary(file, results.functionID) &&
+           readBinary(file, results.fitnessBS) && readBinary(file, results.timeBS) &&
+           readBinary(file, results.fitnessLS) && readBinary(file, results.timeLS) &&
+           readBinary(file, results.evalsPerSecLS) && readBinary(file, results.evaluationsLS) &&
+           readBinary(file, results.fitnessILS) && readBinary(file, results.timeILS) &&
+           readBinary(file, results.evalsPerSecILS) && readBinary(file, results.evaluationsILS) &&
+           readBinary(file, results.fitnessPSO) && readBinary(file, results.timePSO) && readBinary(file, results.evalsPerSecPSO) &&
+           readBinary(file, results.fitnessSA) && readBinary(file, results.timeSA) && readBinary(file, results.evalsPerSecSA) &&
+           readBinary(file, results.fitnessCMAES) && readBinary(file, results.timeCMAES) && readBinary(file, results.evalsPerSecCMAES) &&
+           readBinary(file, results.fitnessGA) && readBinary(file, results.timeGA) && readBinary(file, results.evalsPerSecGA) &&
+           readBinary(file, results.fitnessDS) && readBinary(file, results.timeDS) && readBinary(file, results.evalsPerSecDS) &&
+           readBinary(file, results.fitnessLBFGS) && readBinary(file, results.timeLBFGS) && readBinary(file, results.evalsPerSecLBFGS);
+}
+
+/** Returns the hash of every element of a matrix, in order. */
+static uint64_t hashMatrix(const vector<vector<double>> &matrix)
+{
+    uint64_t hash = ResultCache::hashBytes(nullptr, 0);
+    for(int row = 0; row < matrix.size(); row++)
+        hash = ResultCache::hashBytes(matrix[row].data(), matrix[row].size() * sizeof(double), hash);
+    return hash;
+}
+
 // ----------------------------------------------
 // ---------------- CONSTRUCTORS ----------------
 // ----------------------------------------------
 /**
  * @brief The default constructor for the ProcessFunctions class.
- * The default constructor only initializes the numOfDimensions
- * variable to 0;
+ * The default constructor initializes the numOfDimensions
+ * variable to 0, and the numOfThreads variable to the number
+ * of hardware threads (or 1 if that can't be determined).
  */
 ProcessFunctions::ProcessFunctions()
 {
     numOfDimensions = 0;
+    setNumOfThreads(thread::hardware_concurrency());
+
+    isSeeded = false;
+    runSeed = 0;
+    restoredDimensions = 0;
+    outputWriter = NULL;
+    resultCache = NULL;
+    samplerType = SAMPLER_RANDOM;
+    localSearchMode = LS_MODE_FIXED;
+    termTableInterpolation = TERM_TABLE_OFF;
+    termTableError = TERM_TABLE_DEFAULT_ERROR;
+    memoCapacity = 0;
+    memoQuantum = 0;
+    searchConfigFilename = "SearchAlgorithmConfig.txt";
+    searchIterations = 0;
+    searchAlpha = 0;
+    searchCoolingSchedule = COOLING_EXPONENTIAL;
+    searchCrossoverType = GA_CROSSOVER_SBX;
 }
 
 // -------------------------------------------------------------------------------------------
@@ -55,6 +168,26 @@ int ProcessFunctions::getNumOfDimensions()
     return numOfDimensions;
 }
 
+/**
+ * @brief Sets the number of threads used by the multithreaded search algorithms.
+ * @param threads The number of threads to use. Values less than 1 are set to 1.
+ */
+void ProcessFunctions::setNumOfThreads(int threads)
+{
+    if(threads < 1)
+        threads = 1;
+    numOfThreads = threads;
+}
+
+/**
+ * @brief Returns the number of threads used by the multithreaded search algorithms.
+ * @return The value stored in the numOfThreads variable.
+ */
+int ProcessFunctions::getNumOfThreads()
+{
+    return numOfThreads;
+}
+
 /**
  * @brief Generates a matrix using Mersenne Twister.
  *
@@ -70,7 +203,7 @@ void ProcessFunctions::constructMatrix()
 
     // Create a Mersenne Twister pseudo-random number generator.
     // Generate a random function ID.
-    mt19937 randGenerator(time(NULL));
+    mt19937 randGenerator(nextRandomSeed());
     uniform_int_distribution<int> dis(1, 18);
     int funcID = dis(randGenerator);
 
@@ -95,25 +228,14 @@ void ProcessFunctions::constructMatrix()
  */
 void ProcessFunctions::constructMatrix(int funcID, double minBoundary, double maxBoundary)
 {
-    // If the function ID is out of range, notify user of Function IDs and exit.
-    if(funcID < 1 || funcID > 18)
-    {
-        cout <<"\n******* ";
-        cout << "Cannot generate matrix for Function ID " << funcID;
-        cout <<" *******";
-        printAllFunctionIDs();
-        return;
-    }
-
     // If the number of dimensions is 0, set it to the default value.
     if(numOfDimensions == 0)
         setNumOfDimensions(DEFAULT_NUM_OF_DIMENSIONS);
 
     // Construct a matrix with user-provided boundaries.
-    FunctionData funcData = generateMatrix(minBoundary, maxBoundary);
-    funcData.functionID = funcID;
-    funcData.minBound = minBoundary;
-    funcData.maxBound = maxBoundary;
+    FunctionData funcData;
+    if(!generateFunctionMatrix(funcID, minBoundary, maxBoundary, resultsOfFunctions.size(), funcData))
+        return;
 
     // Save the constructed matrix to resultsOfFunctions vector.
     resultsOfFunctions.push_back(funcData);
@@ -125,22 +247,7 @@ void ProcessFunctions::constructMatrix(int funcID, double minBoundary, double ma
 void ProcessFunctions::calculateFitnessOfAllMatrices()
 {
     for(int numOfData = 0; numOfData < resultsOfFunctions.size(); numOfData++)
-    {
-        // Record the start and end time of executing the benchmark function on matrix.
-        auto startTime = chrono::high_resolution_clock::now();
-        calculateMatrixFitness(resultsOfFunctions[numOfData]);
-        auto endTime = chrono::high_resolution_clock::now();
-
-        // Calculate elapsed time in milliseconds it took to execute the benchmark function.
-        auto elapsedTime = endTime - startTime;
-        double elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
-
-        // Save elapsed time to the FunctionData struct.
-        resultsOfFunctions[numOfData].timeToExecute = elapsedTimeMS;
-
-        // Sort the results by fitness.
-        quicksortFuncData(resultsOfFunctions[numOfData], 0, resultsOfFunctions[numOfData].fitness.size()-1);
-    }
+        evaluateMatrix(resultsOfFunctions[numOfData]);
 }
 
 /**
@@ -154,17 +261,55 @@ void ProcessFunctions::analyzeAllFunctionResults()
 
 /**
  * @brief Performs all search algorithms for each FunctionData structure in resultsOfFunctions.
- *
- * @note This function makes a call to utilities.h --> quicksort().
  */
 void ProcessFunctions::performAllSearchAlgorithms()
+{
+    // Read the iterations, alpha value, cooling schedule and algorithms to run.
+    if(!readSearchAlgorithmConfig())
+        return;
+
+    // Perform the search algorithms on all FunctionData structs in resultsOfFunctions.
+    for(int numOfData = 0; numOfData < resultsOfFunctions.size(); numOfData++)
+    {
+        // Add the search algorithm results to the searchAlgResults vector.
+        searchAlgResults.push_back(performSearchAlgorithms(resultsOfFunctions[numOfData], numOfData));
+
+        // Save the finished work.
+        if(checkpointFilename.size() > 0)
+            saveCheckpoint();
+    }
+}
+
+/**
+ * @brief Sets the Search Algorithm configuration file (SearchAlgorithmConfig.txt by default).
+ * @param filename The Search Algorithm configuration file.
+ */
+void ProcessFunctions::setSearchConfigFile(string filename)
+{
+    searchConfigFilename = filename;
+}
+
+/**
+ * @brief Reads the Search Algorithm configuration file.
+ *
+ * The file is SearchAlgorithmConfig.txt, in the working directory, unless
+ * another one was set with setSearchConfigFile().
+ *
+ * The first two lines are the number of iterations and the alpha value, the
+ * optional third line the Simulated Annealing cooling schedule, the
+ * optional fourth line the comma separated list of algorithms to run, and
+ * the optional fifth line the Genetic Algorithm crossover.
+ *
+ * @return True if the file was read, false otherwise.
+ */
+bool ProcessFunctions::readSearchAlgorithmConfig()
 {
     // Open the Search Algorithm configuration text file.
     ifstream configFile;
-    configFile.open("SearchAlgorithmConfig.txt");
+    configFile.open(searchConfigFilename);
     if(configFile.fail())
     {
-        cout << "Failed to open file: SearchAlgorithmConfig.txt" << endl;
+        cout << "Failed to open file: " << searchConfigFilename << endl;
         cout << "---------------------------------------\n";
         cout << "File is either not in the right directory\n";
         cout << "or does not exist.\n";
@@ -172,83 +317,201 @@ void ProcessFunctions::performAllSearchAlgorithms()
         cout << "Accepted File Formats: .txt" << endl;
         cout << "---------------------------------------\n";
         cout << "**** Terminating Program Execution ****\n\n";
-        return;
+        return false;
     }
     // Retrieve all necessary variable from Search Algorithm configuration file.
-    // Only two lines in file: number of iterations and alpha value.
+    // First two lines in file: number of iterations and alpha value.
     string line;
+    string_view token;
     getline(configFile, line);
-    int iterations = stoi(line);
+    string_view text = line;
+    if(!nextToken(text, " ", token) || !parseNumber(token, searchIterations))
+    {
+        cout << lineError(searchConfigFilename, 1, "expected the number of iterations") << endl;
+        return false;
+    }
     getline(configFile, line);
-    double alpha = stod(line);
+    text = line;
+    if(!nextToken(text, " ", token) || !parseNumber(token, searchAlpha))
+    {
+        cout << lineError(searchConfigFilename, 2, "expected the alpha value") << endl;
+        return false;
+    }
 
-    // Declare variables for search algorithms.
-    vector<double> bestVect;
-    double bestFitness;
-    int functionID;
-    double minBound, maxBound;
-    int rows = DEFAULT_NUM_OF_VECTORS, columns = numOfDimensions;
+    // Optional third line: the Simulated Annealing cooling schedule.
+    searchCoolingSchedule = COOLING_EXPONENTIAL;
+    if(getline(configFile, line))
+    {
+        text = line;
+        if(nextToken(text, " ", token) && !parseNumber(token, searchCoolingSchedule))
+        {
+            cout << lineError(searchConfigFilename, 3, "expected the cooling schedule") << endl;
+            return false;
+        }
+    }
 
-    // Perform the search algorithms on all FunctionData structs in resultsOfFunctions.
-    for(int numOfData = 0; numOfData < resultsOfFunctions.size(); numOfData++)
+    // Optional fourth line: the comma separated list of algorithms to run (all if missing).
+    selectedAlgorithms.resize(0);
+    if(getline(configFile, line))
+        selectedAlgorithms = parseStringStr(line, ", \r");
+
+    // Optional fifth line: the Genetic Algorithm crossover.
+    searchCrossoverType = GA_CROSSOVER_SBX;
+    if(getline(configFile, line))
     {
-        // Assign variables for search algorithms.
-        functionID = resultsOfFunctions[numOfData].functionID;
-        bestVect = resultsOfFunctions[numOfData].functionMatrix[0];
-        bestFitness = resultsOfFunctions[numOfData].fitness[0];
-        minBound = resultsOfFunctions[numOfData].minBound;
-        maxBound = resultsOfFunctions[numOfData].maxBound;
-
-        // Declare a SearchAlgorithmResults variable.
-        SearchAlgorithmResults algResults;
-        algResults.functionID = functionID;
-
-        // ------------------------------------------------------------------------------
-        // ---------- BLIND SEARCH ----------
-        // Record the start and end time.
-        auto startTime = chrono::high_resolution_clock::now();
-        algResults.fitnessBS = blindSearch(iterations, bestVect, bestFitness, functionID, rows, columns, minBound, maxBound);
-        auto endTime = chrono::high_resolution_clock::now();
+        text = line;
+        if(nextToken(text, " \r", token) && (!parseNumber(token, searchCrossoverType) ||
+           (searchCrossoverType != GA_CROSSOVER_BLEND && searchCrossoverType != GA_CROSSOVER_SBX)))
+        {
+            cout << lineError(searchConfigFilename, 5, "expected the crossover (1 = blend, 2 = SBX)") << endl;
+            return false;
+        }
+    }
 
-        // Calculate elapsed time in milliseconds.
-        auto elapsedTime = endTime - startTime;
-        double elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
-        algResults.timeBS = elapsedTimeMS;
+    return true;
+}
 
-        // ------------------------------------------------------------------------------
-        // ---------- LOCAL SEARCH ----------
-        // Record the start and end time.
-        startTime = chrono::high_resolution_clock::now();
-        algResults.fitnessLS = localSearch(bestVect, functionID, alpha);
-        endTime = chrono::high_resolution_clock::now();
+/**
+ * @brief Returns the number of iterations read from the Search Algorithm configuration file.
+ * @return The value stored in the searchIterations variable.
+ */
+int ProcessFunctions::getSearchIterations()
+{
+    return searchIterations;
+}
 
-        // Calculate elapsed time in milliseconds.
-        elapsedTime = endTime - startTime;
-        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
-        algResults.timeLS = elapsedTimeMS;
+/**
+ * @brief Returns the alpha value read from the Search Algorithm configuration file.
+ * @return The value stored in the searchAlpha variable.
+ */
+double ProcessFunctions::getSearchAlpha()
+{
+    return searchAlpha;
+}
 
-        // ------------------------------------------------------------------------------
-        // ----- ITERATIVE LOCAL SEARCH -----
-        // Record the start and end time.
-        startTime = chrono::high_resolution_clock::now();
-        algResults.fitnessILS = iterativeLocalSearch(iterations, bestVect, functionID, alpha);
-        endTime = chrono::high_resolution_clock::now();
+/**
+ * @brief Returns the cooling schedule read from the Search Algorithm configuration file.
+ * @return The value stored in the searchCoolingSchedule variable.
+ */
+int ProcessFunctions::getSearchCoolingSchedule()
+{
+    return searchCoolingSchedule;
+}
 
-        // Sort the resulting list of fitness values.
-        quicksort(algResults.fitnessILS, 0, algResults.fitnessILS.size()-1);
+/**
+ * @brief Returns the Genetic Algorithm crossover read from the Search Algorithm configuration file.
+ * @return The value stored in the searchCrossoverType variable.
+ */
+int ProcessFunctions::getSearchCrossoverType()
+{
+    return searchCrossoverType;
+}
 
-        // Calculate elapsed time in milliseconds.
-        elapsedTime = endTime - startTime;
-        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
-        algResults.timeILS = elapsedTimeMS;
+/**
+ * @brief Returns the algorithms selected to run.
+ * @return The list of algorithm names, empty if all of them are selected.
+ */
+vector<string> ProcessFunctions::getSelectedAlgorithms()
+{
+    return selectedAlgorithms;
+}
 
-        // Add the search algorithm results to the searchAlgResults vector.
-        searchAlgResults.push_back(algResults);
+/**
+ * @brief Generates, evaluates, analyzes, searches and saves every function as a pipeline.
+ *
+ * Does the same work as constructMatrix(), calculateFitnessOfAllMatrices(),
+ * analyzeAllFunctionResults() and performAllSearchAlgorithms() (and, if asked,
+ * saveAllProcessedFunctionDataToFile()), but each function moves on to the
+ * next stage as soon as it's ready instead of waiting for all the others:
+ *      generate matrix --> evaluate and analyze --> search --> save
+ * Every stage runs on its own thread and the stages are connected by bounded
+ * queues, so the next matrices are generated and evaluated (and the last one
+ * saved) while a function is being searched, and only a few functions are in
+ * flight at any time. A function's matrix is freed once it's saved, so
+ * resultsOfFunctions stays empty; the analysis and the search algorithm
+ * results are the same as those of the separate steps.
+ *
+ * @param functionSetups The function ID, min and max bound of every function, in configuration file order.
+ * @param configFilename The configuration file from which the functions were read.
+ * @param saveFunctionData If true, the matrix and fitness of every function is saved to its file.
+ */
+void ProcessFunctions::processAllFunctionsPipelined(vector<vector<double>> &functionSetups, string configFilename, bool saveFunctionData)
+{
+    // Read the iterations, alpha value, cooling schedule and algorithms to run.
+    if(!readSearchAlgorithmConfig())
+        return;
+
+    // If the number of dimensions is 0, set it to the default value.
+    if(numOfDimensions == 0)
+        setNumOfDimensions(DEFAULT_NUM_OF_DIMENSIONS);
+
+    BoundedQueue<PipelineItem> evaluateQueue(PIPELINE_QUEUE_CAPACITY);
+    BoundedQueue<PipelineItem> searchQueue(PIPELINE_QUEUE_CAPACITY);
+    BoundedQueue<PipelineItem> saveQueue(PIPELINE_QUEUE_CAPACITY);
+
+    // Stage 1: generate the matrix of every valid function.
+    thread generator([&]()
+    {
+        int functionIndex = 0;
+        for(int i = 0; i < functionSetups.size(); i++)
+        {
+            PipelineItem item;
+            if(!generateFunctionMatrix(functionSetups[i][0], functionSetups[i][1], functionSetups[i][2], functionIndex, item.data))
+                continue;
+            item.functionIndex = functionIndex++;
+            evaluateQueue.push(item);
+        }
+        evaluateQueue.close();
+    });
+
+    // Stage 2: calculate and sort the fitness of the matrix, and analyze it.
+    thread evaluator([&]()
+    {
+        PipelineItem item;
+        while(evaluateQueue.pop(item))
+        {
+            // Calculate and sort the fitness, and analyze it.
+            evaluateMatrix(item.data);
+            analyzeFunctionResults(item.data);
+            searchQueue.push(item);
+        }
+        searchQueue.close();
+    });
+
+    // Stage 4: save the results (and the function data), then free the matrix.
+    thread saver([&]()
+    {
+        PipelineItem item;
+        while(saveQueue.pop(item))
+        {
+            if(saveFunctionData)
+                saveProcessedFunctionDataToFile(configFilename, item.data);
+
+            searchAlgResults.push_back(item.results);
+            if(checkpointFilename.size() > 0)
+                saveCheckpoint();
+        }
+    });
+
+    // Stage 3, on this thread: perform the search algorithms.
+    PipelineItem item;
+    while(searchQueue.pop(item))
+    {
+        item.results = performSearchAlgorithms(item.data, item.functionIndex);
+        saveQueue.push(item);
     }
+    saveQueue.close();
+
+    // Wait for the other stages to finish.
+    generator.join();
+    evaluator.join();
+    saver.join();
 }
 
 /**
  * @brief Analyzes all the results from the search algorithms.
+ *
+ * @note Only the algorithms selected in SearchAlgorithmConfig.txt are analyzed.
  */
 void ProcessFunctions::analyzeAllSearchAlgorithmResults()
 {
@@ -258,36 +521,145 @@ void ProcessFunctions::analyzeAllSearchAlgorithmResults()
         searchAlgAnalysis.functionIDs.push_back(searchAlgResults[numOfData].functionID);
 
         // Save Blind Search Data.
-        searchAlgAnalysis.avgBSFitness.push_back(searchAlgResults[numOfData].fitnessBS);
-        searchAlgAnalysis.standardDeviationBS.push_back(searchAlgResults[numOfData].fitnessBS);
-        vector<double> rangeBS;
-        rangeBS.push_back(searchAlgResults[numOfData].fitnessBS);
-        rangeBS.push_back(searchAlgResults[numOfData].fitnessBS);
-        searchAlgAnalysis.rangesBS.push_back(rangeBS);
-        searchAlgAnalysis.medianBSFitness.push_back(searchAlgResults[numOfData].fitnessBS);
-        searchAlgAnalysis.processTimesBS.push_back(searchAlgResults[numOfData].timeBS);
+        if(isAlgorithmSelected(ALG_BLIND_SEARCH))
+        {
+            searchAlgAnalysis.avgBSFitness.push_back(searchAlgResults[numOfData].fitnessBS);
+            searchAlgAnalysis.standardDeviationBS.push_back(searchAlgResults[numOfData].fitnessBS);
+            vector<double> rangeBS;
+            rangeBS.push_back(searchAlgResults[numOfData].fitnessBS);
+            rangeBS.push_back(searchAlgResults[numOfData].fitnessBS);
+            searchAlgAnalysis.rangesBS.push_back(rangeBS);
+            searchAlgAnalysis.medianBSFitness.push_back(searchAlgResults[numOfData].fitnessBS);
+            searchAlgAnalysis.processTimesBS.push_back(searchAlgResults[numOfData].timeBS);
+        }
 
         // Save Local Search Data.
-        searchAlgAnalysis.avgLSFitness.push_back(searchAlgResults[numOfData].fitnessLS);
-        searchAlgAnalysis.standardDeviationLS.push_back(searchAlgResults[numOfData].fitnessLS);
-        vector<double> rangeLS;
-        rangeLS.push_back(searchAlgResults[numOfData].fitnessLS);
-        rangeLS.push_back(searchAlgResults[numOfData].fitnessLS);
-        searchAlgAnalysis.rangesLS.push_back(rangeLS);
-        searchAlgAnalysis.medianLSFitness.push_back(searchAlgResults[numOfData].fitnessLS);
-        searchAlgAnalysis.processTimesLS.push_back(searchAlgResults[numOfData].timeLS);
+        if(isAlgorithmSelected(ALG_LOCAL_SEARCH))
+        {
+            searchAlgAnalysis.avgLSFitness.push_back(searchAlgResults[numOfData].fitnessLS);
+            searchAlgAnalysis.standardDeviationLS.push_back(searchAlgResults[numOfData].fitnessLS);
+            vector<double> rangeLS;
+            rangeLS.push_back(searchAlgResults[numOfData].fitnessLS);
+            rangeLS.push_back(searchAlgResults[numOfData].fitnessLS);
+            searchAlgAnalysis.rangesLS.push_back(rangeLS);
+            searchAlgAnalysis.medianLSFitness.push_back(searchAlgResults[numOfData].fitnessLS);
+            searchAlgAnalysis.processTimesLS.push_back(searchAlgResults[numOfData].timeLS);
+            searchAlgAnalysis.evalsPerSecLS.push_back(searchAlgResults[numOfData].evalsPerSecLS);
+            searchAlgAnalysis.evaluationsLS.push_back(searchAlgResults[numOfData].evaluationsLS);
+        }
 
         // Save Iterative Local Search Data.
-        double avgILSFitness = calculateAverage(searchAlgResults[numOfData].fitnessILS);
-        searchAlgAnalysis.avgILSFitness.push_back(avgILSFitness);
-        double stdDeviation = calculateStandardDeviation(searchAlgResults[numOfData].fitnessILS);
-        searchAlgAnalysis.standardDeviationILS.push_back(stdDeviation);
-        vector<double> rangeILS;
-        rangeILS.push_back(searchAlgResults[numOfData].fitnessILS[0]);
-        rangeILS.push_back(searchAlgResults[numOfData].fitnessILS[searchAlgResults[numOfData].fitnessILS.size()-1]);
-        searchAlgAnalysis.rangesILS.push_back(rangeILS);
-        searchAlgAnalysis.medianILSFitness.push_back(searchAlgResults[numOfData].fitnessILS[searchAlgResults[numOfData].fitnessILS.size()/2]);
-        searchAlgAnalysis.processTimesILS.push_back(searchAlgResults[numOfData].timeILS);
+        if(isAlgorithmSelected(ALG_ITERATIVE_LOCAL_SEARCH))
+        {
+            double avgILSFitness = calculateAverage(searchAlgResults[numOfData].fitnessILS);
+            searchAlgAnalysis.avgILSFitness.push_back(avgILSFitness);
+            double stdDeviation = calculateStandardDeviation(searchAlgResults[numOfData].fitnessILS);
+            searchAlgAnalysis.standardDeviationILS.push_back(stdDeviation);
+            vector<double> rangeILS;
+            rangeILS.push_back(searchAlgResults[numOfData].fitnessILS[0]);
+            rangeILS.push_back(searchAlgResults[numOfData].fitnessILS[searchAlgResults[numOfData].fitnessILS.size()-1]);
+            searchAlgAnalysis.rangesILS.push_back(rangeILS);
+            searchAlgAnalysis.medianILSFitness.push_back(searchAlgResults[numOfData].fitnessILS[searchAlgResults[numOfData].fitnessILS.size()/2]);
+            searchAlgAnalysis.processTimesILS.push_back(searchAlgResults[numOfData].timeILS);
+            searchAlgAnalysis.evalsPerSecILS.push_back(searchAlgResults[numOfData].evalsPerSecILS);
+            searchAlgAnalysis.evaluationsILS.push_back(searchAlgResults[numOfData].evaluationsILS);
+        }
+
+        // Save Particle Swarm Optimization Data.
+        if(isAlgorithmSelected(ALG_PARTICLE_SWARM))
+        {
+            double avgPSOFitness = calculateAverage(searchAlgResults[numOfData].fitnessPSO);
+            searchAlgAnalysis.avgPSOFitness.push_back(avgPSOFitness);
+            double stdDeviation = calculateStandardDeviation(searchAlgResults[numOfData].fitnessPSO);
+            searchAlgAnalysis.standardDeviationPSO.push_back(stdDeviation);
+            vector<double> rangePSO;
+            rangePSO.push_back(searchAlgResults[numOfData].fitnessPSO[0]);
+            rangePSO.push_back(searchAlgResults[numOfData].fitnessPSO[searchAlgResults[numOfData].fitnessPSO.size()-1]);
+            searchAlgAnalysis.rangesPSO.push_back(rangePSO);
+            searchAlgAnalysis.medianPSOFitness.push_back(searchAlgResults[numOfData].fitnessPSO[searchAlgResults[numOfData].fitnessPSO.size()/2]);
+            searchAlgAnalysis.processTimesPSO.push_back(searchAlgResults[numOfData].timePSO);
+            searchAlgAnalysis.evalsPerSecPSO.push_back(searchAlgResults[numOfData].evalsPerSecPSO);
+        }
+
+        // Save Simulated Annealing Data.
+        if(isAlgorithmSelected(ALG_SIMULATED_ANNEALING))
+        {
+            double avgSAFitness = calculateAverage(searchAlgResults[numOfData].fitnessSA);
+            searchAlgAnalysis.avgSAFitness.push_back(avgSAFitness);
+            double stdDeviation = calculateStandardDeviation(searchAlgResults[numOfData].fitnessSA);
+            searchAlgAnalysis.standardDeviationSA.push_back(stdDeviation);
+            vector<double> rangeSA;
+            rangeSA.push_back(searchAlgResults[numOfData].fitnessSA[0]);
+            rangeSA.push_back(searchAlgResults[numOfData].fitnessSA[searchAlgResults[numOfData].fitnessSA.size()-1]);
+            searchAlgAnalysis.rangesSA.push_back(rangeSA);
+            searchAlgAnalysis.medianSAFitness.push_back(searchAlgResults[numOfData].fitnessSA[searchAlgResults[numOfData].fitnessSA.size()/2]);
+            searchAlgAnalysis.processTimesSA.push_back(searchAlgResults[numOfData].timeSA);
+            searchAlgAnalysis.evalsPerSecSA.push_back(searchAlgResults[numOfData].evalsPerSecSA);
+        }
+
+        // Save CMA-ES Data.
+        if(isAlgorithmSelected(ALG_CMAES))
+        {
+            double avgCMAESFitness = calculateAverage(searchAlgResults[numOfData].fitnessCMAES);
+            searchAlgAnalysis.avgCMAESFitness.push_back(avgCMAESFitness);
+            double stdDeviation = calculateStandardDeviation(searchAlgResults[numOfData].fitnessCMAES);
+            searchAlgAnalysis.standardDeviationCMAES.push_back(stdDeviation);
+            vector<double> rangeCMAES;
+            rangeCMAES.push_back(searchAlgResults[numOfData].fitnessCMAES[0]);
+            rangeCMAES.push_back(searchAlgResults[numOfData].fitnessCMAES[searchAlgResults[numOfData].fitnessCMAES.size()-1]);
+            searchAlgAnalysis.rangesCMAES.push_back(rangeCMAES);
+            searchAlgAnalysis.medianCMAESFitness.push_back(searchAlgResults[numOfData].fitnessCMAES[searchAlgResults[numOfData].fitnessCMAES.size()/2]);
+            searchAlgAnalysis.processTimesCMAES.push_back(searchAlgResults[numOfData].timeCMAES);
+            searchAlgAnalysis.evalsPerSecCMAES.push_back(searchAlgResults[numOfData].evalsPerSecCMAES);
+        }
+
+        // Save Genetic Algorithm Data.
+        if(isAlgorithmSelected(ALG_GENETIC))
+        {
+            double avgGAFitness = calculateAverage(searchAlgResults[numOfData].fitnessGA);
+            searchAlgAnalysis.avgGAFitness.push_back(avgGAFitness);
+            double stdDeviation = calculateStandardDeviation(searchAlgResults[numOfData].fitnessGA);
+            searchAlgAnalysis.standardDeviationGA.push_back(stdDeviation);
+            vector<double> rangeGA;
+            rangeGA.push_back(searchAlgResults[numOfData].fitnessGA[0]);
+            rangeGA.push_back(searchAlgResults[numOfData].fitnessGA[searchAlgResults[numOfData].fitnessGA.size()-1]);
+            searchAlgAnalysis.rangesGA.push_back(rangeGA);
+            searchAlgAnalysis.medianGAFitness.push_back(searchAlgResults[numOfData].fitnessGA[searchAlgResults[numOfData].fitnessGA.size()/2]);
+            searchAlgAnalysis.processTimesGA.push_back(searchAlgResults[numOfData].timeGA);
+            searchAlgAnalysis.evalsPerSecGA.push_back(searchAlgResults[numOfData].evalsPerSecGA);
+        }
+
+        // Save Decomposition Search Data.
+        if(isAlgorithmSelected(ALG_DECOMPOSITION))
+        {
+            double avgDSFitness = calculateAverage(searchAlgResults[numOfData].fitnessDS);
+            searchAlgAnalysis.avgDSFitness.push_back(avgDSFitness);
+            double stdDeviation = calculateStandardDeviation(searchAlgResults[numOfData].fitnessDS);
+            searchAlgAnalysis.standardDeviationDS.push_back(stdDeviation);
+            vector<double> rangeDS;
+            rangeDS.push_back(searchAlgResults[numOfData].fitnessDS[0]);
+            rangeDS.push_back(searchAlgResults[numOfData].fitnessDS[searchAlgResults[numOfData].fitnessDS.size()-1]);
+            searchAlgAnalysis.rangesDS.push_back(rangeDS);
+            searchAlgAnalysis.medianDSFitness.push_back(searchAlgResults[numOfData].fitnessDS[searchAlgResults[numOfData].fitnessDS.size()/2]);
+            searchAlgAnalysis.processTimesDS.push_back(searchAlgResults[numOfData].timeDS);
+            searchAlgAnalysis.evalsPerSecDS.push_back(searchAlgResults[numOfData].evalsPerSecDS);
+        }
+
+        // Save L-BFGS Data.
+        if(isAlgorithmSelected(ALG_LBFGS))
+        {
+            double avgLBFGSFitness = calculateAverage(searchAlgResults[numOfData].fitnessLBFGS);
+            searchAlgAnalysis.avgLBFGSFitness.push_back(avgLBFGSFitness);
+            double stdDeviation = calculateStandardDeviation(searchAlgResults[numOfData].fitnessLBFGS);
+            searchAlgAnalysis.standardDeviationLBFGS.push_back(stdDeviation);
+            vector<double> rangeLBFGS;
+            rangeLBFGS.push_back(searchAlgResults[numOfData].fitnessLBFGS[0]);
+            rangeLBFGS.push_back(searchAlgResults[numOfData].fitnessLBFGS[searchAlgResults[numOfData].fitnessLBFGS.size()-1]);
+            searchAlgAnalysis.rangesLBFGS.push_back(rangeLBFGS);
+            searchAlgAnalysis.medianLBFGSFitness.push_back(searchAlgResults[numOfData].fitnessLBFGS[searchAlgResults[numOfData].fitnessLBFGS.size()/2]);
+            searchAlgAnalysis.processTimesLBFGS.push_back(searchAlgResults[numOfData].timeLBFGS);
+            searchAlgAnalysis.evalsPerSecLBFGS.push_back(searchAlgResults[numOfData].evalsPerSecLBFGS);
+        }
     }
 }
 
@@ -407,102 +779,8 @@ void ProcessFunctions::saveAllMatricesToFile(string configFilename)
  */
 void ProcessFunctions::saveAllProcessedFunctionDataToFile(string configFilename)
 {
-    // Split the configuration filename based on the dot (.) delimiter.
-    vector<string> splitConfig = parseStringStr(configFilename, ".");
-
-    // Set the beginning of filename based on the number of dimensions.
-    string filenameBegin = splitConfig[0] + "-";
-    filenameBegin += to_string(numOfDimensions);
-    filenameBegin += "Dimensional-";
-
     for(int numOfResults = 0; numOfResults < resultsOfFunctions.size(); numOfResults++)
-    {
-        // Initialize the filename with the beginning.
-        string filename = filenameBegin;
-
-        FunctionData data = resultsOfFunctions[numOfResults];
-        int funcID = data.functionID;
-
-        // Save with filename referenced by function IDs.
-        switch(funcID)
-        {
-            case 1:
-                filename += out_schefelsFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 2:
-                filename += out_deJongsFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 3:
-                filename += out_rosenbrockFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 4:
-                filename += out_rastriginFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 5:
-                filename += out_griewangkFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 6:
-                filename += out_sEnvSWaveFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 7:
-                filename += out_strchVSinWaveFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 8:
-                filename += out_ackleys1Filename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 9:
-                filename += out_ackleys2Filename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 10:
-                filename += out_eggHolderFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 11:
-                filename += out_ranaFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 12:
-                filename += out_pathologicalFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 13:
-                filename += out_michalewiczFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 14:
-                filename += out_mastersCosWaveFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 15:
-                filename += out_quarticFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 16:
-                filename += out_levyFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 17:
-                filename += out_stepFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            case 18:
-                filename += out_alpineFilename;
-                saveAllFunctionDataToFile(filename, data);
-                break;
-            default:
-                cout << "Cannot Save Function Results for FunctionData->Function ID: " << funcID << endl;
-                break;
-        }
-    }
+        saveProcessedFunctionDataToFile(configFilename, resultsOfFunctions[numOfResults]);
 }
 
 /**
@@ -525,9 +803,8 @@ void ProcessFunctions::saveAllAnalyzedDataToFile(string configFilename)
     // Rows and Columns.
     int rows = analysis.functionIDs.size(); // Fitness IDs dictates the number of rows.
 
-    // Create the file to where the matrix is saved.
-    ofstream outputFile;
-    outputFile.open (filename);
+    // Build the file in memory, saveOutput() writes it out.
+    ostringstream outputFile;
 
     // If there are more than 0 fitness IDs, save the header line first.
     if(analysis.functionIDs.size() > 0)
@@ -561,8 +838,8 @@ void ProcessFunctions::saveAllAnalyzedDataToFile(string configFilename)
         line = "";
     }
 
-    // Close the file.
-    outputFile.close();
+    // Write the file (in the background if there is an output writer).
+    saveOutput(filename, outputFile.str());
 }
 
 /**
@@ -576,9 +853,8 @@ void ProcessFunctions::saveAllAnalyzedDataToSpecificFile(string filename)
     // Rows and Columns.
     int rows = analysis.functionIDs.size(); // Fitness IDs dictates the number of rows.
 
-    // Create the file to where the matrix is saved.
-    ofstream outputFile;
-    outputFile.open (filename);
+    // Build the file in memory, saveOutput() writes it out.
+    ostringstream outputFile;
 
     // If there are more than 0 fitness IDs, save the header line first.
     if(analysis.functionIDs.size() > 0)
@@ -612,8 +888,8 @@ void ProcessFunctions::saveAllAnalyzedDataToSpecificFile(string filename)
         line = "";
     }
 
-    // Close the file.
-    outputFile.close();
+    // Write the file (in the background if there is an output writer).
+    saveOutput(filename, outputFile.str());
 }
 
 /**
@@ -644,15 +920,63 @@ void ProcessFunctions::saveAllAnalyzedSearchAlgDataToFile(string configFilename)
     // Rows and Columns.
     int rows = searchAlgAnalysis.functionIDs.size(); // Fitness IDs dictates the number of rows.
 
-    // Create the file to where the matrix is saved.
-    ofstream outputFile;
-    outputFile.open (filename);
+    // Build the file in memory, saveOutput() writes it out.
+    ostringstream outputFile;
+
+    // Build the two header lines from the selected algorithms.
+    string mainHeader = " ";
+    string header = searchAlgAnalysis.idHeader;
+    if(isAlgorithmSelected(ALG_BLIND_SEARCH))
+    {
+        mainHeader += ",Blind Search, , , , , ";
+        header += "," + searchAlgAnalysis.statsHeader;
+    }
+    if(isAlgorithmSelected(ALG_LOCAL_SEARCH))
+    {
+        mainHeader += ",Local Search, , , , , , , ";
+        header += "," + searchAlgAnalysis.statsHeader + "," + searchAlgAnalysis.throughputHeader + "," + searchAlgAnalysis.countHeader;
+    }
+    if(isAlgorithmSelected(ALG_ITERATIVE_LOCAL_SEARCH))
+    {
+        mainHeader += ",Iterative Local Search, , , , , , , ";
+        header += "," + searchAlgAnalysis.statsHeader + "," + searchAlgAnalysis.throughputHeader + "," + searchAlgAnalysis.countHeader;
+    }
+    if(isAlgorithmSelected(ALG_PARTICLE_SWARM))
+    {
+        mainHeader += ",Particle Swarm Optimization, , , , , , ";
+        header += "," + searchAlgAnalysis.statsHeader + "," + searchAlgAnalysis.throughputHeader;
+    }
+    if(isAlgorithmSelected(ALG_SIMULATED_ANNEALING))
+    {
+        mainHeader += ",Simulated Annealing, , , , , , ";
+        header += "," + searchAlgAnalysis.statsHeader + "," + searchAlgAnalysis.throughputHeader;
+    }
+    if(isAlgorithmSelected(ALG_CMAES))
+    {
+        mainHeader += ",CMA-ES, , , , , , ";
+        header += "," + searchAlgAnalysis.statsHeader + "," + searchAlgAnalysis.throughputHeader;
+    }
+    if(isAlgorithmSelected(ALG_GENETIC))
+    {
+        mainHeader += ",Genetic Algorithm, , , , , , ";
+        header += "," + searchAlgAnalysis.statsHeader + "," + searchAlgAnalysis.throughputHeader;
+    }
+    if(isAlgorithmSelected(ALG_DECOMPOSITION))
+    {
+        mainHeader += ",Decomposition Search, , , , , , ";
+        header += "," + searchAlgAnalysis.statsHeader + "," + searchAlgAnalysis.throughputHeader;
+    }
+    if(isAlgorithmSelected(ALG_LBFGS))
+    {
+        mainHeader += ",L-BFGS, , , , , , ";
+        header += "," + searchAlgAnalysis.statsHeader + "," + searchAlgAnalysis.throughputHeader;
+    }
 
     // If there are more than 0 fitness IDs, save the header line first.
-    if(analysis.functionIDs.size() > 0)
+    if(searchAlgAnalysis.functionIDs.size() > 0)
     {
-        outputFile << searchAlgAnalysis.mainHeader;
-        outputFile << searchAlgAnalysis.header;
+        outputFile << mainHeader << "\n";
+        outputFile << header << "\n";
     }
 
     // Save data to file.
@@ -660,39 +984,564 @@ void ProcessFunctions::saveAllAnalyzedSearchAlgDataToFile(string configFilename)
     for(int row = 0; row < rows; row++)
     {
         // Save the fitness ID.
-        line += to_string(searchAlgAnalysis.functionIDs[row]) + ",";
+        line += to_string(searchAlgAnalysis.functionIDs[row]);
 
         // Save Blind Search Data.
-        line += to_string(searchAlgAnalysis.avgBSFitness[row]) + ",";
-        line += to_string(searchAlgAnalysis.standardDeviationBS[row]) + ",";
-        line += to_string(searchAlgAnalysis.rangesBS[row][0]) + ",";
-        line += to_string(searchAlgAnalysis.rangesBS[row][1]) + ",";
-        line += to_string(searchAlgAnalysis.medianBSFitness[row]) + ",";
-        line += to_string(searchAlgAnalysis.processTimesBS[row]) + ",";
+        if(isAlgorithmSelected(ALG_BLIND_SEARCH))
+        {
+            line += "," + to_string(searchAlgAnalysis.avgBSFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.standardDeviationBS[row]);
+            line += "," + to_string(searchAlgAnalysis.rangesBS[row][0]);
+            line += "," + to_string(searchAlgAnalysis.rangesBS[row][1]);
+            line += "," + to_string(searchAlgAnalysis.medianBSFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.processTimesBS[row]);
+        }
 
         // Save Local Search Data.
-        line += to_string(searchAlgAnalysis.avgLSFitness[row]) + ",";
-        line += to_string(searchAlgAnalysis.standardDeviationLS[row]) + ",";
-        line += to_string(searchAlgAnalysis.rangesLS[row][0]) + ",";
-        line += to_string(searchAlgAnalysis.rangesLS[row][1]) + ",";
-        line += to_string(searchAlgAnalysis.medianLSFitness[row]) + ",";
-        line += to_string(searchAlgAnalysis.processTimesLS[row]) + ",";
+        if(isAlgorithmSelected(ALG_LOCAL_SEARCH))
+        {
+            line += "," + to_string(searchAlgAnalysis.avgLSFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.standardDeviationLS[row]);
+            line += "," + to_string(searchAlgAnalysis.rangesLS[row][0]);
+            line += "," + to_string(searchAlgAnalysis.rangesLS[row][1]);
+            line += "," + to_string(searchAlgAnalysis.medianLSFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.processTimesLS[row]);
+            line += "," + to_string(searchAlgAnalysis.evalsPerSecLS[row]);
+            line += "," + to_string(searchAlgAnalysis.evaluationsLS[row]);
+        }
 
         // Save Iterative Local Search Data.
-        line += to_string(searchAlgAnalysis.avgILSFitness[row]) + ",";
-        line += to_string(searchAlgAnalysis.standardDeviationILS[row]) + ",";
-        line += to_string(searchAlgAnalysis.rangesILS[row][0]) + ",";
-        line += to_string(searchAlgAnalysis.rangesILS[row][1]) + ",";
-        line += to_string(searchAlgAnalysis.medianILSFitness[row]) + ",";
-        line += to_string(searchAlgAnalysis.processTimesILS[row]) + "\n";
+        if(isAlgorithmSelected(ALG_ITERATIVE_LOCAL_SEARCH))
+        {
+            line += "," + to_string(searchAlgAnalysis.avgILSFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.standardDeviationILS[row]);
+            line += "," + to_string(searchAlgAnalysis.rangesILS[row][0]);
+            line += "," + to_string(searchAlgAnalysis.rangesILS[row][1]);
+            line += "," + to_string(searchAlgAnalysis.medianILSFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.processTimesILS[row]);
+            line += "," + to_string(searchAlgAnalysis.evalsPerSecILS[row]);
+            line += "," + to_string(searchAlgAnalysis.evaluationsILS[row]);
+        }
+
+        // Save Particle Swarm Optimization Data.
+        if(isAlgorithmSelected(ALG_PARTICLE_SWARM))
+        {
+            line += "," + to_string(searchAlgAnalysis.avgPSOFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.standardDeviationPSO[row]);
+            line += "," + to_string(searchAlgAnalysis.rangesPSO[row][0]);
+            line += "," + to_string(searchAlgAnalysis.rangesPSO[row][1]);
+            line += "," + to_string(searchAlgAnalysis.medianPSOFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.processTimesPSO[row]);
+            line += "," + to_string(searchAlgAnalysis.evalsPerSecPSO[row]);
+        }
+
+        // Save Simulated Annealing Data.
+        if(isAlgorithmSelected(ALG_SIMULATED_ANNEALING))
+        {
+            line += "," + to_string(searchAlgAnalysis.avgSAFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.standardDeviationSA[row]);
+            line += "," + to_string(searchAlgAnalysis.rangesSA[row][0]);
+            line += "," + to_string(searchAlgAnalysis.rangesSA[row][1]);
+            line += "," + to_string(searchAlgAnalysis.medianSAFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.processTimesSA[row]);
+            line += "," + to_string(searchAlgAnalysis.evalsPerSecSA[row]);
+        }
+
+        // Save CMA-ES Data.
+        if(isAlgorithmSelected(ALG_CMAES))
+        {
+            line += "," + to_string(searchAlgAnalysis.avgCMAESFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.standardDeviationCMAES[row]);
+            line += "," + to_string(searchAlgAnalysis.rangesCMAES[row][0]);
+            line += "," + to_string(searchAlgAnalysis.rangesCMAES[row][1]);
+            line += "," + to_string(searchAlgAnalysis.medianCMAESFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.processTimesCMAES[row]);
+            line += "," + to_string(searchAlgAnalysis.evalsPerSecCMAES[row]);
+        }
+
+        // Save Genetic Algorithm Data.
+        if(isAlgorithmSelected(ALG_GENETIC))
+        {
+            line += "," + to_string(searchAlgAnalysis.avgGAFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.standardDeviationGA[row]);
+            line += "," + to_string(searchAlgAnalysis.rangesGA[row][0]);
+            line += "," + to_string(searchAlgAnalysis.rangesGA[row][1]);
+            line += "," + to_string(searchAlgAnalysis.medianGAFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.processTimesGA[row]);
+            line += "," + to_string(searchAlgAnalysis.evalsPerSecGA[row]);
+        }
+
+        // Save Decomposition Search Data.
+        if(isAlgorithmSelected(ALG_DECOMPOSITION))
+        {
+            line += "," + to_string(searchAlgAnalysis.avgDSFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.standardDeviationDS[row]);
+            line += "," + to_string(searchAlgAnalysis.rangesDS[row][0]);
+            line += "," + to_string(searchAlgAnalysis.rangesDS[row][1]);
+            line += "," + to_string(searchAlgAnalysis.medianDSFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.processTimesDS[row]);
+            line += "," + to_string(searchAlgAnalysis.evalsPerSecDS[row]);
+        }
+
+        // Save L-BFGS Data.
+        if(isAlgorithmSelected(ALG_LBFGS))
+        {
+            line += "," + to_string(searchAlgAnalysis.avgLBFGSFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.standardDeviationLBFGS[row]);
+            line += "," + to_string(searchAlgAnalysis.rangesLBFGS[row][0]);
+            line += "," + to_string(searchAlgAnalysis.rangesLBFGS[row][1]);
+            line += "," + to_string(searchAlgAnalysis.medianLBFGSFitness[row]);
+            line += "," + to_string(searchAlgAnalysis.processTimesLBFGS[row]);
+            line += "," + to_string(searchAlgAnalysis.evalsPerSecLBFGS[row]);
+        }
+        line += "\n";
 
         // Save the row to file and clear the line string.
         outputFile << line;
         line = "";
     }
 
-    // Close the file.
+    // Write the file (in the background if there is an output writer).
+    saveOutput(filename, outputFile.str());
+}
+
+/**
+ * @brief Saves the raw results in searchAlgResults to file.
+ *
+ * Unlike the analysis, every fitness value is kept (at full precision), so
+ * results saved from separate runs can be loaded back together and analyzed
+ * as if they came from a single run. The file is a small CSV: a line with
+ * the algorithms that were run, then for every function a "Function" line
+ * followed by one line per algorithm:
+ *      <algorithm>,<time(ms)>,<evaluations per second>,<fitness>,<fitness>,...
+ * The local searches are followed by a line with their evaluation count:
+ *      Evaluations,<algorithm>,<count>
+ *
+ * @param filename The file where the results are saved.
+ *
+ * @return True if the file was written, false otherwise.
+ */
+bool ProcessFunctions::saveSearchAlgResultsToFile(string filename)
+{
+    ofstream outputFile;
+    outputFile.open(filename);
+    if(outputFile.fail())
+        return false;
+    outputFile << setprecision(17);
+
+    // Save the algorithms that were run.
+    vector<string> algorithms = {ALG_BLIND_SEARCH, ALG_LOCAL_SEARCH, ALG_ITERATIVE_LOCAL_SEARCH, ALG_PARTICLE_SWARM,
+                                 ALG_SIMULATED_ANNEALING, ALG_CMAES, ALG_GENETIC, ALG_DECOMPOSITION, ALG_LBFGS};
+    outputFile << "Algorithms";
+    for(int a = 0; a < algorithms.size(); a++)
+        if(isAlgorithmSelected(algorithms[a]))
+            outputFile << "," << algorithms[a];
+    outputFile << "\n";
+
+    // Saves one algorithm's line.
+    auto saveLine = [&outputFile](string algorithm, double time, double evalsPerSec, vector<double> fitnessList)
+    {
+        outputFile << algorithm << "," << time << "," << evalsPerSec;
+        for(int i = 0; i < fitnessList.size(); i++)
+            outputFile << "," << fitnessList[i];
+        outputFile << "\n";
+    };
+
+    for(int numOfData = 0; numOfData < searchAlgResults.size(); numOfData++)
+    {
+        SearchAlgorithmResults &results = searchAlgResults[numOfData];
+        outputFile << "Function," << results.functionID << "\n";
+
+        if(isAlgorithmSelected(ALG_BLIND_SEARCH))
+            saveLine(ALG_BLIND_SEARCH, results.timeBS, 0, {results.fitnessBS});
+        if(isAlgorithmSelected(ALG_LOCAL_SEARCH))
+        {
+            saveLine(ALG_LOCAL_SEARCH, results.timeLS, results.evalsPerSecLS, {results.fitnessLS});
+            outputFile << "Evaluations," << ALG_LOCAL_SEARCH << "," << results.evaluationsLS << "\n";
+        }
+        if(isAlgorithmSelected(ALG_ITERATIVE_LOCAL_SEARCH))
+        {
+            saveLine(ALG_ITERATIVE_LOCAL_SEARCH, results.timeILS, results.evalsPerSecILS, results.fitnessILS);
+            outputFile << "Evaluations," << ALG_ITERATIVE_LOCAL_SEARCH << "," << results.evaluationsILS << "\n";
+        }
+        if(isAlgorithmSelected(ALG_PARTICLE_SWARM))
+            saveLine(ALG_PARTICLE_SWARM, results.timePSO, results.evalsPerSecPSO, results.fitnessPSO);
+        if(isAlgorithmSelected(ALG_SIMULATED_ANNEALING))
+            saveLine(ALG_SIMULATED_ANNEALING, results.timeSA, results.evalsPerSecSA, results.fitnessSA);
+        if(isAlgorithmSelected(ALG_CMAES))
+            saveLine(ALG_CMAES, results.timeCMAES, results.evalsPerSecCMAES, results.fitnessCMAES);
+        if(isAlgorithmSelected(ALG_GENETIC))
+            saveLine(ALG_GENETIC, results.timeGA, results.evalsPerSecGA, results.fitnessGA);
+        if(isAlgorithmSelected(ALG_DECOMPOSITION))
+            saveLine(ALG_DECOMPOSITION, results.timeDS, results.evalsPerSecDS, results.fitnessDS);
+        if(isAlgorithmSelected(ALG_LBFGS))
+            saveLine(ALG_LBFGS, results.timeLBFGS, results.evalsPerSecLBFGS, results.fitnessLBFGS);
+    }
+
     outputFile.close();
+    return !outputFile.fail();
+}
+
+/**
+ * @brief Loads raw results saved by saveSearchAlgResultsToFile() into searchAlgResults.
+ *
+ * The results are added after the ones already in searchAlgResults, and the
+ * algorithms in the file become the selected algorithms, so they can be
+ * analyzed and saved as usual.
+ *
+ * @note This function makes a call to utilities.h --> nextToken() and parseNumbers().
+ *
+ * @param filename The file where the results were saved.
+ *
+ * @return True if the file was loaded, false otherwise.
+ */
+bool ProcessFunctions::loadSearchAlgResultsFromFile(string filename)
+{
+    ifstream inputFile;
+    inputFile.open(filename);
+    if(inputFile.fail())
+        return false;
+
+    string line, error;
+    vector<double> values;
+    for(int lineNumber = 1; getline(inputFile, line); lineNumber++)
+    {
+        // The first field says what the line holds.
+        string_view rest = line, first;
+        if(!nextToken(rest, ",", first))
+            continue;
+
+        // The algorithms that were run.
+        if(first == "Algorithms")
+        {
+            selectedAlgorithms = parseStringStr(string(rest), ",");
+            continue;
+        }
+
+        // The evaluation count of a local search (files saved before it was counted don't have one).
+        string_view algorithm;
+        if(first == "Evaluations" && nextToken(rest, ",", algorithm))
+        {
+            double count;
+            if(searchAlgResults.size() == 0 || !parseNumber(rest, count))
+            {
+                cout << lineError(filename, lineNumber, "expected Evaluations,<algorithm>,<count>") << endl;
+                return false;
+            }
+            if(algorithm == ALG_LOCAL_SEARCH)
+                searchAlgResults.back().evaluationsLS = count;
+            else if(algorithm == ALG_ITERATIVE_LOCAL_SEARCH)
+                searchAlgResults.back().evaluationsILS = count;
+            continue;
+        }
+
+        // Everything else on the line is numbers.
+        if(!parseNumbers(rest, ",", values, error))
+        {
+            cout << lineError(filename, lineNumber, error) << endl;
+            return false;
+        }
+
+        // The start of the next function's results.
+        if(first == "Function" && values.size() == 1)
+        {
+            SearchAlgorithmResults results;
+            results.functionID = values[0];
+            searchAlgResults.push_back(results);
+            continue;
+        }
+
+        // One algorithm's results: time, evaluations per second and the list of fitness values.
+        if(searchAlgResults.size() == 0 || values.size() < 3)
+        {
+            cout << lineError(filename, lineNumber, "expected <algorithm>,<time>,<evaluations per second>,<fitness>...") << endl;
+            return false;
+        }
+        SearchAlgorithmResults &results = searchAlgResults.back();
+        double time = values[0], evalsPerSec = values[1];
+        vector<double> fitnessList(values.begin() + 2, values.end());
+
+        if(first == ALG_BLIND_SEARCH)
+        {
+            results.timeBS = time;
+            results.fitnessBS = fitnessList[0];
+        }
+        else if(first == ALG_LOCAL_SEARCH)
+        {
+            results.timeLS = time;
+            results.evalsPerSecLS = evalsPerSec;
+            results.fitnessLS = fitnessList[0];
+        }
+        else if(first == ALG_ITERATIVE_LOCAL_SEARCH)
+        {
+            results.timeILS = time;
+            results.evalsPerSecILS = evalsPerSec;
+            results.fitnessILS = fitnessList;
+        }
+        else if(first == ALG_PARTICLE_SWARM)
+        {
+            results.timePSO = time;
+            results.evalsPerSecPSO = evalsPerSec;
+            results.fitnessPSO = fitnessList;
+        }
+        else if(first == ALG_SIMULATED_ANNEALING)
+        {
+            results.timeSA = time;
+            results.evalsPerSecSA = evalsPerSec;
+            results.fitnessSA = fitnessList;
+        }
+        else if(first == ALG_CMAES)
+        {
+            results.timeCMAES = time;
+            results.evalsPerSecCMAES = evalsPerSec;
+            results.fitnessCMAES = fitnessList;
+        }
+        else if(first == ALG_GENETIC)
+        {
+            results.timeGA = time;
+            results.evalsPerSecGA = evalsPerSec;
+            results.fitnessGA = fitnessList;
+        }
+        else if(first == ALG_DECOMPOSITION)
+        {
+            results.timeDS = time;
+            results.evalsPerSecDS = evalsPerSec;
+            results.fitnessDS = fitnessList;
+        }
+        else if(first == ALG_LBFGS)
+        {
+            results.timeLBFGS = time;
+            results.evalsPerSecLBFGS = evalsPerSec;
+            results.fitnessLBFGS = fitnessList;
+        }
+    }
+
+    inputFile.close();
+    return true;
+}
+
+/**
+ * @brief Derives every random stream of the run from a seed, so the run can be repeated.
+ *
+ * Each function's matrix, and each function's search algorithms, get their
+ * own stream derived from the seed, the number of dimensions and the
+ * function's position in the configuration file. So the same seed always
+ * gives the same matrices and searches, whatever work is skipped.
+ *
+ * @param seed The seed of the run.
+ */
+void ProcessFunctions::setRunSeed(unsigned int seed)
+{
+    isSeeded = true;
+    runSeed = seed;
+}
+
+/**
+ * @brief Returns the seed of the run.
+ * @return The value stored in the runSeed variable (only used if a seed was set).
+ */
+unsigned int ProcessFunctions::getRunSeed()
+{
+    return runSeed;
+}
+
+/**
+ * @brief Saves a checkpoint after every function searched and every dimension completed.
+ *
+ * If no seed was set, a random one is chosen, since a run can only be resumed
+ * exactly if its random streams can be repeated.
+ *
+ * @param filename The file where the checkpoint is saved.
+ */
+void ProcessFunctions::setCheckpointFile(string filename)
+{
+    checkpointFilename = filename;
+    if(!isSeeded)
+        setRunSeed(random_device()());
+}
+
+/**
+ * @brief Restores the run seed and the finished work from a checkpoint.
+ *
+ * The checkpoint holds the seed of the run, the dimensions whose results were
+ * saved, and the search algorithm results of the functions finished in the
+ * dimension that was running. Those functions aren't searched again; every
+ * other search starts from the same random stream it would have started from
+ * in the original run.
+ *
+ * @param filename The file where the checkpoint was saved.
+ *
+ * @return True if the checkpoint was restored, false otherwise.
+ */
+bool ProcessFunctions::resumeFromCheckpoint(string filename)
+{
+    ifstream inputFile;
+    inputFile.open(filename, ios::binary);
+    if(inputFile.fail())
+        return false;
+
+    // Check that it's a checkpoint in this format.
+    char magic[sizeof(CHECKPOINT_MAGIC)] = "";
+    inputFile.read(magic, sizeof(CHECKPOINT_MAGIC));
+    if(!inputFile || string(magic) != CHECKPOINT_MAGIC)
+        return false;
+
+    // The seed of the run and the completed dimensions.
+    unsigned int seed, count;
+    vector<int> dimensions;
+    if(!readBinary(inputFile, seed) || !readBinary(inputFile, count))
+        return false;
+    dimensions.resize(count);
+    for(int i = 0; i < count; i++)
+        if(!readBinary(inputFile, dimensions[i]))
+            return false;
+
+    // The results of the functions finished in the dimension that was running.
+    int runningDimensions;
+    vector<SearchAlgorithmResults> results;
+    if(!readBinary(inputFile, runningDimensions) || !readBinary(inputFile, count))
+        return false;
+    results.resize(count);
+    for(int i = 0; i < count; i++)
+        if(!readBinary(inputFile, results[i]))
+            return false;
+
+    inputFile.close();
+
+    setRunSeed(seed);
+    completedDimensions = dimensions;
+    restoredDimensions = runningDimensions;
+    restoredResults = results;
+    return true;
+}
+
+/**
+ * @brief Checks if the results of a dimension were already saved.
+ * @param dimensions The number of dimensions.
+ * @return True if completeDimension() was called for it (in this run or a resumed one).
+ */
+bool ProcessFunctions::isDimensionCompleted(int dimensions)
+{
+    return find(completedDimensions.begin(), completedDimensions.end(), dimensions) != completedDimensions.end();
+}
+
+/**
+ * @brief Records that the results of the current dimension were saved.
+ *
+ * Call this after the results of a dimension were saved to file, so that a
+ * resumed run skips it.
+ */
+void ProcessFunctions::completeDimension()
+{
+    if(!isDimensionCompleted(numOfDimensions))
+        completedDimensions.push_back(numOfDimensions);
+
+    if(checkpointFilename.size() > 0)
+        saveCheckpoint();
+}
+
+/**
+ * @brief Hands the output files to a background writer from now on.
+ *
+ * The save functions then build each file in memory and give it to the
+ * writer instead of writing it themselves, so the writing happens off the
+ * computing thread. Call AsyncWriter::finish() before exiting to make sure
+ * everything is on disk.
+ *
+ * @param writer The writer, or NULL to write the files directly again.
+ */
+void ProcessFunctions::setOutputWriter(AsyncWriter *writer)
+{
+    outputWriter = writer;
+}
+
+/**
+ * @brief Sets where the matrices and the random starts of the searches come from.
+ *
+ * SAMPLER_RANDOM (the default) is the Mersenne Twister. The quasi-random
+ * samplers cover the search space more evenly, for the function matrices,
+ * Blind Search and the random restarts of Iterated Local Search.
+ *
+ * @param type SAMPLER_RANDOM, SAMPLER_SOBOL, SAMPLER_HALTON or SAMPLER_LATIN_HYPERCUBE.
+ */
+void ProcessFunctions::setSamplerType(int type)
+{
+    samplerType = type;
+}
+
+/**
+ * @brief Sets the descent of Local Search and of every Iterative Local Search restart.
+ *
+ * LS_MODE_FIXED (the default) steps every element by alpha times its
+ * forward difference. LS_MODE_ADAPTIVE moves one element at a time with its
+ * own step length (see adaptiveLocalDescent()), which usually needs far
+ * fewer evaluations to reach the same fitness.
+ *
+ * @param mode LS_MODE_FIXED or LS_MODE_ADAPTIVE.
+ */
+void ProcessFunctions::setLocalSearchMode(int mode)
+{
+    localSearchMode = mode;
+}
+
+/**
+ * @brief Takes the results of work done before, by the same build, from a result cache.
+ *
+ * The fitness of a matrix is looked up by the function and the matrix
+ * itself, and the results of the searches on a function by everything they
+ * depend on (see searchCacheKey()), so only a seeded run's searches can be
+ * found. Whatever isn't found is computed and added to the cache. The times
+ * of cached results are the times they took when they were computed. The
+ * searches aren't cached when ILS runs on more than one thread, or with a
+ * quantized fitness memo, since their results can't be repeated then.
+ *
+ * @param cache The open cache, or NULL to compute everything again.
+ */
+void ProcessFunctions::setResultCache(ResultCache *cache)
+{
+    resultCache = cache;
+}
+
+/**
+ * @brief Makes the searches remember the fitness of the vectors they evaluate.
+ *
+ * Every function searched gets a FitnessMemo of the given capacity, which
+ * calculateFitnessOfVector() consults for the expensive functions (see
+ * functionIsExpensive()) on the threads of the searches while they run.
+ * Its hit rate is printed once the searches finish.
+ *
+ * With a quantum of 0 only bit-identical vectors are remembered, and the
+ * results don't change. With a positive quantum, a vector takes the fitness
+ * of the first vector evaluated in the same quantum-sized cell, so the
+ * results change (and depend on the order of evaluation, which the threads
+ * of a search don't fix), so they're neither taken from nor added to the
+ * result cache.
+ *
+ * @param capacity The number of vectors remembered per function, 0 for none.
+ * @param quantum The size of a cell of the memo's keys, 0 for exact keys.
+ */
+void ProcessFunctions::setFitnessMemo(long long capacity, double quantum)
+{
+    memoCapacity = capacity;
+    memoQuantum = quantum;
+}
+
+/**
+ * @brief Makes Blind Search score its vectors with a table of the function's terms.
+ *
+ * For the functions TermTable supports, a table is built over the bounds of
+ * the function before Blind Search runs, and Blind Search interpolates the
+ * terms from it instead of calling sin, cos and sqrt. The best vector found
+ * is still scored with the exact function. TERM_TABLE_OFF (the default)
+ * calculates every term exactly.
+ *
+ * @param interpolation TERM_TABLE_OFF, TERM_TABLE_LINEAR or TERM_TABLE_CUBIC.
+ * @param maxError The largest error allowed in an interpolated term.
+ */
+void ProcessFunctions::setTermTable(int interpolation, double maxError)
+{
+    termTableInterpolation = interpolation;
+    termTableError = maxError;
 }
 
 /**
@@ -849,9 +1698,12 @@ void ProcessFunctions::printFunctionResultsAnalysis()
  *
  * A matrix is constructed using the specified number of dimensions
  * stored in numOfDimensions and a user-provided minimum and maximum bound.
+ * If a quasi-random sampler was set, the rows are the first points of its
+ * sequence instead.
  *
  * @note DEFAULT_NUM_OF_VECTORS is currently set to 30 (as of April 4, 2019).
  * @note This function makes a call to utilities.h --> createMatrix().
+ * @note This function makes a call to Sampler.h --> createMatrix().
  *
  * @param minBoundary, maxBoundary The max/min boundaries are the range
  *                                 in which to generate numbers.
@@ -863,12 +1715,56 @@ FunctionData ProcessFunctions::generateMatrix(double minBoundary, double maxBoun
     FunctionData generatedData;
 
     // Create the Matrix.
-    generatedData.functionMatrix = createMatrix(DEFAULT_NUM_OF_VECTORS, numOfDimensions, minBoundary, maxBoundary);
+    if(samplerType == SAMPLER_RANDOM)
+        generatedData.functionMatrix = createMatrix(DEFAULT_NUM_OF_VECTORS, numOfDimensions, minBoundary, maxBoundary);
+    else
+    {
+        Sampler sampler(samplerType, numOfDimensions, DEFAULT_NUM_OF_VECTORS, nextRandomSeed());
+        generatedData.functionMatrix = sampler.createMatrix(DEFAULT_NUM_OF_VECTORS, minBoundary, maxBoundary);
+    }
 
     // Return the generated data.
     return generatedData;
 }
 
+/**
+ * @brief Generates the matrix of a function from the configuration file.
+ *
+ * If the run is seeded, the matrix is generated from the function's own
+ * random stream, so it's the same whichever thread generates it.
+ *
+ * @param funcID The function ID for which Benchmark Function the matrix is generated for.
+ * @param minBoundary, maxBoundary  The minimum and maximum boundaries for the values
+ *                                  in the matrix.
+ * @param functionIndex The position of the function among the valid functions.
+ * @param funcData The FunctionData structure the matrix is generated into.
+ *
+ * @return False (after notifying the user of the Function IDs) if the function ID is out of range.
+ */
+bool ProcessFunctions::generateFunctionMatrix(int funcID, double minBoundary, double maxBoundary, int functionIndex, FunctionData &funcData)
+{
+    // If the function ID is out of range, notify user of Function IDs and exit.
+    if(funcID < 1 || funcID > 18)
+    {
+        cout <<"\n******* ";
+        cout << "Cannot generate matrix for Function ID " << funcID;
+        cout <<" *******";
+        printAllFunctionIDs();
+        return false;
+    }
+
+    // Give the matrix its own random stream if the run is seeded.
+    if(isSeeded)
+        setRandomSeed(streamSeed(functionIndex, SEED_STREAM_MATRIX));
+
+    // Construct a matrix with user-provided boundaries.
+    funcData = generateMatrix(minBoundary, maxBoundary);
+    funcData.functionID = funcID;
+    funcData.minBound = minBoundary;
+    funcData.maxBound = maxBoundary;
+    return true;
+}
+
 /**
  * @brief Calculates the fitness of all vectors of a matrix.
  *
@@ -890,6 +1786,59 @@ void ProcessFunctions::calculateMatrixFitness(FunctionData &data)
     data.fitness = calculateFitnessOfMatrix(data.functionMatrix, funcID);
 }
 
+/**
+ * @brief Calculates, times and sorts the fitness of all vectors of a matrix.
+ *
+ * With a result cache, a matrix of the same function seen before gets the
+ * fitness (and the time) saved then.
+ *
+ * @note This function makes a call to ResultCache.h --> lookup() and store().
+ *
+ * @param data The FunctionData structure that contains the matrix.
+ */
+void ProcessFunctions::evaluateMatrix(FunctionData &data)
+{
+    // The fitness of a matrix depends on nothing else than the function and the matrix.
+    string cacheKey, cachedValue;
+    if(resultCache != NULL)
+    {
+        ostringstream key;
+        key << "fitness," << ResultCache::buildVersion() << "," << data.functionID << "," << data.functionMatrix.size() << ","
+            << numOfDimensions << "," << hex << hashMatrix(data.functionMatrix);
+        cacheKey = key.str();
+    }
+
+    // The cached fitness is in matrix order, it's sorted below like a calculated one.
+    bool isCached = false;
+    if(!cacheKey.empty() && resultCache->lookup(cacheKey, cachedValue))
+    {
+        istringstream cached(cachedValue);
+        isCached = readBinary(cached, data.timeToExecute) && readBinary(cached, data.fitness) && data.fitness.size() == data.functionMatrix.size();
+    }
+
+    if(!isCached)
+    {
+        // Record the start and end time of executing the benchmark function on matrix.
+        auto startTime = chrono::high_resolution_clock::now();
+        calculateMatrixFitness(data);
+        auto endTime = chrono::high_resolution_clock::now();
+
+        // Calculate elapsed time in milliseconds it took to execute the benchmark function.
+        data.timeToExecute = chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count();
+
+        if(!cacheKey.empty())
+        {
+            ostringstream value;
+            writeBinary(value, data.timeToExecute);
+            writeBinary(value, data.fitness);
+            resultCache->store(cacheKey, value.str());
+        }
+    }
+
+    // Sort the results by fitness.
+    quicksortFuncData(data, 0, data.fitness.size()-1);
+}
+
 void ProcessFunctions::analyzeFunctionResults(FunctionData &data) /**< Analyzes the results of the functions.*/
 {
     int fitnessSize = data.fitness.size();
@@ -938,6 +1887,391 @@ double ProcessFunctions::getMaxFitness(FunctionData &data)
     return data.fitness[data.fitness.size() - 1];
 }
 
+/**
+ * @brief Checks if a search algorithm was selected in SearchAlgorithmConfig.txt.
+ * @param algorithm The name of the algorithm (one of the ALG_ constants).
+ * @return True if no selection was made, or if the algorithm is in the selection.
+ */
+bool ProcessFunctions::isAlgorithmSelected(string algorithm)
+{
+    if(selectedAlgorithms.size() == 0)
+        return true;
+
+    for(int i = 0; i < selectedAlgorithms.size(); i++)
+        if(selectedAlgorithms[i] == algorithm)
+            return true;
+
+    return false;
+}
+
+/**
+ * @brief Writes an output file, through the output writer if there is one.
+ * @param filename The file to (over)write.
+ * @param contents Everything that goes in the file.
+ */
+void ProcessFunctions::saveOutput(string filename, string contents)
+{
+    if(outputWriter != NULL)
+    {
+        outputWriter->write(filename, move(contents));
+        return;
+    }
+
+    ofstream outputFile;
+    outputFile.open(filename);
+    outputFile << contents;
+    outputFile.close();
+}
+
+/**
+ * @brief Performs all the selected search algorithms on one FunctionData structure.
+ *
+ * @note This function makes a call to utilities.h --> quicksort().
+ *
+ * @param data The FunctionData structure, with its fitness calculated and sorted.
+ * @param functionIndex The position of the function in the configuration file.
+ *
+ * @return The results of the search algorithms.
+ */
+SearchAlgorithmResults ProcessFunctions::performSearchAlgorithms(FunctionData &data, int functionIndex)
+{
+    // Assign variables for search algorithms.
+    int iterations = searchIterations;
+    double alpha = searchAlpha;
+    int coolingSchedule = searchCoolingSchedule;
+    int functionID = data.functionID;
+    vector<double> bestVect = data.functionMatrix[0];
+    double bestFitness = data.fitness[0];
+    double minBound = data.minBound, maxBound = data.maxBound;
+    int rows = DEFAULT_NUM_OF_VECTORS, columns = numOfDimensions;
+
+    // Declare variables for timing the search algorithms.
+    chrono::high_resolution_clock::time_point startTime, endTime;
+    chrono::high_resolution_clock::duration elapsedTime;
+    double elapsedTimeMS, elapsedTimeSec;
+    long long evaluations;
+    int generations;
+
+    // Results restored from a checkpoint are not searched again.
+    if(numOfDimensions == restoredDimensions && functionIndex < restoredResults.size() && restoredResults[functionIndex].functionID == functionID)
+    {
+        return restoredResults[functionIndex];
+    }
+
+    // The same seeded searches, run before by the same build, come from the result cache
+    // (not with a quantized fitness memo, whose results depend on the order of evaluation,
+    // nor with ILS on several threads, which race to share their best vector).
+    string cacheKey, cachedValue;
+    bool isRepeatable = !(memoCapacity > 0 && memoQuantum > 0) && !(numOfThreads > 1 && isAlgorithmSelected(ALG_ITERATIVE_LOCAL_SEARCH));
+    if(resultCache != NULL && isSeeded && isRepeatable)
+    {
+        cacheKey = searchCacheKey(data, functionIndex);
+        SearchAlgorithmResults cachedResults;
+        if(resultCache->lookup(cacheKey, cachedValue))
+        {
+            istringstream cached(cachedValue);
+            if(readBinary(cached, cachedResults) && cachedResults.functionID == functionID)
+                return cachedResults;
+        }
+    }
+
+    // Give the searches on this function their own random stream if the run is seeded.
+    if(isSeeded)
+        setRandomSeed(streamSeed(functionIndex, SEED_STREAM_SEARCH));
+
+    // Remember the fitness of the vectors the searches evaluate, if asked to. The memo is
+    // only installed on this thread (and the searches' workers), until the searches return.
+    unique_ptr<FitnessMemo> memo;
+    if(memoCapacity > 0 && functionIsExpensive(functionID))
+        memo.reset(new FitnessMemo(memoCapacity, columns, memoQuantum));
+    FitnessMemoScope memoScope(memo.get());
+
+    // Declare a SearchAlgorithmResults variable.
+    SearchAlgorithmResults algResults;
+    algResults.functionID = functionID;
+
+    // ------------------------------------------------------------------------------
+    // ---------- BLIND SEARCH ----------
+    if(isAlgorithmSelected(ALG_BLIND_SEARCH))
+    {
+        // Build the table of the function's terms, if one was asked for.
+        TermTable table(functionID, minBound, maxBound, termTableInterpolation, termTableError);
+        if(termTableInterpolation != TERM_TABLE_OFF && TermTable::supports(functionID) && !table.isUsable())
+            cout << "The term table of Function " << functionID << " can't reach an error of " << termTableError << ", using the exact terms." << endl;
+
+        // Record the start and end time.
+        startTime = chrono::high_resolution_clock::now();
+        algResults.fitnessBS = blindSearch(iterations, bestVect, bestFitness, functionID, rows, columns, minBound, maxBound, samplerType,
+                                           table.isUsable() ? &table : nullptr);
+        endTime = chrono::high_resolution_clock::now();
+
+        // Calculate elapsed time in milliseconds.
+        elapsedTime = endTime - startTime;
+        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
+        algResults.timeBS = elapsedTimeMS;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ---------- LOCAL SEARCH ----------
+    if(isAlgorithmSelected(ALG_LOCAL_SEARCH))
+    {
+        // Record the start and end time.
+        startTime = chrono::high_resolution_clock::now();
+        algResults.fitnessLS = localSearch(bestVect, functionID, alpha, evaluations, localSearchMode);
+        endTime = chrono::high_resolution_clock::now();
+
+        // Calculate elapsed time in milliseconds, and the evaluation throughput.
+        elapsedTime = endTime - startTime;
+        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
+        algResults.timeLS = elapsedTimeMS;
+        elapsedTimeSec = chrono::duration_cast<chrono::duration<double>>(elapsedTime).count();
+        algResults.evalsPerSecLS = (elapsedTimeSec > 0) ? evaluations / elapsedTimeSec : 0.0;
+        algResults.evaluationsLS = evaluations;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ----- ITERATIVE LOCAL SEARCH -----
+    if(isAlgorithmSelected(ALG_ITERATIVE_LOCAL_SEARCH))
+    {
+        // Record the start and end time.
+        startTime = chrono::high_resolution_clock::now();
+        algResults.fitnessILS = iterativeLocalSearch(iterations, bestVect, functionID, alpha, minBound, maxBound, numOfThreads, evaluations,
+                                                     samplerType, localSearchMode);
+        endTime = chrono::high_resolution_clock::now();
+
+        // Sort the resulting list of fitness values.
+        quicksort(algResults.fitnessILS, 0, algResults.fitnessILS.size()-1);
+
+        // Calculate elapsed time in milliseconds, and the evaluation throughput.
+        elapsedTime = endTime - startTime;
+        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
+        algResults.timeILS = elapsedTimeMS;
+        elapsedTimeSec = chrono::duration_cast<chrono::duration<double>>(elapsedTime).count();
+        algResults.evalsPerSecILS = (elapsedTimeSec > 0) ? evaluations / elapsedTimeSec : 0.0;
+        algResults.evaluationsILS = evaluations;
+    }
+
+    // ------------------------------------------------------------------------------
+    // -- PARTICLE SWARM OPTIMIZATION ---
+    if(isAlgorithmSelected(ALG_PARTICLE_SWARM))
+    {
+        // Record the start and end time.
+        startTime = chrono::high_resolution_clock::now();
+        algResults.fitnessPSO = particleSwarmOptimization(iterations, rows, functionID, columns, minBound, maxBound, numOfThreads, evaluations);
+        endTime = chrono::high_resolution_clock::now();
+
+        // Sort the resulting list of fitness values.
+        quicksort(algResults.fitnessPSO, 0, algResults.fitnessPSO.size()-1);
+
+        // Calculate elapsed time in milliseconds, and the evaluation throughput.
+        elapsedTime = endTime - startTime;
+        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
+        algResults.timePSO = elapsedTimeMS;
+        elapsedTimeSec = chrono::duration_cast<chrono::duration<double>>(elapsedTime).count();
+        algResults.evalsPerSecPSO = (elapsedTimeSec > 0) ? evaluations / elapsedTimeSec : 0.0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ------ SIMULATED ANNEALING -------
+    if(isAlgorithmSelected(ALG_SIMULATED_ANNEALING))
+    {
+        // Record the start and end time.
+        long long movesPerChain = (long long)iterations * columns * SA_MOVES_PER_DIMENSION;
+        startTime = chrono::high_resolution_clock::now();
+        algResults.fitnessSA = simulatedAnnealing(rows, movesPerChain, functionID, columns, minBound, maxBound, coolingSchedule, numOfThreads, evaluations);
+        endTime = chrono::high_resolution_clock::now();
+
+        // Sort the resulting list of fitness values.
+        quicksort(algResults.fitnessSA, 0, algResults.fitnessSA.size()-1);
+
+        // Calculate elapsed time in milliseconds, and the move throughput.
+        elapsedTime = endTime - startTime;
+        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
+        algResults.timeSA = elapsedTimeMS;
+        elapsedTimeSec = chrono::duration_cast<chrono::duration<double>>(elapsedTime).count();
+        algResults.evalsPerSecSA = (elapsedTimeSec > 0) ? evaluations / elapsedTimeSec : 0.0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ------------- CMA-ES -------------
+    if(isAlgorithmSelected(ALG_CMAES))
+    {
+        // Record the start and end time.
+        generations = iterations * CMAES_GENERATIONS_PER_ITERATION;
+        startTime = chrono::high_resolution_clock::now();
+        algResults.fitnessCMAES = covarianceMatrixAdaptation(generations, functionID, columns, minBound, maxBound, numOfThreads, evaluations);
+        endTime = chrono::high_resolution_clock::now();
+
+        // Sort the resulting list of fitness values.
+        quicksort(algResults.fitnessCMAES, 0, algResults.fitnessCMAES.size()-1);
+
+        // Calculate elapsed time in milliseconds, and the evaluation throughput.
+        elapsedTime = endTime - startTime;
+        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
+        algResults.timeCMAES = elapsedTimeMS;
+        elapsedTimeSec = chrono::duration_cast<chrono::duration<double>>(elapsedTime).count();
+        algResults.evalsPerSecCMAES = (elapsedTimeSec > 0) ? evaluations / elapsedTimeSec : 0.0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ------- GENETIC ALGORITHM --------
+    if(isAlgorithmSelected(ALG_GENETIC))
+    {
+        // Record the start and end time.
+        generations = iterations * GA_GENERATIONS_PER_ITERATION;
+        startTime = chrono::high_resolution_clock::now();
+        algResults.fitnessGA = geneticAlgorithm(generations, rows, functionID, columns, minBound, maxBound, searchCrossoverType, numOfThreads, evaluations);
+        endTime = chrono::high_resolution_clock::now();
+
+        // Sort the resulting list of fitness values.
+        quicksort(algResults.fitnessGA, 0, algResults.fitnessGA.size()-1);
+
+        // Calculate elapsed time in milliseconds, and the evaluation throughput.
+        elapsedTime = endTime - startTime;
+        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
+        algResults.timeGA = elapsedTimeMS;
+        elapsedTimeSec = chrono::duration_cast<chrono::duration<double>>(elapsedTime).count();
+        algResults.evalsPerSecGA = (elapsedTimeSec > 0) ? evaluations / elapsedTimeSec : 0.0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ------ DECOMPOSITION SEARCH ------
+    if(isAlgorithmSelected(ALG_DECOMPOSITION))
+    {
+        // Record the start and end time.
+        startTime = chrono::high_resolution_clock::now();
+        algResults.fitnessDS = decompositionSearch(iterations, functionID, columns, minBound, maxBound, numOfThreads, evaluations);
+        endTime = chrono::high_resolution_clock::now();
+
+        // Sort the resulting list of fitness values.
+        quicksort(algResults.fitnessDS, 0, algResults.fitnessDS.size()-1);
+
+        // Calculate elapsed time in milliseconds, and the evaluation throughput.
+        elapsedTime = endTime - startTime;
+        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
+        algResults.timeDS = elapsedTimeMS;
+        elapsedTimeSec = chrono::duration_cast<chrono::duration<double>>(elapsedTime).count();
+        algResults.evalsPerSecDS = (elapsedTimeSec > 0) ? evaluations / elapsedTimeSec : 0.0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ------------- L-BFGS -------------
+    if(isAlgorithmSelected(ALG_LBFGS))
+    {
+        // Record the start and end time.
+        startTime = chrono::high_resolution_clock::now();
+        algResults.fitnessLBFGS = limitedMemoryBFGS(iterations, functionID, columns, minBound, maxBound, numOfThreads, evaluations);
+        endTime = chrono::high_resolution_clock::now();
+
+        // Sort the resulting list of fitness values.
+        quicksort(algResults.fitnessLBFGS, 0, algResults.fitnessLBFGS.size()-1);
+
+        // Calculate elapsed time in milliseconds, and the evaluation throughput.
+        elapsedTime = endTime - startTime;
+        elapsedTimeMS = chrono::duration_cast<chrono::milliseconds>(elapsedTime).count();
+        algResults.timeLBFGS = elapsedTimeMS;
+        elapsedTimeSec = chrono::duration_cast<chrono::duration<double>>(elapsedTime).count();
+        algResults.evalsPerSecLBFGS = (elapsedTimeSec > 0) ? evaluations / elapsedTimeSec : 0.0;
+    }
+
+    // Report how much the memo saved.
+    if(memo)
+    {
+        long long lookups = memo->getLookups(), hits = memo->getHits();
+        cout << "Function " << functionID << ": fitness memo hit " << hits << " of " << lookups << " lookups ("
+             << fixed << setprecision(2) << (lookups > 0 ? 100.0 * hits / lookups : 0.0) << "%), "
+             << memo->getEvictions() << " evictions" << defaultfloat << endl;
+    }
+
+    // Keep the results for the next run that repeats these searches.
+    if(!cacheKey.empty())
+    {
+        ostringstream value;
+        writeBinary(value, algResults);
+        resultCache->store(cacheKey, value.str());
+    }
+
+    return algResults;
+}
+
+/**
+ * @brief Returns the seed of one of a function's random streams.
+ * @param functionIndex The position of the function in resultsOfFunctions.
+ * @param stream One of the SEED_STREAM_ constants.
+ * @return A seed derived from the run seed, the number of dimensions, the function and the stream.
+ */
+unsigned int ProcessFunctions::streamSeed(int functionIndex, int stream)
+{
+    seed_seq seeds{runSeed, (unsigned int)numOfDimensions, (unsigned int)functionIndex, (unsigned int)stream};
+    unsigned int seed;
+    seeds.generate(&seed, &seed + 1);
+    return seed;
+}
+
+/**
+ * @brief Returns the full specification of the searches on a function, for the result cache.
+ *
+ * The searches depend on the build, the function, its bounds and matrix
+ * (the best vector of the matrix is where the single-point searches start),
+ * the search configuration, the number of threads, the sampler, the Local
+ * Search mode, the term table and the function's search stream.
+ *
+ * @param data The FunctionData structure, with its fitness calculated and sorted.
+ * @param functionIndex The position of the function in the configuration file.
+ *
+ * @return The key of the searches' results.
+ */
+string ProcessFunctions::searchCacheKey(FunctionData &data, int functionIndex)
+{
+    ostringstream key;
+    key << setprecision(17) << "search," << ResultCache::buildVersion() << "," << numOfDimensions << "," << data.functionID << ","
+        << data.minBound << "," << data.maxBound << "," << hex << hashMatrix(data.functionMatrix) << dec << ","
+        << searchIterations << "," << searchAlpha << "," << searchCoolingSchedule << "," << searchCrossoverType << ",";
+    for(int i = 0; i < selectedAlgorithms.size(); i++)
+        key << selectedAlgorithms[i] << ";";
+    key << "," << numOfThreads << "," << samplerType << "," << localSearchMode << "," << termTableInterpolation << ","
+        << termTableError << "," << streamSeed(functionIndex, SEED_STREAM_SEARCH);
+    return key.str();
+}
+
+/**
+ * @brief Saves the finished work to the checkpoint file.
+ *
+ * The checkpoint is written under a temporary name and then renamed, so a
+ * crash while saving leaves the previous checkpoint intact. The output files
+ * handed to the background writer are on disk first, so a resumed run never
+ * skips work whose files were lost; if any of them failed the checkpoint
+ * isn't saved.
+ *
+ * @note This function makes a call to AsyncWriter.h --> drain().
+ *
+ * @return True if the checkpoint was saved, false otherwise.
+ */
+bool ProcessFunctions::saveCheckpoint()
+{
+    if(outputWriter != NULL && !outputWriter->drain())
+        return false;
+
+    string partialFilename = checkpointFilename + ".tmp";
+    ofstream outputFile;
+    outputFile.open(partialFilename, ios::binary | ios::trunc);
+    if(outputFile.fail())
+        return false;
+
+    outputFile.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    writeBinary(outputFile, runSeed);
+    writeBinary(outputFile, (unsigned int)completedDimensions.size());
+    for(int i = 0; i < completedDimensions.size(); i++)
+        writeBinary(outputFile, completedDimensions[i]);
+    writeBinary(outputFile, numOfDimensions);
+    writeBinary(outputFile, (unsigned int)searchAlgResults.size());
+    for(int i = 0; i < searchAlgResults.size(); i++)
+        writeBinary(outputFile, searchAlgResults[i]);
+    outputFile.close();
+
+    return !outputFile.fail() && rename(partialFilename.c_str(), checkpointFilename.c_str()) == 0;
+}
+
 /**
  * @brief Saves the matrix of the FunctionData to file.
  *
@@ -953,9 +2287,8 @@ void ProcessFunctions::saveFunctionMatrixToFile(string filename, FunctionData &d
     int rows = data.functionMatrix.size();
     int columns = data.functionMatrix[0].size();
 
-    // Create the file to where the matrix is saved.
-    ofstream outputFile;
-    outputFile.open (filename);
+    // Build the file in memory, saveOutput() writes it out.
+    ostringstream outputFile;
 
     // Save data to file.
     string line = "";
@@ -978,8 +2311,111 @@ void ProcessFunctions::saveFunctionMatrixToFile(string filename, FunctionData &d
         line = "";
     }
 
-    // Close the file.
-    outputFile.close();
+    // Write the file (in the background if there is an output writer).
+    saveOutput(filename, outputFile.str());
+}
+
+/**
+ * @brief Saves the data of one FunctionData structure to its file.
+ *
+ * @note This function makes a call to utilities.h --> parseStringStr().
+ *
+ * @param configFilename The configuration file from which data was generated.
+ * @param data The FunctionData structure to save.
+ */
+void ProcessFunctions::saveProcessedFunctionDataToFile(string configFilename, FunctionData &data)
+{
+    // Split the configuration filename based on the dot (.) delimiter.
+    vector<string> splitConfig = parseStringStr(configFilename, ".");
+
+    // Set the beginning of filename based on the number of dimensions.
+    string filenameBegin = splitConfig[0] + "-";
+    filenameBegin += to_string(numOfDimensions);
+    filenameBegin += "Dimensional-";
+
+    // Initialize the filename with the beginning.
+    string filename = filenameBegin;
+    int funcID = data.functionID;
+
+    // Save with filename referenced by function IDs.
+    switch(funcID)
+    {
+        case 1:
+            filename += out_schefelsFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 2:
+            filename += out_deJongsFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 3:
+            filename += out_rosenbrockFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 4:
+            filename += out_rastriginFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 5:
+            filename += out_griewangkFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 6:
+            filename += out_sEnvSWaveFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 7:
+            filename += out_strchVSinWaveFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 8:
+            filename += out_ackleys1Filename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 9:
+            filename += out_ackleys2Filename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 10:
+            filename += out_eggHolderFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 11:
+            filename += out_ranaFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 12:
+            filename += out_pathologicalFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 13:
+            filename += out_michalewiczFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 14:
+            filename += out_mastersCosWaveFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 15:
+            filename += out_quarticFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 16:
+            filename += out_levyFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 17:
+            filename += out_stepFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        case 18:
+            filename += out_alpineFilename;
+            saveAllFunctionDataToFile(filename, data);
+            break;
+        default:
+            cout << "Cannot Save Function Results for FunctionData->Function ID: " << funcID << endl;
+            break;
+    }
 }
 
 /**
@@ -997,9 +2433,8 @@ void ProcessFunctions::saveAllFunctionDataToFile(string filename, FunctionData &
     int rows = data.fitness.size();                 // Fitness dictates the number of rows.
     int columns = data.functionMatrix[0].size();    // Matrix dictates the number of dimensions.
 
-    // Create the file to where the matrix is saved.
-    ofstream outputFile;
-    outputFile.open (filename);
+    // Build the file in memory, saveOutput() writes it out.
+    ostringstream outputFile;
 
     // Save the header to file First.
     string header = "Fitness,Vector\n";
@@ -1029,8 +2464,8 @@ void ProcessFunctions::saveAllFunctionDataToFile(string filename, FunctionData &
         line = "";
     }
 
-    // Close the file.
-    outputFile.close();
+    // Write the file (in the background if there is an output writer).
+    saveOutput(filename, outputFile.str());
 }
 
 
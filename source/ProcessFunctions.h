@@ -12,11 +12,17 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <random>
 #include <chrono>
+#include <thread>
+#include <iomanip>
 #include "utilities.h"
 #include "DataStructs.h"
 #include "SearchAlgorithms.h"
+#include "BoundedQueue.h"
+#include "AsyncWriter.h"
+#include "ResultCache.h"
 
 using namespace std;
 
@@ -30,14 +36,37 @@ using namespace std;
 /** The default maximum boundary for the elements generated. */
 #define BOUNDARY_MAX 500.0
 
+/** Names used to select the search algorithms in SearchAlgorithmConfig.txt. */
+#define ALG_BLIND_SEARCH "BS"
+#define ALG_LOCAL_SEARCH "LS"
+#define ALG_ITERATIVE_LOCAL_SEARCH "ILS"
+#define ALG_PARTICLE_SWARM "PSO"
+#define ALG_SIMULATED_ANNEALING "SA"
+#define ALG_CMAES "CMAES"
+#define ALG_GENETIC "GA"
+#define ALG_DECOMPOSITION "DS"
+#define ALG_LBFGS "LBFGS"
+
+/** The first bytes of a checkpoint file, with the version of its format. */
+#define CHECKPOINT_MAGIC "BF2CKPT4"
+/** The random stream used to generate a function's matrix. */
+#define SEED_STREAM_MATRIX 0
+/** The random stream used by a function's search algorithms. */
+#define SEED_STREAM_SEARCH 1
+
+/** The number of functions each queue of the pipeline holds between two stages. */
+#define PIPELINE_QUEUE_CAPACITY 2
+
 class ProcessFunctions{
 public:
     // --------------------- Constructor Declarations ---------------------
-    ProcessFunctions(); // Sets the number of dimensions to 0;
+    ProcessFunctions(); // Sets the number of dimensions to 0 and threads to hardware concurrency;
 
     // --------------------- Functions Declarations ---------------------
     void setNumOfDimensions(int dimensions);    /**< Sets the number of dimensions.*/
     int getNumOfDimensions();                   /**< Returns the number of dimensions.*/
+    void setNumOfThreads(int threads);          /**< Sets the number of threads used by the multithreaded search algorithms.*/
+    int getNumOfThreads();                      /**< Returns the number of threads used by the multithreaded search algorithms.*/
 
     void constructMatrix();                                                      /**< Uses all default constants, or previously user-set dimensions.*/
     void constructMatrix(int funcID, double minBoundary, double maxBoundary);    /**< Uses default number of dimensions.*/
@@ -46,13 +75,36 @@ public:
     void analyzeAllFunctionResults();       /**< Analyzes all the results from resultsOfFunctions.*/
 
     void performAllSearchAlgorithms();          /**< Executes all the search algorithms.*/
+    void setSearchConfigFile(string filename);  /**< Sets the Search Algorithm configuration file (SearchAlgorithmConfig.txt by default).*/
+    bool readSearchAlgorithmConfig();           /**< Reads the Search Algorithm configuration file.*/
+    int getSearchIterations();                  /**< Returns the number of iterations read from the Search Algorithm configuration file.*/
+    double getSearchAlpha();                    /**< Returns the alpha value read from the Search Algorithm configuration file.*/
+    int getSearchCoolingSchedule();             /**< Returns the cooling schedule read from the Search Algorithm configuration file.*/
+    int getSearchCrossoverType();               /**< Returns the Genetic Algorithm crossover read from the Search Algorithm configuration file.*/
+    vector<string> getSelectedAlgorithms();     /**< Returns the algorithms selected to run (empty means all of them).*/
     void analyzeAllSearchAlgorithmResults();    /**< Analyzes all the results from the search algorithms.*/
+    void processAllFunctionsPipelined(vector<vector<double>> &functionSetups, string configFilename, bool saveFunctionData);  /**< Generates, evaluates, analyzes, searches and saves every function as a pipeline.*/
 
     void saveAllMatricesToFile(string configFilename);                      /**< Saves all the matrices in resultsOfFunctions to files.*/
     void saveAllProcessedFunctionDataToFile(string configFilename);    /**< Saves all the data in resultsOfFunctions to files.*/
     void saveAllAnalyzedDataToFile(string configFilename);             /**< Saves all analyzed data in analysis to file.*/
     void saveAllAnalyzedDataToSpecificFile(string filename);           /**< Saves all analyzed data in analysis to user-specified file.*/
     void saveAllAnalyzedSearchAlgDataToFile(string configFilename);    /**< Saves all analyzed data in searchAlgAnalysis to file.*/
+    bool saveSearchAlgResultsToFile(string filename);                 /**< Saves the raw results in searchAlgResults to file.*/
+    bool loadSearchAlgResultsFromFile(string filename);               /**< Adds the raw results saved in a file to searchAlgResults.*/
+
+    void setRunSeed(unsigned int seed);                 /**< Derives every random stream of the run from a seed, so the run can be repeated.*/
+    unsigned int getRunSeed();                          /**< Returns the seed of the run.*/
+    void setCheckpointFile(string filename);            /**< Saves a checkpoint after every function searched and every dimension completed.*/
+    bool resumeFromCheckpoint(string filename);         /**< Restores the run seed and the finished work from a checkpoint.*/
+    bool isDimensionCompleted(int dimensions);          /**< Checks if the results of a dimension were already saved.*/
+    void completeDimension();                           /**< Records that the results of the current dimension were saved.*/
+    void setOutputWriter(AsyncWriter *writer);          /**< Hands the output files to a background writer from now on.*/
+    void setSamplerType(int type);                      /**< Sets where the matrices and the random starts of the searches come from.*/
+    void setLocalSearchMode(int mode);                  /**< Sets the descent of Local Search and Iterative Local Search.*/
+    void setResultCache(ResultCache *cache);            /**< Takes the fitness of matrices and the results of seeded searches seen before from a cache.*/
+    void setTermTable(int interpolation, double maxError);  /**< Makes Blind Search interpolate the function's terms from a table.*/
+    void setFitnessMemo(long long capacity, double quantum);    /**< Makes the searches remember the fitness of the vectors they evaluate.*/
 
     void printAllFunctionIDs();             /**< Prints all the possible Function IDs to the screen.*/
     void printFunctionResults();            /**< Prints all the FunctionData structures in resultsOfFunctions.*/
@@ -61,21 +113,53 @@ public:
 private:
     // --------------------------- Variables ----------------------------
     int numOfDimensions;
+    int numOfThreads;
     vector<FunctionData> resultsOfFunctions;
     FunctionAnalysis analysis;
 
     vector<SearchAlgorithmResults> searchAlgResults;
     SearchAlgorithmResultsAnalysis searchAlgAnalysis;
+    string searchConfigFilename;
+    int searchIterations;
+    double searchAlpha;
+    int searchCoolingSchedule;
+    int searchCrossoverType;
+    vector<string> selectedAlgorithms;
+
+    bool isSeeded;
+    unsigned int runSeed;
+    string checkpointFilename;
+    vector<int> completedDimensions;
+    int restoredDimensions;
+    vector<SearchAlgorithmResults> restoredResults;
+    AsyncWriter *outputWriter;
+    ResultCache *resultCache;
+    int samplerType;
+    int localSearchMode;
+    int termTableInterpolation;
+    double termTableError;
+    long long memoCapacity;
+    double memoQuantum;
 
     // --------------------- Functions Declarations ---------------------
     FunctionData generateMatrix(double minBoundary, double maxBoundary);            /**< Generates a matrix using min/max boundaries.*/
+    bool generateFunctionMatrix(int funcID, double minBoundary, double maxBoundary, int functionIndex, FunctionData &funcData);    /**< Generates the matrix of a function from the configuration file.*/
 
     void calculateMatrixFitness(FunctionData &data);                                /**< Calculates the fitness of all vectors in matrix.*/
+    void evaluateMatrix(FunctionData &data);                                        /**< Calculates (or takes from the result cache), times and sorts the fitness of a matrix.*/
     void analyzeFunctionResults(FunctionData &data);                                /**< Analyzes the results of the functions.*/
     double getMinFitness(FunctionData &data);                                       /**< Returns the minimum fitness of data.*/
     double getMaxFitness(FunctionData &data);                                       /**< Returns the maximum fitness of data.*/
 
+    bool isAlgorithmSelected(string algorithm);                                     /**< Checks if a search algorithm was selected to run.*/
+    SearchAlgorithmResults performSearchAlgorithms(FunctionData &data, int functionIndex);  /**< Performs all the selected search algorithms on one function.*/
+    unsigned int streamSeed(int functionIndex, int stream);                         /**< Returns the seed of one of a function's random streams.*/
+    string searchCacheKey(FunctionData &data, int functionIndex);                   /**< Returns the full specification of the searches on a function, for the result cache.*/
+    bool saveCheckpoint();                                                          /**< Saves the finished work to the checkpoint file.*/
+
     void saveFunctionMatrixToFile(string filename, FunctionData &data);    /**< Saves the matrix to file.*/
+    void saveOutput(string filename, string contents);                   /**< Writes an output file, through the output writer if there is one.*/
+    void saveProcessedFunctionDataToFile(string configFilename, FunctionData &data);   /**< Saves the results of one function to its file.*/
     void saveAllFunctionDataToFile(string filename, FunctionData &data);   /**< Saves the results of the function and it's data to file.*/
 
     void quicksortFuncData(FunctionData &data, int L, int R);   /**< Special quicksort implementation.*/
@@ -0,0 +1,587 @@
+/**
+ * @file ResultCache.cpp
+ * @class ResultCache ResultCache.h "ResultCache.h"
+ * @author  Al Timofeyev
+ * @date    May 17, 2019
+ * @brief   An on-disk cache of results, kept across runs: an append-only
+ *          file of key/value records and a memory mapped hash index of it,
+ *          so a run that repeats a job (same specification, same build)
+ *          gets its result back instead of computing it again.
+ *
+ * The record file starts with RESULT_CACHE_MAGIC, followed by the records:
+ *      <key length (4 bytes)><value length (4 bytes)><checksum (8 bytes)><key><value>
+ * The key is the full specification of the job (the users of the cache put
+ * buildVersion() in it), and the value is the result, in whatever form the
+ * user saves it. Records are only ever appended.
+ *
+ * The index (filename.index) is an open addressing hash table, linearly
+ * probed, of the hash of every key and the offset of its record. It's mapped
+ * into memory, so a lookup is a few probes and one read of the record, and
+ * the full key of the record is compared, so a hash collision can't return
+ * another job's result. The index remembers how much of the record file it
+ * covers: records appended by another process (or left out of the index by
+ * a crash) are indexed by the next lookup, and a torn record at the end of
+ * the file (its checksum doesn't match) is overwritten by the next store.
+ * When the index is more than RESULT_CACHE_MAX_LOAD full it's rebuilt with
+ * twice the slots under a temporary name and renamed over the old one, and
+ * the other processes notice the new file and map it.
+ *
+ * Every lookup and store holds an exclusive lock on the record file, so
+ * workers in separate processes can share a cache.
+ */
+
+#include "ResultCache.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstring>
+#define RESULT_CACHE_HAS_MMAP
+#endif
+
+/** The size of the header of every record (the lengths and the checksum). */
+static const size_t recordHeaderSize = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+#ifdef RESULT_CACHE_HAS_MMAP
+/**
+ * @brief Holds the lock on the record file (and the lock of the threads) for as long as it lives.
+ */
+class ResultCacheLock{
+public:
+    ResultCacheLock(mutex &threadLock, int fd) : guard(threadLock), fd(fd)
+    {
+        while(flock(fd, LOCK_EX) != 0 && errno == EINTR);
+    }
+    ~ResultCacheLock()
+    {
+        flock(fd, LOCK_UN);
+    }
+private:
+    lock_guard<mutex> guard;
+    int fd;
+};
+
+/** Writes all of a buffer at offset, returns false if it couldn't. */
+static bool writeAll(int fd, const char *data, size_t size, off_t offset)
+{
+    while(size > 0)
+    {
+        ssize_t written = pwrite(fd, data, size, offset);
+        if(written < 0 && errno == EINTR)
+            continue;
+        if(written <= 0)
+            return false;
+        data += written;
+        size -= written;
+        offset += written;
+    }
+    return true;
+}
+
+/** Reads all of a buffer from offset, returns false if the file ends first. */
+static bool readAll(int fd, char *data, size_t size, off_t offset)
+{
+    while(size > 0)
+    {
+        ssize_t read = pread(fd, data, size, offset);
+        if(read < 0 && errno == EINTR)
+            continue;
+        if(read <= 0)
+            return false;
+        data += read;
+        size -= read;
+        offset += read;
+    }
+    return true;
+}
+#endif
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief The constructor for the ResultCache class, the cache is closed until open() is called.
+ */
+ResultCache::ResultCache()
+{
+    dataFd = -1;
+    indexFd = -1;
+    index = nullptr;
+    indexSize = 0;
+    indexInode = 0;
+    hits = 0;
+    misses = 0;
+}
+
+/**
+ * @brief The destructor for the ResultCache class, unmaps the index and closes the files.
+ */
+ResultCache::~ResultCache()
+{
+#ifdef RESULT_CACHE_HAS_MMAP
+    unmapIndex();
+    if(dataFd >= 0)
+        close(dataFd);
+#endif
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PUBLIC FUNCTIONS BELOW ------------------
+// ----------------------------------------------------------
+/**
+ * @brief Opens the cache, creating the record file and the index if they don't exist.
+ *
+ * @param filename The record file, the index is filename.index.
+ *
+ * @return True if the cache was opened, false (after notifying the user) otherwise.
+ */
+bool ResultCache::open(string filename)
+{
+#ifdef RESULT_CACHE_HAS_MMAP
+    this->filename = filename;
+    indexFilename = filename + RESULT_CACHE_INDEX_EXTENSION;
+
+    dataFd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if(dataFd < 0)
+    {
+        cout << "Failed to open the result cache: " << filename << endl;
+        return false;
+    }
+
+    bool isOk;
+    {
+        ResultCacheLock lock(cacheLock, dataFd);
+
+        // A new file gets the magic, an existing one must start with it.
+        struct stat dataStat;
+        char magic[sizeof(RESULT_CACHE_MAGIC) - 1];
+        if(fstat(dataFd, &dataStat) == 0 && dataStat.st_size == 0)
+            isOk = writeAll(dataFd, RESULT_CACHE_MAGIC, sizeof(magic), 0);
+        else
+            isOk = readAll(dataFd, magic, sizeof(magic), 0) && memcmp(magic, RESULT_CACHE_MAGIC, sizeof(magic)) == 0;
+
+        isOk = isOk && mapIndex() && refreshIndex();
+    }
+    if(!isOk)
+    {
+        cout << "Not a usable result cache: " << filename << endl;
+        unmapIndex();
+        close(dataFd);
+        dataFd = -1;
+    }
+    return isOk;
+#else
+    cout << "The result cache needs memory mapped files, running without it." << endl;
+    return false;
+#endif
+}
+
+/**
+ * @brief Checks if the cache was opened.
+ * @return True if open() succeeded.
+ */
+bool ResultCache::isOpen()
+{
+    return index != nullptr;
+}
+
+/**
+ * @brief Finds the value stored under a key.
+ *
+ * @param key The full specification of the job.
+ * @param value Set to the value stored under the key, if there is one.
+ *
+ * @return True if a value was found, false otherwise (or if the cache isn't open).
+ */
+bool ResultCache::lookup(const string &key, string &value)
+{
+#ifdef RESULT_CACHE_HAS_MMAP
+    if(!isOpen())
+        return false;
+
+    ResultCacheLock lock(cacheLock, dataFd);
+    bool isFound = refreshIndex() && findRecord(key, value);
+    if(isFound)
+        hits++;
+    else
+        misses++;
+    return isFound;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Appends a value to the record file and indexes it.
+ *
+ * If the key is already in the cache (another process stored it first) the
+ * value already there is kept.
+ *
+ * @param key The full specification of the job.
+ * @param value The result of the job.
+ *
+ * @return True if the key is in the cache afterwards, false otherwise.
+ */
+bool ResultCache::store(const string &key, const string &value)
+{
+#ifdef RESULT_CACHE_HAS_MMAP
+    if(!isOpen())
+        return false;
+
+    ResultCacheLock lock(cacheLock, dataFd);
+    string existing;
+    if(!refreshIndex())
+        return false;
+    if(findRecord(key, existing))
+        return true;
+
+    // Build the record.
+    uint32_t keyLength = key.size(), valueLength = value.size();
+    uint64_t checksum = hashBytes(value.data(), value.size(), hashBytes(key.data(), key.size()));
+    string record(recordHeaderSize, '\0');
+    memcpy(&record[0], &keyLength, sizeof(keyLength));
+    memcpy(&record[sizeof(keyLength)], &valueLength, sizeof(valueLength));
+    memcpy(&record[2 * sizeof(uint32_t)], &checksum, sizeof(checksum));
+    record += key;
+    record += value;
+
+    // Append it after the indexed records, dropping a torn record left there by a crash.
+    uint64_t offset = index->indexedLength;
+    struct stat dataStat;
+    if(fstat(dataFd, &dataStat) != 0 || ((uint64_t)dataStat.st_size > offset && ftruncate(dataFd, offset) != 0))
+        return false;
+    if(!writeAll(dataFd, record.data(), record.size(), offset))
+        return false;
+
+    insertSlot(hashBytes(key.data(), key.size()), offset);
+    index->indexedLength = offset + record.size();
+    if(index->entries > RESULT_CACHE_MAX_LOAD * index->slots)
+        createIndex(index->slots * 2);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Returns the number of lookups that found a value.
+ * @return The number of hits.
+ */
+long long ResultCache::getHits()
+{
+    return hits;
+}
+
+/**
+ * @brief Returns the number of lookups that didn't find a value.
+ * @return The number of misses.
+ */
+long long ResultCache::getMisses()
+{
+    return misses;
+}
+
+/**
+ * @brief Returns a string that changes whenever the program is rebuilt differently.
+ *
+ * It's the hash of the running executable (read once), so rebuilding with
+ * any change to the code or the compiler flags makes every cached result a
+ * miss, while rebuilding the same code keeps them. Where the executable
+ * can't be read it's the time this file was compiled.
+ *
+ * @return The build version, as a hexadecimal string.
+ */
+string ResultCache::buildVersion()
+{
+    static const string version = []()
+    {
+        uint64_t hash = hashBytes(nullptr, 0);
+        ifstream executable("/proc/self/exe", ios::binary);
+        vector<char> buffer(1 << 16);
+        bool isRead = false;
+        while(executable.read(buffer.data(), buffer.size()) || executable.gcount() > 0)
+        {
+            hash = hashBytes(buffer.data(), executable.gcount(), hash);
+            isRead = true;
+        }
+        if(!isRead)
+        {
+            string compiled = __DATE__ " " __TIME__;
+            hash = hashBytes(compiled.data(), compiled.size());
+        }
+
+        ostringstream hex;
+        hex << std::hex << hash;
+        return hex.str();
+    }();
+    return version;
+}
+
+/**
+ * @brief Hashes bytes with 64-bit FNV-1a.
+ *
+ * @param data The bytes to hash.
+ * @param size The number of bytes.
+ * @param hash The hash to continue from (the FNV offset basis to start a new one).
+ *
+ * @return The hash.
+ */
+uint64_t ResultCache::hashBytes(const void *data, size_t size, uint64_t hash)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for(size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PRIVATE FUNCTIONS BELOW -----------------
+// ----------------------------------------------------------
+/**
+ * @brief Maps the index file, creating a new one if it isn't there or isn't valid.
+ *
+ * @note Called with the record file locked.
+ *
+ * @return True if an index is mapped, false otherwise.
+ */
+bool ResultCache::mapIndex()
+{
+#ifdef RESULT_CACHE_HAS_MMAP
+    indexFd = ::open(indexFilename.c_str(), O_RDWR);
+    struct stat indexStat;
+    if(indexFd >= 0 && fstat(indexFd, &indexStat) == 0 && indexStat.st_size >= (off_t)sizeof(ResultCacheIndexHeader))
+    {
+        indexSize = indexStat.st_size;
+        void *mapping = mmap(nullptr, indexSize, PROT_READ | PROT_WRITE, MAP_SHARED, indexFd, 0);
+        if(mapping != MAP_FAILED)
+        {
+            index = (ResultCacheIndexHeader *)mapping;
+            indexInode = indexStat.st_ino;
+
+            // Keep the index if it's whole and covers no more than the record file.
+            struct stat dataStat;
+            uint64_t slots = index->slots;
+            if(memcmp(index->magic, RESULT_CACHE_INDEX_MAGIC, sizeof(index->magic)) == 0 && slots > 0 && (slots & (slots - 1)) == 0
+               && indexSize == sizeof(ResultCacheIndexHeader) + slots * sizeof(ResultCacheSlot)
+               && fstat(dataFd, &dataStat) == 0 && index->indexedLength <= (uint64_t)dataStat.st_size)
+                return true;
+        }
+    }
+
+    // Start a new index, refreshIndex() fills it from the record file.
+    unmapIndex();
+    return createIndex(RESULT_CACHE_INITIAL_SLOTS);
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Unmaps and closes the index file.
+ */
+void ResultCache::unmapIndex()
+{
+#ifdef RESULT_CACHE_HAS_MMAP
+    if(index != nullptr)
+        munmap(index, indexSize);
+    if(indexFd >= 0)
+        close(indexFd);
+    index = nullptr;
+    indexFd = -1;
+    indexSize = 0;
+#endif
+}
+
+/**
+ * @brief Replaces the index with a new one of the given size, holding the same records.
+ *
+ * The new index is written under a temporary name and renamed over the old
+ * one, so other processes keep a whole index mapped until they notice the
+ * new file. Without a current index, the new one is empty and covers none of
+ * the record file.
+ *
+ * @note Called with the record file locked.
+ *
+ * @param slots The number of slots of the new index, a power of two.
+ *
+ * @return True if the new index is mapped, false otherwise.
+ */
+bool ResultCache::createIndex(uint64_t slots)
+{
+#ifdef RESULT_CACHE_HAS_MMAP
+    string partialFilename = indexFilename + ".tmp";
+    int fd = ::open(partialFilename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    size_t size = sizeof(ResultCacheIndexHeader) + slots * sizeof(ResultCacheSlot);
+    if(fd < 0 || ftruncate(fd, size) != 0)
+    {
+        if(fd >= 0)
+            close(fd);
+        return false;
+    }
+    void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(mapping == MAP_FAILED)
+    {
+        close(fd);
+        return false;
+    }
+
+    // Fill in the header, and move the records of the current index over.
+    ResultCacheIndexHeader *oldIndex = index;
+    ResultCacheSlot *oldSlots = (ResultCacheSlot *)(oldIndex + 1);
+    index = (ResultCacheIndexHeader *)mapping;
+    memcpy(index->magic, RESULT_CACHE_INDEX_MAGIC, sizeof(index->magic));
+    index->slots = slots;
+    index->entries = 0;
+    index->indexedLength = sizeof(RESULT_CACHE_MAGIC) - 1;
+    if(oldIndex != nullptr)
+    {
+        for(uint64_t s = 0; s < oldIndex->slots; s++)
+            if(oldSlots[s].offset != 0)
+                insertSlot(oldSlots[s].hash, oldSlots[s].offset);
+        index->indexedLength = oldIndex->indexedLength;
+        munmap(oldIndex, indexSize);
+        close(indexFd);
+    }
+    indexFd = fd;
+    indexSize = size;
+
+    struct stat indexStat;
+    if(rename(partialFilename.c_str(), indexFilename.c_str()) != 0 || fstat(fd, &indexStat) != 0)
+    {
+        unmapIndex();
+        return false;
+    }
+    indexInode = indexStat.st_ino;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Brings the mapped index up to date with the files.
+ *
+ * If another process replaced the index file, the new one is mapped. Then
+ * the records appended to the record file since the index was last updated
+ * are indexed, up to the end of the file or the first torn record.
+ *
+ * @note Called with the record file locked.
+ *
+ * @return True if an index is mapped, false otherwise.
+ */
+bool ResultCache::refreshIndex()
+{
+#ifdef RESULT_CACHE_HAS_MMAP
+    struct stat indexStat, dataStat;
+    if(stat(indexFilename.c_str(), &indexStat) != 0 || (uint64_t)indexStat.st_ino != indexInode)
+    {
+        unmapIndex();
+        if(!mapIndex())
+            return false;
+    }
+
+    if(fstat(dataFd, &dataStat) != 0)
+        return false;
+    string key, value;
+    uint64_t offset = index->indexedLength, next;
+    while(offset < (uint64_t)dataStat.st_size && readRecord(offset, key, value, next))
+    {
+        insertSlot(hashBytes(key.data(), key.size()), offset);
+        index->indexedLength = offset = next;
+        if(index->entries > RESULT_CACHE_MAX_LOAD * index->slots && !createIndex(index->slots * 2))
+            return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Puts a record in the first free slot of its probe sequence.
+ * @param hash The hash of the record's key.
+ * @param offset Where the record starts in the record file.
+ */
+void ResultCache::insertSlot(uint64_t hash, uint64_t offset)
+{
+    ResultCacheSlot *slots = (ResultCacheSlot *)(index + 1);
+    uint64_t mask = index->slots - 1;
+    uint64_t s = hash & mask;
+    while(slots[s].offset != 0)
+        s = (s + 1) & mask;
+    slots[s].hash = hash;
+    slots[s].offset = offset;
+    index->entries++;
+}
+
+/**
+ * @brief Looks a key up in the index, and reads its value from the record file.
+ *
+ * @param key The key.
+ * @param value Set to the value of the key's record, if there is one.
+ *
+ * @return True if the key has a record, false otherwise.
+ */
+bool ResultCache::findRecord(const string &key, string &value)
+{
+    ResultCacheSlot *slots = (ResultCacheSlot *)(index + 1);
+    uint64_t mask = index->slots - 1;
+    uint64_t hash = hashBytes(key.data(), key.size());
+    string recordKey;
+    uint64_t next;
+    for(uint64_t s = hash & mask; slots[s].offset != 0; s = (s + 1) & mask)
+        if(slots[s].hash == hash && readRecord(slots[s].offset, recordKey, value, next) && recordKey == key)
+            return true;
+    return false;
+}
+
+/**
+ * @brief Reads the record at an offset of the record file, and checks it isn't torn.
+ *
+ * @param offset Where the record starts.
+ * @param key Set to the key of the record.
+ * @param value Set to the value of the record.
+ * @param next Set to where the next record starts.
+ *
+ * @return True if the whole record was read and its checksum matches, false otherwise.
+ */
+bool ResultCache::readRecord(uint64_t offset, string &key, string &value, uint64_t &next)
+{
+#ifdef RESULT_CACHE_HAS_MMAP
+    char header[recordHeaderSize];
+    uint32_t keyLength, valueLength;
+    uint64_t checksum;
+    if(!readAll(dataFd, header, recordHeaderSize, offset))
+        return false;
+    memcpy(&keyLength, header, sizeof(keyLength));
+    memcpy(&valueLength, header + sizeof(keyLength), sizeof(valueLength));
+    memcpy(&checksum, header + 2 * sizeof(uint32_t), sizeof(checksum));
+
+    // A torn header can hold any lengths, don't read past the end of the file.
+    struct stat dataStat;
+    if(fstat(dataFd, &dataStat) != 0 || offset + recordHeaderSize + keyLength + valueLength > (uint64_t)dataStat.st_size)
+        return false;
+
+    key.resize(keyLength);
+    value.resize(valueLength);
+    if(!readAll(dataFd, &key[0], keyLength, offset + recordHeaderSize) ||
+       !readAll(dataFd, &value[0], valueLength, offset + recordHeaderSize + keyLength))
+        return false;
+    if(hashBytes(value.data(), value.size(), hashBytes(key.data(), key.size())) != checksum)
+        return false;
+
+    next = offset + recordHeaderSize + keyLength + valueLength;
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,97 @@
+/**
+ * @file ResultCache.h
+ * @author  Al Timofeyev
+ * @date    May 17, 2019
+ * @brief   An on-disk cache of results, kept across runs: an append-only
+ *          file of key/value records and a memory mapped hash index of it,
+ *          so a run that repeats a job (same specification, same build)
+ *          gets its result back instead of computing it again.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_RESULTCACHE_H
+#define BENCHMARKFUNCTIONS2_RESULTCACHE_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** The first bytes of the record file. */
+#define RESULT_CACHE_MAGIC "BF2CACHE"
+/** The first bytes of the index file. */
+#define RESULT_CACHE_INDEX_MAGIC "BF2CIDX1"
+/** Appended to the name of the record file to name its index. */
+#define RESULT_CACHE_INDEX_EXTENSION ".index"
+/** The number of slots of a new index (a power of two). */
+#define RESULT_CACHE_INITIAL_SLOTS 1024
+/** The index doubles once more than this fraction of its slots are used. */
+#define RESULT_CACHE_MAX_LOAD 0.5
+
+/**
+ * @brief The header of the index file, followed by its slots.
+ */
+struct ResultCacheIndexHeader
+{
+    char magic[8];          /**< RESULT_CACHE_INDEX_MAGIC.*/
+    uint64_t slots;         /**< The number of slots, a power of two.*/
+    uint64_t entries;       /**< The number of used slots.*/
+    uint64_t indexedLength; /**< The length of the record file the index covers.*/
+};
+
+/**
+ * @brief One slot of the index: the hash of a key and where its record starts (0 if the slot is empty).
+ */
+struct ResultCacheSlot
+{
+    uint64_t hash;
+    uint64_t offset;
+};
+
+class ResultCache{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    ResultCache();
+    ~ResultCache();     // Unmaps the index and closes the files.
+
+    // --------------------- Functions Declarations ---------------------
+    bool open(string filename);                         /**< Opens (or creates) the cache in filename and filename.index.*/
+    bool isOpen();                                      /**< Checks if the cache was opened.*/
+    bool lookup(const string &key, string &value);      /**< Finds the value stored under key, returns false if there's none.*/
+    bool store(const string &key, const string &value); /**< Stores a value under key (the first value stored under a key is kept).*/
+    long long getHits();                                /**< Returns the number of lookups that found a value.*/
+    long long getMisses();                              /**< Returns the number of lookups that didn't.*/
+
+    static string buildVersion();                       /**< Returns a string that changes whenever the program is rebuilt differently.*/
+    static uint64_t hashBytes(const void *data, size_t size, uint64_t hash = 14695981039346656037ULL);  /**< 64-bit FNV-1a.*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    string filename;
+    string indexFilename;
+    int dataFd;
+    int indexFd;
+    ResultCacheIndexHeader *index;      /**< The mapped index file, its slots follow the header.*/
+    size_t indexSize;
+    uint64_t indexInode;                /**< The index file that is mapped, another process may have replaced it.*/
+    mutex cacheLock;                    /**< The file lock is per process, this one is for the threads of this one.*/
+    long long hits;
+    long long misses;
+
+    // --------------------- Functions Declarations ---------------------
+    bool mapIndex();                                        /**< Maps the index file, creating it if it isn't there or isn't valid.*/
+    void unmapIndex();                                      /**< Unmaps and closes the index file.*/
+    bool createIndex(uint64_t slots);                       /**< Replaces the index with one of the given size, holding the same records.*/
+    bool refreshIndex();                                    /**< Remaps a replaced index and indexes the records appended since.*/
+    void insertSlot(uint64_t hash, uint64_t offset);        /**< Puts a record in the first free slot of its probe sequence.*/
+    bool findRecord(const string &key, string &value);      /**< Looks a key up in the index.*/
+    bool readRecord(uint64_t offset, string &key, string &value, uint64_t &next);  /**< Reads and checks the record at offset.*/
+};
+
+
+#endif //BENCHMARKFUNCTIONS2_RESULTCACHE_H
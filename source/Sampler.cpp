@@ -0,0 +1,482 @@
+/**
+ * @file Sampler.cpp
+ * @class Sampler Sampler.h "Sampler.h"
+ * @author  Al Timofeyev
+ * @date    May 15, 2019
+ * @brief   Draws the points of the search space: pseudo-random (Mersenne
+ *          Twister, like createMatrix()), or from a scrambled Sobol,
+ *          Halton or Latin hypercube sequence, which cover the space much
+ *          more evenly for the same number of points.
+ *
+ * Every point of the quasi-random samplers is a function of its index, the
+ * seed and nothing else, so skipping ahead costs nothing: workers given the
+ * same seed can each skip to their own range of indices and draw disjoint
+ * parts of one sequence without talking to each other.
+ *
+ * Sobol: the direction numbers come from primitive polynomials over GF(2)
+ * (found on first use) with initial direction numbers drawn from a fixed
+ * generator, so the unscrambled sequence is always the same. The seed picks
+ * a random lower triangular matrix per dimension, applied to the direction
+ * numbers (so it costs nothing per point), and a random digital shift.
+ *
+ * Halton: dimension d is the radical inverse of index + 1 in the d-th prime,
+ * rotated by a random shift picked by the seed.
+ *
+ * Latin hypercube: points [k * numPoints, (k + 1) * numPoints) are one design,
+ * in which every dimension has exactly one point in each of its numPoints
+ * strata. The stratum of a point is a hashed permutation of its index, so no
+ * design is ever stored.
+ *
+ * Above SAMPLER_MAX_QUASI_DIMENSIONS, Sobol and Halton coordinates are padded
+ * with hashed random ones.
+ */
+
+#include "Sampler.h"
+
+vector<uint32_t> Sampler::primitivePolynomials;
+vector<int> Sampler::primes;
+mutex Sampler::tablesLock;
+
+// **********************************************************************************
+// ********************************** HASH HELPERS **********************************
+// **********************************************************************************
+/**
+ * @brief Mixes the bits of a 64 bit number (the SplitMix64 finalizer).
+ * @param x The number.
+ * @return The mixed number.
+ */
+static inline uint64_t mixBits(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Hashes a key and an index to a number in [0, 1).
+ * @param key The key.
+ * @param index The index.
+ * @return The number.
+ */
+static inline double hashToUnit(uint64_t key, uint64_t index)
+{
+    return (mixBits(key ^ mixBits(index)) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Returns where a permutation of [0, length), picked by key, sends index.
+ *
+ * A hashed bijection of the smallest power of two above length, repeated
+ * until the index falls back inside [0, length) (Kensler's permutation).
+ *
+ * @param index The index to permute, less than length.
+ * @param length The number of indices.
+ * @param key Picks the permutation.
+ *
+ * @return The permuted index.
+ */
+static uint32_t permuteIndex(uint32_t index, uint32_t length, uint32_t key)
+{
+    uint32_t w = length - 1;
+    w |= w >> 1;
+    w |= w >> 2;
+    w |= w >> 4;
+    w |= w >> 8;
+    w |= w >> 16;
+    do
+    {
+        index ^= key;             index *= 0xe170893d;
+        index ^= key >> 16;       index ^= (index & w) >> 4;
+        index ^= key >> 8;        index *= 0x0929eb3f;
+        index ^= key >> 23;       index ^= (index & w) >> 1;
+        index *= 1 | key >> 27;   index *= 0x6935fa69;
+        index ^= (index & w) >> 11;   index *= 0x74dcb303;
+        index ^= (index & w) >> 2;    index *= 0x9e501cc3;
+        index ^= (index & w) >> 2;    index *= 0xc860a3df;
+        index &= w;
+        index ^= index >> 5;
+    } while(index >= length);
+    return (index + key) % length;
+}
+
+/**
+ * @brief Multiplies two polynomials over GF(2), modulo a polynomial of the given degree.
+ * @param a, b The polynomials (bit i is the coefficient of x^i), of lower degree than p.
+ * @param p The modulus.
+ * @param degree The degree of p.
+ * @return The product modulo p.
+ */
+static uint64_t multiplyMod(uint64_t a, uint64_t b, uint64_t p, int degree)
+{
+    uint64_t product = 0;
+    for(; b != 0; b >>= 1)
+    {
+        if(b & 1)
+            product ^= a;
+        a <<= 1;
+        if((a >> degree) & 1)
+            a ^= p;
+    }
+    return product;
+}
+
+/**
+ * @brief Checks if a polynomial over GF(2) is primitive: x has order 2^degree - 1 modulo it.
+ * @param p The polynomial (bit i is the coefficient of x^i).
+ * @param degree The degree of p.
+ * @param factors The prime factors of 2^degree - 1.
+ * @return True if p is primitive, false otherwise.
+ */
+static bool isPrimitive(uint64_t p, int degree, vector<uint64_t> &factors)
+{
+    auto power = [p, degree](uint64_t exponent)
+    {
+        uint64_t result = 1, base = degree > 1 ? 2 : 1;    // x, reduced modulo p.
+        for(; exponent != 0; exponent >>= 1)
+        {
+            if(exponent & 1)
+                result = multiplyMod(result, base, p, degree);
+            base = multiplyMod(base, base, p, degree);
+        }
+        return result;
+    };
+
+    uint64_t order = (1ULL << degree) - 1;
+    if(power(order) != 1)
+        return false;
+    for(int f = 0; f < factors.size(); f++)
+        if(power(order / factors[f]) == 1)
+            return false;
+    return true;
+}
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief The constructor for the Sampler class.
+ * @param type          SAMPLER_RANDOM, SAMPLER_SOBOL, SAMPLER_HALTON or SAMPLER_LATIN_HYPERCUBE.
+ * @param dimensions    The number of elements of each point.
+ * @param numPoints     The number of points in a Latin hypercube design (the points a search will draw).
+ * @param seed          The seed of the generator, or of the scrambling.
+ */
+Sampler::Sampler(int type, int dimensions, long long numPoints, unsigned int seed) : randGenerator(seed), dis(0.0, 1.0)
+{
+    this->type = type;
+    this->dimensions = dimensions;
+    this->numPoints = max(numPoints, 1LL);
+    this->seed = seed;
+    index = 0;
+    quasiDimensions = min(dimensions, SAMPLER_MAX_QUASI_DIMENSIONS);
+
+    // Every dimension gets its own key, for the Latin hypercube and the random padding.
+    if(type != SAMPLER_RANDOM)
+    {
+        dimensionKeys.resize(dimensions);
+        for(int d = 0; d < dimensions; d++)
+            dimensionKeys[d] = mixBits(((uint64_t)seed << 32) ^ (uint64_t)d);
+    }
+
+    if(type == SAMPLER_SOBOL)
+        setupSobol();
+    else if(type == SAMPLER_HALTON)
+        setupHalton();
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PUBLIC FUNCTIONS BELOW ------------------
+// ----------------------------------------------------------
+/**
+ * @brief Makes index the next point drawn.
+ *
+ * Free for the quasi-random samplers. SAMPLER_RANDOM has to draw (and drop)
+ * every number before the point, like a Mersenne Twister always does.
+ *
+ * @param index The index of the next point.
+ */
+void Sampler::skipTo(long long index)
+{
+    if(type == SAMPLER_RANDOM)
+    {
+        if(index < this->index)
+        {
+            randGenerator.seed(seed);
+            this->index = 0;
+        }
+        for(long long i = this->index * dimensions; i < index * dimensions; i++)
+            dis(randGenerator);
+    }
+    else if(type == SAMPLER_SOBOL)
+    {
+        // The point is the sum of the direction numbers of the set bits of the Gray code of its index.
+        uint64_t gray = (uint64_t)index ^ ((uint64_t)index >> 1);
+        for(int d = 0; d < quasiDimensions; d++)
+        {
+            uint32_t x = 0;
+            for(int bit = 0; bit < 32; bit++)
+                if((gray >> bit) & 1)
+                    x ^= directions[d * 32 + bit];
+            sobolPoint[d] = x;
+        }
+    }
+
+    this->index = index;
+}
+
+/**
+ * @brief Returns the index of the next point drawn.
+ * @return The value stored in the index variable.
+ */
+long long Sampler::getIndex()
+{
+    return index;
+}
+
+/**
+ * @brief Draws the next point, scaled to the bounds.
+ * @param point Set to the point (resized to the number of dimensions).
+ * @param minBound, maxBound The max/min boundaries of the elements.
+ */
+void Sampler::next(vector<double> &point, double minBound, double maxBound)
+{
+    point.resize(dimensions);
+
+    if(type == SAMPLER_RANDOM)
+    {
+        // Exactly the numbers createMatrix() draws.
+        for(int d = 0; d < dimensions; d++)
+            point[d] = (maxBound-minBound) / (1 - 0) * (dis(randGenerator)-0) + minBound;
+        index++;
+        return;
+    }
+
+    for(int d = 0; d < dimensions; d++)
+        point[d] = (maxBound - minBound) * coordinate(d) + minBound;
+
+    // Move the Sobol point on to the next index: one direction number per dimension.
+    index++;
+    if(type == SAMPLER_SOBOL)
+    {
+        int bit = min(__builtin_ctzll((uint64_t)index), 31);
+        for(int d = 0; d < quasiDimensions; d++)
+            sobolPoint[d] ^= directions[d * 32 + bit];
+    }
+}
+
+/**
+ * @brief Draws the next rows points as a matrix.
+ * @param rows The number of points.
+ * @param minBound, maxBound The max/min boundaries of the elements.
+ * @return The matrix, one point per row.
+ */
+vector<vector<double>> Sampler::createMatrix(int rows, double minBound, double maxBound)
+{
+    vector<vector<double>> matrix(rows);
+    for(int row = 0; row < rows; row++)
+        next(matrix[row], minBound, maxBound);
+    return matrix;
+}
+
+/**
+ * @brief Returns the sampler with the given name.
+ * @param name random, sobol, halton or lhs.
+ * @return The SAMPLER_ constant, or -1 if the name is unknown.
+ */
+int Sampler::parseType(string name)
+{
+    if(name == "random")
+        return SAMPLER_RANDOM;
+    if(name == "sobol")
+        return SAMPLER_SOBOL;
+    if(name == "halton")
+        return SAMPLER_HALTON;
+    if(name == "lhs")
+        return SAMPLER_LATIN_HYPERCUBE;
+    return -1;
+}
+
+/**
+ * @brief Returns the name of a sampler.
+ * @param type The SAMPLER_ constant.
+ * @return The name parseType() accepts.
+ */
+string Sampler::getTypeName(int type)
+{
+    switch(type)
+    {
+        case SAMPLER_SOBOL:
+            return "sobol";
+        case SAMPLER_HALTON:
+            return "halton";
+        case SAMPLER_LATIN_HYPERCUBE:
+            return "lhs";
+        default:
+            return "random";
+    }
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PRIVATE FUNCTIONS BELOW -----------------
+// ----------------------------------------------------------
+/**
+ * @brief Builds and scrambles the Sobol direction numbers.
+ *
+ * The first dimension is the van der Corput sequence, dimension d > 0 uses
+ * the d-th primitive polynomial. The polynomials are found the first time a
+ * sampler needs them (by degree, trying every candidate) and kept.
+ */
+void Sampler::setupSobol()
+{
+    // Find the primitive polynomials this sampler needs.
+    {
+        lock_guard<mutex> lock(tablesLock);
+        int degree = primitivePolynomials.empty() ? 1 : 32 - __builtin_clz(primitivePolynomials.back()) - 1;
+        uint32_t candidate = primitivePolynomials.empty() ? (1u << degree) | 1 : primitivePolynomials.back() + 2;
+        while(primitivePolynomials.size() + 1 < quasiDimensions && degree < 31)
+        {
+            // The prime factors of 2^degree - 1.
+            vector<uint64_t> factors;
+            uint64_t rest = (1ULL << degree) - 1;
+            for(uint64_t q = 3; q * q <= rest; q += 2)
+            {
+                if(rest % q == 0)
+                    factors.push_back(q);
+                while(rest % q == 0)
+                    rest /= q;
+            }
+            if(rest > 1)
+                factors.push_back(rest);
+
+            // Every polynomial of this degree with a constant term.
+            for(; candidate < (2u << degree) && primitivePolynomials.size() + 1 < quasiDimensions; candidate += 2)
+                if(isPrimitive(candidate, degree, factors))
+                    primitivePolynomials.push_back(candidate);
+
+            if(candidate >= (2u << degree))
+            {
+                degree++;
+                candidate = (1u << degree) | 1;
+            }
+        }
+    }
+
+    directions.assign(quasiDimensions * 32, 0);
+    digitalShifts.resize(quasiDimensions);
+    sobolPoint.assign(quasiDimensions, 0);
+    mt19937 scrambleGenerator(seed);
+
+    for(int d = 0; d < quasiDimensions; d++)
+    {
+        uint32_t *v = &directions[d * 32];
+        vector<uint32_t> m(33);
+
+        if(d == 0)
+        {
+            for(int k = 1; k <= 32; k++)
+                m[k] = 1;
+        }
+        else
+        {
+            // The initial direction numbers are odd, with m[k] < 2^k, from a fixed generator.
+            uint32_t p = primitivePolynomials[d - 1];
+            int degree = 32 - __builtin_clz(p) - 1;
+            mt19937 directionGenerator(d);
+            for(int k = 1; k <= degree && k <= 32; k++)
+                m[k] = ((directionGenerator() % (1u << (k - 1))) << 1) | 1;
+
+            // m[k] = 2 a1 m[k-1] ^ 4 a2 m[k-2] ^ ... ^ 2^degree m[k-degree] ^ m[k-degree]
+            for(int k = degree + 1; k <= 32; k++)
+            {
+                uint32_t mk = m[k - degree] ^ (m[k - degree] << degree);
+                for(int j = 1; j < degree; j++)
+                    if((p >> (degree - j)) & 1)
+                        mk ^= m[k - j] << j;
+                m[k] = mk;
+            }
+        }
+        for(int k = 1; k <= 32; k++)
+            v[k - 1] = m[k] << (32 - k);
+
+        // Scramble with a random lower triangular matrix (unit diagonal): output digit j
+        // is the parity of input digit j and a random choice of the digits above it.
+        uint32_t rows[32];
+        for(int j = 0; j < 32; j++)
+        {
+            uint32_t diagonal = 1u << (31 - j);
+            uint32_t above = ~(diagonal | (diagonal - 1));
+            rows[j] = diagonal | (scrambleGenerator() & above);
+        }
+        for(int k = 0; k < 32; k++)
+        {
+            uint32_t scrambled = 0;
+            for(int j = 0; j < 32; j++)
+                scrambled |= (uint32_t)(__builtin_popcount(rows[j] & v[k]) & 1) << (31 - j);
+            v[k] = scrambled;
+        }
+        digitalShifts[d] = scrambleGenerator();
+    }
+}
+
+/**
+ * @brief Picks the prime bases and random shifts of the Halton sequence.
+ */
+void Sampler::setupHalton()
+{
+    // Find the primes this sampler needs.
+    {
+        lock_guard<mutex> lock(tablesLock);
+        for(int candidate = primes.empty() ? 2 : primes.back() + 1; primes.size() < quasiDimensions; candidate++)
+        {
+            bool isPrime = true;
+            for(int p = 0; isPrime && p < primes.size() && primes[p] * primes[p] <= candidate; p++)
+                isPrime = candidate % primes[p] != 0;
+            if(isPrime)
+                primes.push_back(candidate);
+        }
+        haltonBases.assign(primes.begin(), primes.begin() + quasiDimensions);
+    }
+
+    mt19937 shiftGenerator(seed);
+    uniform_real_distribution<double> shift(0.0, 1.0);
+    haltonShifts.resize(quasiDimensions);
+    for(int d = 0; d < quasiDimensions; d++)
+        haltonShifts[d] = shift(shiftGenerator);
+}
+
+/**
+ * @brief Returns one coordinate of the point at index.
+ * @param dimension The dimension of the coordinate.
+ * @return The coordinate, in [0, 1).
+ */
+double Sampler::coordinate(int dimension)
+{
+    if(type == SAMPLER_SOBOL && dimension < quasiDimensions)
+        return ((sobolPoint[dimension] ^ digitalShifts[dimension]) + 0.5) * (1.0 / 4294967296.0);
+
+    if(type == SAMPLER_HALTON && dimension < quasiDimensions)
+    {
+        // The radical inverse of index + 1 (0 would put the first point on the corner).
+        int base = haltonBases[dimension];
+        double inverse = 0, digitValue = 1.0 / base;
+        for(uint64_t n = index + 1; n != 0; n /= base, digitValue /= base)
+            inverse += (n % base) * digitValue;
+        inverse += haltonShifts[dimension];
+        return inverse < 1 ? inverse : inverse - 1;
+    }
+
+    if(type == SAMPLER_LATIN_HYPERCUBE)
+    {
+        // One point per stratum in every design, at a random place inside it.
+        uint64_t design = index / numPoints;
+        uint32_t point = index % numPoints;
+        uint64_t key = mixBits(dimensionKeys[dimension] ^ design);
+        uint32_t stratum = permuteIndex(point, (uint32_t)numPoints, (uint32_t)key);
+        return (stratum + hashToUnit(key, point)) / numPoints;
+    }
+
+    // Padding above SAMPLER_MAX_QUASI_DIMENSIONS.
+    return hashToUnit(dimensionKeys[dimension], index);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file Sampler.h
+ * @author  Al Timofeyev
+ * @date    May 15, 2019
+ * @brief   Draws the points of the search space: pseudo-random (Mersenne
+ *          Twister, like createMatrix()), or from a scrambled Sobol,
+ *          Halton or Latin hypercube sequence, which cover the space much
+ *          more evenly for the same number of points.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_SAMPLER_H
+#define BENCHMARKFUNCTIONS2_SAMPLER_H
+
+#include <string>
+#include <vector>
+#include <random>
+#include <mutex>
+#include <cstdint>
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** Pseudo-random points from the Mersenne Twister, the same as createMatrix(). */
+#define SAMPLER_RANDOM 0
+/** Sobol points, scrambled (linear matrix scrambling and a digital shift) with the seed. */
+#define SAMPLER_SOBOL 1
+/** Halton points, randomly shifted (Cranley-Patterson rotation) with the seed. */
+#define SAMPLER_HALTON 2
+/** Latin hypercube points, one per stratum of every dimension in each design of numPoints points. */
+#define SAMPLER_LATIN_HYPERCUBE 3
+/** The number of dimensions with Sobol or Halton coordinates, the rest are padded with random ones. */
+#define SAMPLER_MAX_QUASI_DIMENSIONS 4096
+
+class Sampler{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    Sampler(int type, int dimensions, long long numPoints, unsigned int seed);  // numPoints is the size of a Latin hypercube design.
+
+    // --------------------- Functions Declarations ---------------------
+    void skipTo(long long index);                                           /**< Makes index the next point drawn.*/
+    long long getIndex();                                                   /**< Returns the index of the next point drawn.*/
+    void next(vector<double> &point, double minBound, double maxBound);     /**< Draws the next point, scaled to the bounds.*/
+    vector<vector<double>> createMatrix(int rows, double minBound, double maxBound);   /**< Draws the next rows points as a matrix.*/
+
+    static int parseType(string name);      /**< Returns the sampler named random, sobol, halton or lhs, or -1.*/
+    static string getTypeName(int type);    /**< Returns the name of a sampler.*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    int type;
+    int dimensions;
+    int quasiDimensions;        /**< The dimensions with Sobol or Halton coordinates.*/
+    long long numPoints;
+    unsigned int seed;
+    long long index;
+
+    mt19937 randGenerator;                  /**< The generator of SAMPLER_RANDOM.*/
+    uniform_real_distribution<double> dis;
+    vector<uint32_t> directions;            /**< The scrambled Sobol direction numbers, 32 per dimension.*/
+    vector<uint32_t> sobolPoint;            /**< The Sobol point at index, before the digital shift.*/
+    vector<uint32_t> digitalShifts;
+    vector<int> haltonBases;
+    vector<double> haltonShifts;
+    vector<uint64_t> dimensionKeys;         /**< The hash key of every dimension (Latin hypercube and padding).*/
+
+    // --------------------- Functions Declarations ---------------------
+    void setupSobol();                      /**< Builds and scrambles the Sobol direction numbers.*/
+    void setupHalton();                     /**< Picks the prime bases and random shifts of the Halton sequence.*/
+    double coordinate(int dimension);       /**< Returns one coordinate (in [0, 1)) of the point at index.*/
+
+    static vector<uint32_t> primitivePolynomials;   /**< Found once, shared by every Sobol sampler.*/
+    static vector<int> primes;                      /**< Found once, shared by every Halton sampler.*/
+    static mutex tablesLock;
+};
+
+
+#endif //BENCHMARKFUNCTIONS2_SAMPLER_H
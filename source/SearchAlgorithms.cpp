@@ -10,9 +10,30 @@
 /**
  * @brief Implementations of a Blind Search Algorithm.
  *
- * @note This function makes a call to utilities.h --> createMatrix().
- * @note This function makes a call to utilities.h --> calculateFitnessOfMatrix().
- * @note This function makes a call to utilities.h --> quicksort().
+ * Every vector is evaluated against the best fitness so far, so vectors
+ * that can't beat it are rejected part way through their evaluation
+ * (for the functions that support it) instead of being scored and sorted.
+ *
+ * The vectors are never stored: each element is drawn and fed straight into
+ * the Benchmark Function, and only the seed and row of the best vector are
+ * kept, so its vector can be regenerated. The vectors drawn are the ones
+ * createMatrix() would have drawn, so the search finds the same best vector
+ * as it would with a matrix per iteration, without the memory traffic (a
+ * matrix of 30 vectors of 10^6 elements is 240 MB).
+ *
+ * With a quasi-random sampler, the iterations * rows vectors are the first
+ * points of one Sobol, Halton or Latin hypercube sequence instead, which
+ * cover the search space more evenly; only the index of the best point is
+ * kept.
+ *
+ * With a TermTable, the vectors are scored with the interpolated terms of
+ * the function (an exploration that only has to rank them), and the best
+ * vector is scored again with the exact function at the end.
+ *
+ * @note This function makes a call to utilities.h --> sampleFitnessOfVector().
+ * @note This function makes a call to utilities.h --> regenerateVector().
+ * @note This function makes a call to Sampler.h --> next() and skipTo().
+ * @note This function makes a call to TermTable.h --> calculateFitnessBounded().
  *
  * @param iterations The number of times the Blind Search has to run.
  * @param argBest The initial vector of doubles that produced the initial best fitness.
@@ -22,39 +43,87 @@
  * @param columns The number of elements in each vector of the matrix.
  * @param minBound, maxBound The max/min boundaries are the range
  *                           in which to generate numbers.
+ * @param samplerType Where the vectors come from (SAMPLER_RANDOM by default).
+ * @param table The table of the function's terms, or nullptr to calculate them exactly (the default).
  *
  * @return The best fitness found using Blind Search.
  */
-double blindSearch(int iterations, vector<double> argBest, double fitness0, int functionID, int rows, int columns, double minBound, double maxBound)
+double blindSearch(int iterations, vector<double> argBest, double fitness0, int functionID, int rows, int columns, double minBound, double maxBound, int samplerType, const TermTable *table)
 {
     // Declare variables to hold best and current fitness from Blind Search.
     // Assign best fitness the initial best fitness value.
     double bestFitness = fitness0;
     double currFitness;
 
-    // Declare a matrix and fitness vector (to hold a list of fitness values).
-    vector<vector<double>> matrix;
-    vector<double> fitnessList;
+    if(samplerType != SAMPLER_RANDOM)
+    {
+        // Every vector of the search is the next point of one sequence.
+        long long numPoints = (long long)iterations * rows;
+        Sampler sampler(samplerType, columns, numPoints, nextRandomSeed());
+        vector<double> point;
+        long long bestIndex = -1;
+
+        for(long long i = 0; i < numPoints; i++)
+        {
+            sampler.next(point, minBound, maxBound);
+            if(table != nullptr)
+                currFitness = table->calculateFitnessBounded(point, bestFitness);
+            else
+                currFitness = calculateFitnessOfVectorBounded(point, functionID, bestFitness);
+            if(currFitness < bestFitness)
+            {
+                bestFitness = currFitness;
+                bestIndex = i;
+            }
+        }
+
+        // Regenerate the best vector from its index.
+        if(bestIndex >= 0)
+        {
+            sampler.skipTo(bestIndex);
+            sampler.next(argBest, minBound, maxBound);
+            if(table != nullptr)
+                bestFitness = min(calculateFitnessOfVector(argBest, functionID), fitness0);
+        }
+        return bestFitness;
+    }
+
+    // Where the best vector was drawn from (no row while it is still argBest).
+    unsigned int bestSeed = 0;
+    int bestRow = -1;
 
     // Start the Blind Search.
     for(int i = 0; i < iterations; i++)
     {
-        // Construct a random matrix using Mersenne Twister and calculate fitness.
-        matrix = createMatrix(rows, columns, minBound, maxBound);
-        fitnessList = calculateFitnessOfMatrix(matrix, functionID);
-
-        // Sort the fitness and matrix and set the best current fitness of this matrix.
-        quicksort(fitnessList, matrix, 0, fitnessList.size()-1);
-        currFitness = fitnessList[0];
+        // The same Mersenne Twister createMatrix() would have used for this iteration.
+        unsigned int seed = nextRandomSeed();
+        mt19937 randGenerator(seed);
 
-        // If the current fitness is better than the best fitness.
-        if(currFitness < bestFitness)
+        for(int row = 0; row < rows; row++)
         {
-            bestFitness = currFitness;
-            argBest = matrix[0];
+            // Draw and evaluate a vector, abandoning it once it can't beat the best fitness.
+            currFitness = sampleFitnessOfVector(randGenerator, columns, minBound, maxBound, functionID, bestFitness, table);
+
+            // If the current fitness is better than the best fitness.
+            if(currFitness < bestFitness)
+            {
+                bestFitness = currFitness;
+                bestSeed = seed;
+                bestRow = row;
+            }
         }
     }
 
+    // Regenerate the best vector, and give it the fitness of the full Benchmark Function
+    // (a vector ranked with a table can turn out no better than the first one).
+    if(bestRow >= 0)
+    {
+        argBest = regenerateVector(bestSeed, bestRow, columns, minBound, maxBound);
+        bestFitness = calculateFitnessOfVector(argBest, functionID);
+        if(table != nullptr)
+            bestFitness = min(bestFitness, fitness0);
+    }
+
     // Return the best fitness.
     return bestFitness;
 }
@@ -62,19 +131,49 @@ double blindSearch(int iterations, vector<double> argBest, double fitness0, int
 /**
  * @brief Implementations of a Local Search Algorithm.
  *
- * @note This function makes a call to utilities.h --> calculateFitnessOfVector().
+ * @note This function makes a call to SearchAlgorithms.h --> localDescent() or adaptiveLocalDescent().
  *
  * @param argBest The initial vector of doubles that produced the initial best fitness.
  * @param functionID The ID of the function to use for calculating the fitness.
  * @param alpha The value used to mutate the argBest vector.
+ * @param evaluations Set to the number of fitness evaluations performed (each single-element change counts as one).
+ * @param mode LS_MODE_FIXED (the default) or LS_MODE_ADAPTIVE.
  *
  * @return The best fitness found using Local Search.
  */
-double localSearch(vector<double> argBest, int functionID, double alpha)
+double localSearch(vector<double> argBest, int functionID, double alpha, long long &evaluations, int mode)
+{
+    evaluations = 0;
+    if(mode == LS_MODE_ADAPTIVE)
+        return adaptiveLocalDescent(argBest, functionID, alpha, evaluations);
+    return localDescent(argBest, functionID, alpha, evaluations);
+}
+
+/**
+ * @brief Descends from a vector until no neighborhood improves on it.
+ *
+ * The descent also stops after LS_MAX_STEPS steps: in the flat regions of
+ * some functions (like Michalewicz) every step still improves the fitness,
+ * by about 1e-22.
+ *
+ * @note This function makes a call to utilities.h --> calculateFitnessOfVector().
+ * @note This function makes a call to utilities.h --> calculateFitnessOfVectorBounded().
+ * @note This function makes a call to SearchAlgorithms.h --> createNeighborhood().
+ *
+ * @param argBest The starting vector, replaced by the best vector found.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param alpha The value used to mutate the argBest vector.
+ * @param evaluations Increased by the number of fitness evaluations performed (the
+ *                    forward difference of each element counts as one).
+ *
+ * @return The fitness of the best vector found.
+ */
+double localDescent(vector<double> &argBest, int functionID, double alpha, long long &evaluations)
 {
     // Initialize a best fitness variable for the Local Search.
     // Assign best fitness to be the fitness of argBest.
     double bestFitness = calculateFitnessOfVector(argBest, functionID);
+    evaluations++;
 
     // Declare the neighborhood vector and its fitness variable.
     vector<double> neighborhood;
@@ -84,7 +183,7 @@ double localSearch(vector<double> argBest, int functionID, double alpha)
     bool isNotComplete = true;
 
     // Start the Local Search
-    while(isNotComplete)
+    for(int step = 0; isNotComplete && step < LS_MAX_STEPS; step++)
     {
         // Reset the Local Search flag to false.
         isNotComplete = false;
@@ -92,8 +191,9 @@ double localSearch(vector<double> argBest, int functionID, double alpha)
         // Generate the neighborhood.
         neighborhood = createNeighborhood(argBest, bestFitness, functionID, alpha);
 
-        // Calculate fitness of neighborhood;
-        neighborhoodFitness = calculateFitnessOfVector(neighborhood, functionID);
+        // Calculate fitness of neighborhood, abandoning it once it can't beat the best fitness.
+        neighborhoodFitness = calculateFitnessOfVectorBounded(neighborhood, functionID, bestFitness);
+        evaluations += argBest.size() + 1;
 
         // If the neighborhoodFitness is better than the best fitness,
         // continue the Local Search. Else, Local search is ended.
@@ -110,123 +210,1642 @@ double localSearch(vector<double> argBest, int functionID, double alpha)
 }
 
 /**
- * @brief Implementations of a Iterative Local Search Algorithm.
+ * @brief Descends from a vector one element at a time, with a step length per element.
+ *
+ * The fixed scheme uses alpha both as the size of its finite-difference
+ * probe and as the factor of its step, so a steep function (Schefel, with
+ * slopes of 10^3) overshoots and a flat one crawls. Here every element has
+ * its own step length, starting at alpha. Each sweep visits the elements in
+ * turn: a small central difference (LS_ADAPTIVE_PROBE_FRACTION of the step
+ * length) finds the element's downhill direction, and the element moves
+ * its step length that way if the move achieves LS_ADAPTIVE_ARMIJO of the
+ * decrease the slope predicts. An accepted move grows the step length by
+ * LS_ADAPTIVE_GROWTH, a rejected one shrinks it by LS_ADAPTIVE_SHRINK and
+ * tries again, up to LS_ADAPTIVE_BACKTRACKS times. Every move is scored
+ * with calculateFitnessDelta(), which only re-evaluates the terms that
+ * contain the element, and the fitness is re-evaluated in full after every
+ * sweep to stop round-off from accumulating.
+ *
+ * The descent ends after a sweep that improves the fitness by less than
+ * LS_ADAPTIVE_TOLERANCE of it, or after LS_MAX_STEPS sweeps.
  *
+ * @note This function makes a call to utilities.h --> calculateFitnessDelta().
  * @note This function makes a call to utilities.h --> calculateFitnessOfVector().
  *
- * @param iterations The maximum number of times the Iterative Local Search can run.
- * @param argBest The initial vector of doubles that produced the initial best fitness.
+ * @param argBest The starting vector, replaced by the best vector found.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param alpha The initial step length of every element.
+ * @param evaluations Increased by the number of fitness evaluations performed (each single-element change counts as one).
+ *
+ * @return The fitness of the best vector found.
+ */
+double adaptiveLocalDescent(vector<double> &argBest, int functionID, double alpha, long long &evaluations)
+{
+    int size = argBest.size();
+    double bestFitness = calculateFitnessOfVector(argBest, functionID);
+    evaluations++;
+
+    // The step length of every element.
+    vector<double> steps(size, alpha);
+
+    for(int sweep = 0; sweep < LS_MAX_STEPS; sweep++)
+    {
+        double sweepFitness = bestFitness;
+
+        for(int i = 0; i < size; i++)
+        {
+            // Find the slope of the element with a small central difference.
+            double x = argBest[i];
+            double probe = LS_ADAPTIVE_PROBE_FRACTION * steps[i];
+            double forward = calculateFitnessDelta(argBest, functionID, i, x + probe, bestFitness);
+            double backward = calculateFitnessDelta(argBest, functionID, i, x - probe, bestFitness);
+            double slope = (forward - backward) / (2 * probe);
+            evaluations += 2;
+
+            // Move downhill by the step length, shrinking it until the move decreases the fitness enough.
+            for(int b = 0; b < LS_ADAPTIVE_BACKTRACKS && slope != 0 && isfinite(slope); b++)
+            {
+                double newValue = x - copysign(steps[i], slope);
+                double delta = calculateFitnessDelta(argBest, functionID, i, newValue, bestFitness);
+                evaluations++;
+                if(delta <= -LS_ADAPTIVE_ARMIJO * steps[i] * abs(slope))
+                {
+                    argBest[i] = newValue;
+                    bestFitness += delta;
+                    steps[i] *= LS_ADAPTIVE_GROWTH;
+                    break;
+                }
+                steps[i] *= LS_ADAPTIVE_SHRINK;
+            }
+        }
+
+        // Re-evaluate the fitness, and stop once the sweep barely improved it.
+        bestFitness = calculateFitnessOfVector(argBest, functionID);
+        evaluations++;
+        if(!(sweepFitness - bestFitness > LS_ADAPTIVE_TOLERANCE * max(1.0, abs(bestFitness))))
+            break;
+    }
+
+    // Return the best fitness.
+    return bestFitness;
+}
+
+/**
+ * @brief Returns the Local Search mode with the given name.
+ * @param name fixed or adaptive.
+ * @return LS_MODE_FIXED, LS_MODE_ADAPTIVE, or -1 for any other name.
+ */
+int parseLocalSearchMode(string name)
+{
+    if(name == "fixed")
+        return LS_MODE_FIXED;
+    if(name == "adaptive")
+        return LS_MODE_ADAPTIVE;
+    return -1;
+}
+
+/**
+ * @brief Runs independent local descents in lockstep, lanes of them at a time.
+ *
+ * The vectors of the running descents are interleaved, element d of lane l
+ * at d*lanes + l, so every step of all of them is one pass over contiguous
+ * memory: the forward differences, the neighborhoods and their fitness are
+ * all calculated across the lanes (see calculateFitnessDifferencesInterleaved()
+ * and calculateFitnessOfInterleavedBounded()). A lane whose neighborhood
+ * doesn't improve (or that reaches LS_MAX_STEPS steps) is retired, its
+ * optimum written back, and the lane is refilled with the next start. Once
+ * the starts run out, the lanes still running are packed together, so the
+ * last (often much longer) descents don't drag empty lanes along.
+ *
+ * Each descent makes exactly the steps localDescent() makes from the same
+ * start, so it ends with the same vector and fitness.
+ *
+ * @note This function makes a call to utilities.h --> calculateFitnessDifferencesInterleaved().
+ * @note This function makes a call to utilities.h --> calculateFitnessOfInterleavedBounded().
+ *
+ * @param starts The starting vectors (all the same size), each replaced by the best vector found from it.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param alpha The value used to mutate the vectors.
+ * @param lanes The number of descents run in lockstep.
+ *
+ * @return The fitness of the best vector found from each start.
+ */
+vector<double> localSearchBatch(vector<vector<double>> &starts, int functionID, double alpha, int lanes)
+{
+    // Declare vector that will hold the best fitness of each descent.
+    int instances = starts.size();
+    vector<double> bestFitnessList(instances);
+    if(instances == 0)
+        return bestFitnessList;
+
+    int dimensions = starts[0].size();
+    lanes = max(1, min(lanes, instances));
+
+    // The interleaved vectors of the lanes, and the neighborhoods and differences of each step.
+    vector<double> current(dimensions * lanes), neighborhood(dimensions * lanes), differences;
+    vector<double> fitness(lanes), neighborhoodFitness(lanes);
+    vector<int> instance(lanes, -1), steps(lanes, 0);
+    int nextInstance = 0, activeLanes = 0;
+
+    // Writes the optimum of a lane (stored in vectors) back to its start, and empties the lane.
+    auto retire = [&](int lane, vector<double> &vectors)
+    {
+        vector<double> &argBest = starts[instance[lane]];
+        for(int d = 0; d < dimensions; d++)
+            argBest[d] = vectors[d * lanes + lane];
+        bestFitnessList[instance[lane]] = fitness[lane];
+        instance[lane] = -1;
+        activeLanes--;
+    };
+
+    // Loads the next start into an empty lane, if there is one left.
+    auto refill = [&](int lane)
+    {
+        if(nextInstance >= instances)
+            return;
+        instance[lane] = nextInstance++;
+        steps[lane] = 0;
+        fitness[lane] = calculateFitnessOfVector(starts[instance[lane]], functionID);
+        for(int d = 0; d < dimensions; d++)
+            current[d * lanes + lane] = starts[instance[lane]][d];
+        activeLanes++;
+    };
+
+    // Once the starts run out, packs the running descents into the first lanes and drops the empty ones.
+    auto compact = [&]()
+    {
+        int width = 0;
+        for(int lane = 0; lane < lanes; lane++)
+        {
+            if(instance[lane] < 0)
+                continue;
+            for(int d = 0; d < dimensions; d++)
+                neighborhood[d * activeLanes + width] = current[d * lanes + lane];
+            instance[width] = instance[lane];
+            steps[width] = steps[lane];
+            fitness[width] = fitness[lane];
+            width++;
+        }
+        lanes = width;
+        swap(current, neighborhood);
+        current.resize(dimensions * lanes);
+        neighborhood.resize(dimensions * lanes);
+    };
+
+    for(int lane = 0; lane < lanes; lane++)
+        refill(lane);
+
+    // Step every lane until every descent has ended.
+    while(activeLanes > 0)
+    {
+        // Generate the neighborhoods of all the lanes.
+        calculateFitnessDifferencesInterleaved(current, lanes, dimensions, functionID, alpha, differences);
+        for(int k = 0; k < dimensions * lanes; k++)
+            neighborhood[k] = current[k] - (alpha * differences[k]);
+
+        // Calculate their fitness, abandoning each one once it can't beat the fitness of its lane.
+        calculateFitnessOfInterleavedBounded(neighborhood, lanes, dimensions, functionID, fitness, neighborhoodFitness);
+
+        // The lanes that improved take the step, the others are retired.
+        for(int lane = 0; lane < lanes; lane++)
+        {
+            if(instance[lane] < 0)
+                continue;
+            if(neighborhoodFitness[lane] < fitness[lane])
+            {
+                fitness[lane] = neighborhoodFitness[lane];
+                steps[lane]++;
+            }
+            else
+                retire(lane, current);
+        }
+        swap(current, neighborhood);
+
+        // Retire the descents out of steps, and refill the empty lanes.
+        for(int lane = 0; lane < lanes; lane++)
+        {
+            if(instance[lane] >= 0 && steps[lane] >= LS_MAX_STEPS)
+                retire(lane, current);
+            if(instance[lane] < 0)
+                refill(lane);
+        }
+        if(activeLanes > 0 && activeLanes < lanes)
+            compact();
+    }
+
+    // Return the best fitness of each descent.
+    return bestFitnessList;
+}
+
+/**
+ * @brief Implementations of a multi-start Iterated Local Search Algorithm.
+ *
+ * Every iteration is one restart: a local descent from a new starting point.
+ * The first restart starts from argBest. Every other restart draws its start
+ * from its own random stream (seeded with the run seed and the restart
+ * number), either a uniformly random point, with probability
+ * ILS_RESTART_PROBABILITY, or a perturbation of the best local optimum any
+ * worker has found so far. The restarts are handed out to numThreads
+ * worker threads through an atomic counter, and the workers share their
+ * optima through a SharedBest board, so no locks are taken. Each restart
+ * records its own optimum, and once the workers are done the list is turned
+ * into the best fitness of the restarts up to each one, in restart order,
+ * so it never depends on which restarts happened to finish first.
+ *
+ * With a quasi-random sampler, the uniformly random starts are replaced by
+ * the point of a Sobol, Halton or Latin hypercube sequence at the restart
+ * number. Every worker skips straight to the points of its own restarts, so
+ * they draw disjoint points of the one sequence without coordinating.
+ *
+ * @note This function makes a call to SearchAlgorithms.h --> localDescent() or adaptiveLocalDescent().
+ * @note This function makes a call to SharedBest.h --> offer() and read().
+ * @note This function makes a call to Sampler.h --> skipTo() and next().
+ *
+ * @param iterations The number of restarts.
+ * @param argBest The vector the first restart starts from.
  * @param functionID The ID of the function to use for calculating the fitness.
  * @param alpha The value used to mutate the argBest vector.
+ * @param minBound, maxBound The max/min boundaries of the starting points.
+ * @param numThreads The number of threads running restarts.
+ * @param evaluations Set to the number of fitness evaluations performed by all the descents.
+ * @param samplerType Where the random starts come from (SAMPLER_RANDOM by default).
+ * @param localSearchMode The descent of every restart, LS_MODE_FIXED (the default) or LS_MODE_ADAPTIVE.
  *
- * @return A vector of best fitness' found using Iterative Local Search.
+ * @return A vector of the best fitness of the restarts 0 to r, for every restart r.
  */
-vector<double> iterativeLocalSearch(int iterations, vector<double> argBest, int functionID, double alpha)
+vector<double> iterativeLocalSearch(int iterations, vector<double> argBest, int functionID, double alpha, double minBound, double maxBound, int numThreads, long long &evaluations,
+                                   int samplerType, int localSearchMode)
+{
+    // Declare vector that will hold best fitness from each iteration.
+    vector<double> bestFitnessList(iterations);
+
+    // One seed for the run, every restart derives its own stream from it.
+    unsigned int baseSeed = nextRandomSeed();
+    double range = maxBound - minBound;
+    int dimensions = argBest.size();
+
+    // The global best local optimum, shared by all the workers.
+    SharedBest board(dimensions);
+
+    // Never use more workers than there are restarts.
+    numThreads = max(1, min(numThreads, iterations));
+
+    // Hands out the restarts (the worker's own node's first), and adds up the evaluations of the finished descents.
+    NodeWorkQueue restarts(iterations, numThreads);
+    atomic<long long> totalEvaluations(0);
+
+    // Runs restarts until there are none left, with the caller's fitness memo.
+    FitnessMemo *memo = getFitnessMemo();
+    auto worker = [&](int t)
+    {
+        // Pin the worker before it creates its buffers, so they're on its node.
+        WorkerPlacement placement(t);
+        FitnessMemoScope memoScope(memo);
+
+        // The start of each restart, and the optimum it is perturbed from.
+        vector<double> start(dimensions);
+        vector<double> argGlobBest(dimensions);
+        Sampler sampler(samplerType, dimensions, iterations, baseSeed);
+
+        for(int r = restarts.next(t); r >= 0; r = restarts.next(t))
+        {
+            // Draw the starting point.
+            if(r == 0)
+                start = argBest;
+            else
+            {
+                seed_seq seeds{baseSeed, (unsigned int)r};
+                mt19937 randGenerator(seeds);
+                uniform_real_distribution<double> dis(0.0, 1.0);
+                normal_distribution<double> gaussian(0.0, ILS_PERTURBATION_FRACTION * range);
+
+                bool freshStart = dis(randGenerator) < ILS_RESTART_PROBABILITY || isinf(board.read(argGlobBest));
+                if(freshStart && samplerType != SAMPLER_RANDOM)
+                {
+                    sampler.skipTo(r);
+                    sampler.next(start, minBound, maxBound);
+                }
+                else
+                {
+                    for(int d = 0; d < dimensions; d++)
+                    {
+                        double x = freshStart ? minBound + range * dis(randGenerator) : argGlobBest[d] + gaussian(randGenerator);
+                        start[d] = min(max(x, minBound), maxBound);
+                    }
+                }
+            }
+
+            // Descend to the local optimum.
+            long long restartEvaluations = 0;
+            double fitness = (localSearchMode == LS_MODE_ADAPTIVE) ? adaptiveLocalDescent(start, functionID, alpha, restartEvaluations)
+                                                                  : localDescent(start, functionID, alpha, restartEvaluations);
+            totalEvaluations += restartEvaluations;
+
+            // Publish it if it's the best so far, and record the restart's own optimum.
+            board.offer(start, fitness);
+            bestFitnessList[r] = fitness;
+        }
+    };
+
+    // Start the workers and wait for them to finish.
+    vector<thread> workers;
+    for(int t = 1; t < numThreads; t++)
+        workers.emplace_back(worker, t);
+    worker(0);
+    for(int t = 0; t < workers.size(); t++)
+        workers[t].join();
+    evaluations = totalEvaluations;
+
+    // Turn the optima into the best fitness found by each restart and the ones before it.
+    for(int r = 1; r < iterations; r++)
+        bestFitnessList[r] = min(bestFitnessList[r], bestFitnessList[r - 1]);
+
+    // Return the list of best fitness values.
+    return bestFitnessList;
+}
+
+/**
+ * @brief Implementation of a Particle Swarm Optimization Algorithm.
+ *
+ * Positions, velocities and personal bests of the whole swarm are stored
+ * as flat row-major arrays (particle p, dimension d is at p*dimensions + d),
+ * so the velocity and position update is one straight loop over contiguous
+ * memory that the compiler can vectorize. Positions are clamped to
+ * [minBound, maxBound] and velocities to the width of that range.
+ *
+ * @note This function makes a call to utilities.h --> createMatrix().
+ * @note This function makes a call to PopulationEvaluator.h --> evaluate().
+ *
+ * @param iterations The number of times the swarm is moved and re-evaluated.
+ * @param particles The number of particles in the swarm.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param dimensions The number of elements in each particle's position.
+ * @param minBound, maxBound The max/min boundaries of the search space.
+ * @param numThreads The number of threads used to evaluate the swarm.
+ * @param evaluations Set to the total number of fitness evaluations performed.
+ *
+ * @return A vector of the best fitness found after each iteration.
+ */
+vector<double> particleSwarmOptimization(int iterations, int particles, int functionID, int dimensions, double minBound, double maxBound, int numThreads, long long &evaluations)
 {
     // Declare vector that will hold best fitness from each iteration.
     vector<double> bestFitnessList;
 
-    // Initialize best global/iterative fitness variables for the Iterative Local Search.
-    // Assign their initial values to be the fitness of argBest.
-    double bestGlobFitness = calculateFitnessOfVector(argBest, functionID);
-    double bestIterFitness = calculateFitnessOfVector(argBest, functionID);
+    // The threads that evaluate the swarm, for the whole run.
+    PopulationEvaluator evaluator(numThreads, particles, dimensions);
 
-    // Initialize a variable to hold the best iterative arg.
-    // Assign its initial value to be argBest.
-    vector<double> argIterBest = argBest;
+    // Total number of elements in each of the flat swarm arrays.
+    long total = (long)particles * dimensions;
 
-    // Declare the neighborhood vector and its fitness variable.
-    vector<double> neighborhood;
-    double neighborhoodFitness;
+    // The maximum speed of a particle in any single dimension.
+    double maxVelocity = maxBound - minBound;
 
-    // Set the flag for the Local Search.
-    bool isNotComplete = true;
+    // Create a Mersenne Twister pseudo-random number generator.
+    mt19937 randGenerator(nextRandomSeed());
+    uniform_real_distribution<double> dis(0.0, 1.0);
+
+    // Initialize the positions randomly and flatten them into one array.
+    vector<vector<double>> matrix = createMatrix(particles, dimensions, minBound, maxBound);
+    vector<double> positions(total);
+    for(int p = 0; p < particles; p++)
+        copy(matrix[p].begin(), matrix[p].end(), positions.begin() + (long)p * dimensions);
+
+    // Initialize the velocities randomly in [-maxVelocity, maxVelocity].
+    vector<double> velocities(total);
+    for(long i = 0; i < total; i++)
+        velocities[i] = maxVelocity * (2.0 * dis(randGenerator) - 1.0);
 
-    // Start the Iterative Local Search.
+    // Evaluate the initial swarm, which is also every particle's personal best.
+    vector<double> fitnessList;
+    evaluator.evaluate(positions, fitnessList, particles, functionID);
+    evaluations = particles;
+
+    vector<double> personalBest = positions;
+    vector<double> personalBestFitness = fitnessList;
+
+    // Find the initial global best.
+    int bestParticle = 0;
+    for(int p = 1; p < particles; p++)
+        if(personalBestFitness[p] < personalBestFitness[bestParticle])
+            bestParticle = p;
+    double bestFitness = personalBestFitness[bestParticle];
+    vector<double> globalBest(positions.begin() + (long)bestParticle * dimensions, positions.begin() + (long)(bestParticle + 1) * dimensions);
+
+    // Random coefficients for every element, regenerated each iteration.
+    vector<double> randCognitive(total), randSocial(total);
+
+    // Start the Particle Swarm Optimization.
     for(int i = 0; i < iterations; i++)
     {
-        // Start the Local Search.
-        while(isNotComplete)
+        // Draw the random coefficients up front so the update loop has no calls in it.
+        for(long j = 0; j < total; j++)
         {
-            // Reset the Local Search flag to false.
-            isNotComplete = false;
+            randCognitive[j] = dis(randGenerator);
+            randSocial[j] = dis(randGenerator);
+        }
 
-            // Generate the neighborhood.
-            neighborhood = createNeighborhood(argBest, bestGlobFitness, functionID, alpha);
+        // Update the velocity and position of every particle in every dimension.
+        double *pos = positions.data();
+        double *vel = velocities.data();
+        const double *pBest = personalBest.data();
+        const double *gBest = globalBest.data();
+        const double *r1 = randCognitive.data();
+        const double *r2 = randSocial.data();
+        for(int p = 0; p < particles; p++)
+        {
+            long offset = (long)p * dimensions;
+            for(int d = 0; d < dimensions; d++)
+            {
+                long j = offset + d;
+                double v = PSO_INERTIA * vel[j]
+                         + PSO_COGNITIVE * r1[j] * (pBest[j] - pos[j])
+                         + PSO_SOCIAL * r2[j] * (gBest[d] - pos[j]);
+                v = min(max(v, -maxVelocity), maxVelocity);
+                vel[j] = v;
+                pos[j] = min(max(pos[j] + v, minBound), maxBound);
+            }
+        }
 
-            // Calculate fitness of neighborhood;
-            neighborhoodFitness = calculateFitnessOfVector(neighborhood, functionID);
+        // Evaluate the whole swarm in one batch.
+        evaluator.evaluate(positions, fitnessList, particles, functionID);
+        evaluations += particles;
 
-            // If the neighborhoodFitness is better than the best fitness,
-            // continue the Local Search. Else, Local search is ended.
-            if(neighborhoodFitness < bestIterFitness)
+        // Update the personal bests and the global best.
+        for(int p = 0; p < particles; p++)
+        {
+            if(fitnessList[p] < personalBestFitness[p])
             {
-                bestIterFitness = neighborhoodFitness;  // Set the new best iterative fitness.
-                argIterBest = neighborhood;             // Set the new best iterative vector that produced best iterative fitness.
-                isNotComplete = true;                   // Reset the loop flag to true to continue the loop.
+                long offset = (long)p * dimensions;
+                personalBestFitness[p] = fitnessList[p];
+                copy(positions.begin() + offset, positions.begin() + offset + dimensions, personalBest.begin() + offset);
+
+                if(fitnessList[p] < bestFitness)
+                {
+                    bestFitness = fitnessList[p];
+                    copy(positions.begin() + offset, positions.begin() + offset + dimensions, globalBest.begin());
+                }
             }
         }
 
-        // If the iterative solution is better than the best global solution.
-        if(bestIterFitness < bestGlobFitness)
+        // Add the global best solution to the list of best fitness values.
+        bestFitnessList.push_back(bestFitness);
+    }
+
+    // Return the list of best fitness values.
+    return bestFitnessList;
+}
+
+/**
+ * @brief Implementation of a parallel Simulated Annealing Algorithm.
+ *
+ * Runs a number of independent annealing chains, each from its own random
+ * start and its own random number stream. The chains are split evenly
+ * across the threads.
+ *
+ * @note This function makes a call to SearchAlgorithms.h --> annealingChain().
+ *
+ * @param chains The number of independent annealing chains.
+ * @param movesPerChain The number of single-coordinate moves each chain makes.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param dimensions The number of elements in each vector.
+ * @param minBound, maxBound The max/min boundaries of the search space.
+ * @param coolingSchedule COOLING_EXPONENTIAL, COOLING_LINEAR or COOLING_LOGARITHMIC.
+ * @param numThreads The number of threads the chains are run on.
+ * @param evaluations Set to the total number of moves and full evaluations performed.
+ *
+ * @return A vector of the best fitness found by each chain.
+ */
+vector<double> simulatedAnnealing(int chains, long long movesPerChain, int functionID, int dimensions, double minBound, double maxBound, int coolingSchedule, int numThreads, long long &evaluations)
+{
+    // Declare vectors that will hold the best fitness and evaluation count of each chain.
+    vector<double> bestFitnessList(chains);
+    vector<long long> chainEvaluations(chains, 0);
+
+    // Every chain gets its own seed derived from the same base seed.
+    unsigned int baseSeed = nextRandomSeed();
+
+    // Never use more threads than there are chains.
+    if(numThreads > chains)
+        numThreads = chains;
+    if(numThreads < 1)
+        numThreads = 1;
+
+    // Hands out the chains, the worker's own node's first.
+    NodeWorkQueue chainQueue(chains, numThreads);
+
+    // Runs chains on the worker's CPU until there are none left.
+    FitnessMemo *memo = getFitnessMemo();
+    auto runChains = [&](int worker)
+    {
+        WorkerPlacement placement(worker);
+        FitnessMemoScope memoScope(memo);
+        for(int c = chainQueue.next(worker); c >= 0; c = chainQueue.next(worker))
         {
-            bestGlobFitness = bestIterFitness;  // Set the new best global fitness.
-            argBest = argIterBest;              // Set the new best global vector that produced best global fitness.
+            seed_seq seeds{baseSeed, (unsigned int)c};
+            vector<unsigned int> chainSeed(1);
+            seeds.generate(chainSeed.begin(), chainSeed.end());
+            bestFitnessList[c] = annealingChain(movesPerChain, functionID, dimensions, minBound, maxBound, coolingSchedule, chainSeed[0], chainEvaluations[c]);
         }
+    };
 
-        // Add the global best solution to the list of best fitness values.
-        bestFitnessList.push_back(bestGlobFitness);
+    // Start the chains on their threads and wait for them to finish.
+    vector<thread> workers;
+    for(int t = 1; t < numThreads; t++)
+        workers.emplace_back(runChains, t);
+    runChains(0);
+    for(int t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    // Add up the evaluations of all the chains.
+    evaluations = 0;
+    for(int c = 0; c < chains; c++)
+        evaluations += chainEvaluations[c];
 
-        // Reset the Local Search flag back to true.
-        isNotComplete = true;
+    // Return the list of best fitness values.
+    return bestFitnessList;
+}
+
+/**
+ * @brief Runs a single Simulated Annealing chain.
+ *
+ * Every move changes one randomly chosen coordinate by a random step that
+ * shrinks as the chain cools, and is scored with calculateFitnessDelta(), so
+ * a move costs one or two Benchmark Function terms instead of a full
+ * evaluation. The initial temperature is calibrated from random moves so an
+ * average uphill move is accepted with probability SA_INITIAL_ACCEPTANCE.
+ * The running fitness is periodically re-evaluated in full to stop
+ * round-off from accumulating.
+ *
+ * @note This function makes a call to utilities.h --> calculateFitnessDelta().
+ * @note This function makes a call to utilities.h --> calculateFitnessOfVector().
+ *
+ * @param moves The number of single-coordinate moves to make.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param dimensions The number of elements in the vector.
+ * @param minBound, maxBound The max/min boundaries of the search space.
+ * @param coolingSchedule COOLING_EXPONENTIAL, COOLING_LINEAR or COOLING_LOGARITHMIC.
+ * @param seed The seed for this chain's Mersenne Twister.
+ * @param evaluations Set to the number of moves and full evaluations performed.
+ *
+ * @return The best fitness found by the chain.
+ */
+double annealingChain(long long moves, int functionID, int dimensions, double minBound, double maxBound, int coolingSchedule, unsigned int seed, long long &evaluations)
+{
+    // Create a Mersenne Twister pseudo-random number generator for this chain.
+    mt19937 randGenerator(seed);
+    uniform_real_distribution<double> dis(0.0, 1.0);
+    uniform_int_distribution<int> coordinateDis(0, dimensions - 1);
+
+    // Generate a random starting vector and calculate its fitness.
+    double range = maxBound - minBound;
+    vector<double> current(dimensions);
+    for(int d = 0; d < dimensions; d++)
+        current[d] = range * dis(randGenerator) + minBound;
+    double currentFitness = calculateFitnessOfVector(current, functionID);
+    double bestFitness = currentFitness;
+    evaluations = 1;
+
+    // Calibrate the initial temperature from the average uphill move.
+    double uphillSum = 0;
+    int uphillMoves = 0;
+    for(int i = 0; i < SA_CALIBRATION_MOVES; i++)
+    {
+        double delta = calculateFitnessDelta(current, functionID, coordinateDis(randGenerator), range * dis(randGenerator) + minBound, currentFitness);
+        if(delta > 0)
+        {
+            uphillSum += delta;
+            uphillMoves++;
+        }
+    }
+    evaluations += SA_CALIBRATION_MOVES;
+    double initialTemp = (uphillMoves > 0) ? -(uphillSum / uphillMoves) / log(SA_INITIAL_ACCEPTANCE) : 1.0;
+    double finalTemp = initialTemp * SA_FINAL_TEMPERATURE_RATIO;
+
+    // Declare the variables that change with the temperature.
+    double temperature = initialTemp;
+    double stepSize = range * SA_STEP_FRACTION;
+    long long resyncInterval = (long long)dimensions * SA_RESYNC_MOVES_PER_DIMENSION;
+
+    // Start the annealing.
+    for(long long move = 0; move < moves; move++)
+    {
+        // Cool down, and shrink the step size with the temperature.
+        if(move % SA_MOVES_PER_TEMPERATURE == 0)
+        {
+            temperature = coolingTemperature(coolingSchedule, initialTemp, finalTemp, move, moves);
+            stepSize = max(range * SA_STEP_FRACTION * sqrt(temperature / initialTemp), range * SA_MIN_STEP_FRACTION);
+        }
+
+        // Re-evaluate the running fitness in full to remove accumulated round-off.
+        if(move > 0 && move % resyncInterval == 0)
+        {
+            currentFitness = calculateFitnessOfVector(current, functionID);
+            evaluations++;
+        }
+
+        // Propose moving a single coordinate, clamped to the bounds.
+        int index = coordinateDis(randGenerator);
+        double newValue = current[index] + stepSize * (2.0 * dis(randGenerator) - 1.0);
+        newValue = min(max(newValue, minBound), maxBound);
+
+        // Score the move incrementally and apply the Metropolis criterion.
+        double delta = calculateFitnessDelta(current, functionID, index, newValue, currentFitness);
+        if(delta <= 0 || dis(randGenerator) < exp(-delta / temperature))
+        {
+            current[index] = newValue;
+            currentFitness += delta;
+
+            if(currentFitness < bestFitness)
+                bestFitness = currentFitness;
+        }
+    }
+    evaluations += moves;
+
+    // Make sure the final fitness is exact.
+    currentFitness = calculateFitnessOfVector(current, functionID);
+    evaluations++;
+    if(currentFitness < bestFitness)
+        bestFitness = currentFitness;
+
+    // Return the best fitness.
+    return bestFitness;
+}
+
+/**
+ * @brief Calculates the annealing temperature for a cooling schedule.
+ *
+ * Every schedule starts at initialTemp when move is 0 and reaches finalTemp
+ * when move is totalMoves.
+ *
+ * @param coolingSchedule COOLING_EXPONENTIAL, COOLING_LINEAR or COOLING_LOGARITHMIC.
+ *                        Unknown schedules use COOLING_EXPONENTIAL.
+ * @param initialTemp The starting temperature.
+ * @param finalTemp The temperature at the end of the schedule.
+ * @param move The number of moves made so far.
+ * @param totalMoves The total number of moves in the schedule.
+ *
+ * @return The temperature after move moves.
+ */
+double coolingTemperature(int coolingSchedule, double initialTemp, double finalTemp, long long move, long long totalMoves)
+{
+    double progress = (totalMoves > 0) ? (double)move / totalMoves : 1.0;
+
+    switch(coolingSchedule)
+    {
+        case COOLING_LINEAR:
+            return initialTemp + (finalTemp - initialTemp) * progress;
+        case COOLING_LOGARITHMIC:
+        {
+            // Measure time in temperature steps so the curve doesn't depend on the move count.
+            double steps = (double)totalMoves / SA_MOVES_PER_TEMPERATURE;
+            double step = (double)move / SA_MOVES_PER_TEMPERATURE;
+            double c = (initialTemp / finalTemp - 1) / log(1 + max(steps, 1.0));
+            return initialTemp / (1 + c * log(1 + step));
+        }
+        case COOLING_EXPONENTIAL:
+        default:
+            return initialTemp * pow(finalTemp / initialTemp, progress);
+    }
+}
+
+/**
+ * @brief Implementation of the CMA-ES (Covariance Matrix Adaptation Evolution Strategy).
+ *
+ * A (mu/mu_w, lambda)-CMA-ES. Each generation lambda candidates are sampled as
+ * x = mean + sigma * B*D*z with one cache-blocked product over all candidates,
+ * clamped to the bounds and evaluated as a batch. The covariance matrix is
+ * updated lazily: each generation's rank-one and rank-mu terms are only
+ * recorded, and they are folded into C with one blocked rank update right
+ * before the eigen decomposition, which runs every
+ * 1/((c1+cmu)*n*CMAES_EIGEN_INTERVAL_FACTOR) generations to amortize its
+ * O(n^3) cost. Between decompositions the candidates are sampled from the
+ * previous B and D.
+ *
+ * @note This function makes a call to LinearAlgebra.h --> blockedMatrixVectorProduct().
+ * @note This function makes a call to LinearAlgebra.h --> symmetricRankUpdate().
+ * @note This function makes a call to LinearAlgebra.h --> symmetricEigenDecomposition().
+ * @note This function makes a call to PopulationEvaluator.h --> evaluate().
+ *
+ * @param generations The maximum number of generations.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param dimensions The number of elements in each vector.
+ * @param minBound, maxBound The max/min boundaries of the search space.
+ * @param numThreads The number of threads used to evaluate each generation.
+ * @param evaluations Set to the total number of fitness evaluations performed.
+ *
+ * @return A vector of the best fitness found after each generation.
+ */
+vector<double> covarianceMatrixAdaptation(int generations, int functionID, int dimensions, double minBound, double maxBound, int numThreads, long long &evaluations)
+{
+    // Declare vector that will hold best fitness from each generation.
+    vector<double> bestFitnessList;
+    int n = dimensions;
+    double range = maxBound - minBound;
+
+    // Selection and recombination parameters.
+    int lambda = 4 + (int)(3 * log((double)n));
+    int mu = lambda / 2;
+    vector<double> weights(mu);
+    double weightSum = 0;
+    for(int i = 0; i < mu; i++)
+    {
+        weights[i] = log(mu + 0.5) - log(i + 1.0);
+        weightSum += weights[i];
+    }
+    double weightSqSum = 0;
+    for(int i = 0; i < mu; i++)
+    {
+        weights[i] /= weightSum;
+        weightSqSum += weights[i] * weights[i];
+    }
+    double muEff = 1.0 / weightSqSum;
+
+    // Adaptation parameters.
+    double cSigma = (muEff + 2) / (n + muEff + 5);
+    double dSigma = 1 + 2 * max(0.0, sqrt((muEff - 1) / (n + 1)) - 1) + cSigma;
+    double cc = (4 + muEff / n) / (n + 4 + 2 * muEff / n);
+    double c1 = 2 / (pow(n + 1.3, 2) + muEff);
+    double cMu = min(1 - c1, 2 * (muEff - 2 + 1 / muEff) / (pow(n + 2, 2) + muEff));
+    double chiN = sqrt((double)n) * (1 - 1.0 / (4 * n) + 1.0 / (21.0 * n * n));
+    int eigenInterval = max(1, (int)(1.0 / ((c1 + cMu) * n * CMAES_EIGEN_INTERVAL_FACTOR)));
+
+    // Create a Mersenne Twister pseudo-random number generator.
+    mt19937 randGenerator(nextRandomSeed());
+    uniform_real_distribution<double> dis(0.0, 1.0);
+    normal_distribution<double> normalDis(0.0, 1.0);
+
+    // Start from a random mean with a step size relative to the bounds.
+    vector<double> mean(n);
+    for(int i = 0; i < n; i++)
+        mean[i] = range * dis(randGenerator) + minBound;
+    double sigma = CMAES_INITIAL_SIGMA_FRACTION * range;
+
+    // The covariance matrix starts as the identity, and so do its eigenvectors (rows) and B*D.
+    vector<double> C((long)n * n, 0.0), eigenvectors((long)n * n, 0.0), BD((long)n * n, 0.0);
+    for(int i = 0; i < n; i++)
+        C[(long)i * n + i] = eigenvectors[(long)i * n + i] = BD[(long)i * n + i] = 1.0;
+    vector<double> eigenvalues(n, 1.0), D(n, 1.0);
+    double maxD = 1.0;
+
+    // Evolution paths.
+    vector<double> pSigma(n, 0.0), pc(n, 0.0);
+
+    // Covariance terms recorded since the last eigen decomposition.
+    vector<double> pendingVectors, pendingWeights;
+    double pendingScale = 1.0;
+
+    // The threads that evaluate the generations, for the whole run.
+    PopulationEvaluator evaluator(numThreads, lambda, n);
+
+    // Per generation buffers.
+    vector<double> Z((long)lambda * n), Y, X((long)lambda * n);
+    vector<double> fitnessList;
+    vector<int> order(lambda);
+    vector<double> yMean(n), projected(n), invSqrtY(n);
+    double bestFitness = INFINITY;
+    evaluations = 0;
+
+    // Start the CMA-ES.
+    for(int g = 0; g < generations; g++)
+    {
+        // Sample lambda candidates: Y = B*D*Z, X = mean + sigma*Y, clamped to the bounds.
+        for(long j = 0; j < (long)lambda * n; j++)
+            Z[j] = normalDis(randGenerator);
+        blockedMatrixVectorProduct(BD, n, Z, Y, lambda);
+        for(int k = 0; k < lambda; k++)
+        {
+            for(int i = 0; i < n; i++)
+            {
+                long j = (long)k * n + i;
+                X[j] = min(max(mean[i] + sigma * Y[j], minBound), maxBound);
+                Y[j] = (X[j] - mean[i]) / sigma;
+            }
+        }
+
+        // Evaluate the generation in one batch and rank it by fitness.
+        evaluator.evaluate(X, fitnessList, lambda, functionID);
+        evaluations += lambda;
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&fitnessList](int a, int b) { return fitnessList[a] < fitnessList[b]; });
+
+        // Add the best solution so far to the list of best fitness values.
+        if(fitnessList[order[0]] < bestFitness)
+            bestFitness = fitnessList[order[0]];
+        bestFitnessList.push_back(bestFitness);
+
+        // Move the mean by the weighted average step of the mu best candidates.
+        fill(yMean.begin(), yMean.end(), 0.0);
+        for(int r = 0; r < mu; r++)
+        {
+            const double *y = &Y[(long)order[r] * n];
+            for(int i = 0; i < n; i++)
+                yMean[i] += weights[r] * y[i];
+        }
+        for(int i = 0; i < n; i++)
+            mean[i] += sigma * yMean[i];
+
+        // C^(-1/2) * yMean = B * D^(-1) * B^T * yMean.
+        for(int r = 0; r < n; r++)
+        {
+            const double *b = &eigenvectors[(long)r * n];
+            double sum = 0;
+            for(int i = 0; i < n; i++)
+                sum += b[i] * yMean[i];
+            projected[r] = sum / D[r];
+        }
+        fill(invSqrtY.begin(), invSqrtY.end(), 0.0);
+        for(int r = 0; r < n; r++)
+        {
+            const double *b = &eigenvectors[(long)r * n];
+            for(int i = 0; i < n; i++)
+                invSqrtY[i] += projected[r] * b[i];
+        }
+
+        // Update the evolution paths.
+        double pSigmaNorm = 0;
+        for(int i = 0; i < n; i++)
+        {
+            pSigma[i] = (1 - cSigma) * pSigma[i] + sqrt(cSigma * (2 - cSigma) * muEff) * invSqrtY[i];
+            pSigmaNorm += pSigma[i] * pSigma[i];
+        }
+        pSigmaNorm = sqrt(pSigmaNorm);
+        double hSigma = (pSigmaNorm / sqrt(1 - pow(1 - cSigma, 2.0 * (g + 1))) / chiN < 1.4 + 2.0 / (n + 1)) ? 1.0 : 0.0;
+        for(int i = 0; i < n; i++)
+            pc[i] = (1 - cc) * pc[i] + hSigma * sqrt(cc * (2 - cc) * muEff) * yMean[i];
+
+        // Record this generation's covariance update instead of applying it:
+        // C = decay*C + c1*pc*pc^T + cmu*sum(w_r * y_r * y_r^T).
+        double decay = 1 - c1 - cMu + (1 - hSigma) * c1 * cc * (2 - cc);
+        pendingScale *= decay;
+        for(int k = 0; k < pendingWeights.size(); k++)
+            pendingWeights[k] *= decay;
+        pendingVectors.insert(pendingVectors.end(), pc.begin(), pc.end());
+        pendingWeights.push_back(c1);
+        for(int r = 0; r < mu; r++)
+        {
+            pendingVectors.insert(pendingVectors.end(), Y.begin() + (long)order[r] * n, Y.begin() + (long)(order[r] + 1) * n);
+            pendingWeights.push_back(cMu * weights[r]);
+        }
+
+        // Adapt the step size.
+        sigma *= exp((cSigma / dSigma) * (pSigmaNorm / chiN - 1));
+
+        // Every eigenInterval generations, apply the recorded updates and decompose C again.
+        if((g + 1) % eigenInterval == 0)
+        {
+            symmetricRankUpdate(C, n, pendingScale, pendingVectors, pendingWeights, pendingWeights.size());
+            pendingVectors.clear();
+            pendingWeights.clear();
+            pendingScale = 1.0;
+
+            symmetricEigenDecomposition(C, n, eigenvalues, eigenvectors);
+
+            // Guard against round-off making an eigenvalue zero or negative.
+            double maxEigenvalue = max(eigenvalues[n - 1], 1e-300);
+            for(int r = 0; r < n; r++)
+                D[r] = sqrt(max(eigenvalues[r], maxEigenvalue * 1e-14));
+            maxD = D[n - 1];
+
+            // B*D has eigenvector r, scaled by D[r], as its column r.
+            for(int r = 0; r < n; r++)
+                for(int i = 0; i < n; i++)
+                    BD[(long)i * n + r] = eigenvectors[(long)r * n + i] * D[r];
+        }
+
+        // Stop once the search distribution has collapsed.
+        if(sigma * maxD < CMAES_STEP_TOLERANCE * range)
+            break;
     }
 
     // Return the list of best fitness values.
     return bestFitnessList;
 }
 
+/**
+ * @brief Implementation of a real-coded Genetic Algorithm.
+ *
+ * Every generation the best GA_ELITE_FRACTION of the parents are copied
+ * unchanged into the children, and the rest of the children are bred from
+ * parents picked by tournament selection, recombined with blend (BLX-alpha)
+ * or simulated binary (SBX) crossover and perturbed by Gaussian mutation.
+ * Parents and children live in two preallocated flat row-major arrays that
+ * swap roles after each generation, so no memory is allocated in the
+ * generational loop. The elites are found with a partial sort of row
+ * indices, the rows themselves are never moved. The threads that evaluate
+ * the generations are started once, before the first one.
+ *
+ * @note This function makes a call to PopulationEvaluator.h --> evaluate().
+ *
+ * @param generations The number of generations.
+ * @param populationSize The number of vectors in each generation.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param dimensions The number of elements in each vector.
+ * @param minBound, maxBound The max/min boundaries of the search space.
+ * @param crossoverType GA_CROSSOVER_BLEND or GA_CROSSOVER_SBX.
+ * @param numThreads The number of threads used to evaluate each generation.
+ * @param evaluations Set to the total number of fitness evaluations performed.
+ *
+ * @return A vector of the best fitness found after each generation.
+ */
+vector<double> geneticAlgorithm(int generations, int populationSize, int functionID, int dimensions, double minBound, double maxBound, int crossoverType, int numThreads, long long &evaluations)
+{
+    // Declare vector that will hold best fitness from each generation.
+    vector<double> bestFitnessList;
+    bestFitnessList.reserve(generations);
+
+    // Total number of elements in each of the flat population arrays.
+    long total = (long)populationSize * dimensions;
+    double range = maxBound - minBound;
+
+    // Mutation changes one gene per child on average, by a fraction of the range.
+    double mutationRate = 1.0 / dimensions;
+    double mutationSigma = GA_MUTATION_SIGMA_FRACTION * range;
+    double sbxExponent = 1.0 / (GA_SBX_ETA + 1.0);
+
+    // Number of parents that survive unchanged into the next generation.
+    int elites = min(max(1, (int)(populationSize * GA_ELITE_FRACTION)), populationSize);
 
+    // Create a Mersenne Twister pseudo-random number generator.
+    mt19937 randGenerator(nextRandomSeed());
+    uniform_real_distribution<double> dis(0.0, 1.0);
+    normal_distribution<double> gaussian(0.0, 1.0);
+    uniform_int_distribution<int> pickRow(0, populationSize - 1);
+
+    // The threads that evaluate the generations, for the whole run.
+    PopulationEvaluator evaluator(numThreads, populationSize, dimensions);
+
+    // The two generational buffers and their fitness values.
+    vector<double> parents(total), children(total);
+    vector<double> parentFitness(populationSize), childFitness(populationSize);
+    vector<int> order(populationSize);
+
+    // Initialize the first generation randomly and evaluate it.
+    for(long i = 0; i < total; i++)
+        parents[i] = minBound + range * dis(randGenerator);
+    evaluator.evaluate(parents, parentFitness, populationSize, functionID);
+    evaluations = populationSize;
+
+    // Picks the fittest of GA_TOURNAMENT_SIZE random parents.
+    auto tournament = [&]()
+    {
+        int winner = pickRow(randGenerator);
+        for(int t = 1; t < GA_TOURNAMENT_SIZE; t++)
+        {
+            int challenger = pickRow(randGenerator);
+            if(parentFitness[challenger] < parentFitness[winner])
+                winner = challenger;
+        }
+        return winner;
+    };
+
+    // Start the Genetic Algorithm.
+    for(int g = 0; g < generations; g++)
+    {
+        // Rank only as many parents as there are elites.
+        iota(order.begin(), order.end(), 0);
+        partial_sort(order.begin(), order.begin() + elites, order.end(),
+                     [&parentFitness](int a, int b) { return parentFitness[a] < parentFitness[b]; });
+
+        const double *par = parents.data();
+        double *child = children.data();
+
+        // Copy the elites to the front of the children.
+        for(int e = 0; e < elites; e++)
+            copy(par + (long)order[e] * dimensions, par + (long)(order[e] + 1) * dimensions, child + (long)e * dimensions);
+
+        // Breed the rest of the children two at a time.
+        for(int c = elites; c < populationSize; c += 2)
+        {
+            const double *p1 = par + (long)tournament() * dimensions;
+            const double *p2 = par + (long)tournament() * dimensions;
+            double *c1 = child + (long)c * dimensions;
+            double *c2 = (c + 1 < populationSize) ? child + (long)(c + 1) * dimensions : nullptr;
+            bool crossover = dis(randGenerator) < GA_CROSSOVER_RATE;
+
+            for(int d = 0; d < dimensions; d++)
+            {
+                double x1 = p1[d], x2 = p2[d];
+                double y1 = x1, y2 = x2;
+
+                if(crossover && crossoverType == GA_CROSSOVER_SBX)
+                {
+                    double u = dis(randGenerator);
+                    double beta = (u <= 0.5) ? pow(2.0 * u, sbxExponent) : pow(1.0 / (2.0 * (1.0 - u)), sbxExponent);
+                    y1 = 0.5 * ((1.0 + beta) * x1 + (1.0 - beta) * x2);
+                    y2 = 0.5 * ((1.0 - beta) * x1 + (1.0 + beta) * x2);
+                }
+                else if(crossover)
+                {
+                    double lo = min(x1, x2);
+                    double spread = max(x1, x2) - lo;
+                    y1 = lo - GA_BLX_ALPHA * spread + (1.0 + 2.0 * GA_BLX_ALPHA) * spread * dis(randGenerator);
+                    y2 = lo - GA_BLX_ALPHA * spread + (1.0 + 2.0 * GA_BLX_ALPHA) * spread * dis(randGenerator);
+                }
+
+                // Gaussian mutation, then clamp to the bounds.
+                if(dis(randGenerator) < mutationRate)
+                    y1 += mutationSigma * gaussian(randGenerator);
+                c1[d] = min(max(y1, minBound), maxBound);
+
+                if(c2 != nullptr)
+                {
+                    if(dis(randGenerator) < mutationRate)
+                        y2 += mutationSigma * gaussian(randGenerator);
+                    c2[d] = min(max(y2, minBound), maxBound);
+                }
+            }
+        }
+
+        // Evaluate the bred children in one batch, the elites keep their fitness.
+        for(int e = 0; e < elites; e++)
+            childFitness[e] = parentFitness[order[e]];
+        evaluator.evaluate(children, childFitness, populationSize, functionID, elites);
+        evaluations += populationSize - elites;
+
+        // The children become the parents of the next generation.
+        parents.swap(children);
+        parentFitness.swap(childFitness);
+
+        // Add the best fitness of the generation to the list of best fitness values.
+        bestFitnessList.push_back(*min_element(parentFitness.begin(), parentFitness.end()));
+    }
+
+    // Return the list of best fitness values.
+    return bestFitnessList;
+}
 
 /**
- * @brief Create a neighborhood of the original vector.
+ * @brief Implementation of a decomposition search.
  *
- * @note This is used in Local Search and Iterative Local Search algorithms.
+ * A separable function (see BenchmarkFunctions.h --> functionSeparability())
+ * is n independent 1-D problems, so every element is minimized on its own by
+ * coordinateSearch() and the elements are put back together. A function
+ * whose elements all share the same term is solved once and the answer is
+ * copied to every element; otherwise the elements are split across the
+ * threads. The result is a single cycle.
  *
- * @param origVect The original vector.
- * @param origFitness The fitness or origVect.
+ * Every other function gets a cooperative coevolution: the elements are
+ * split into DS_BLOCKS_PER_THREAD blocks per thread, and each cycle improves
+ * every block in turn, one coordinate at a time, while the rest of the
+ * vector (the context vector) stays fixed. The even blocks are improved in
+ * parallel, then the odd ones. The pair terms only join neighbouring
+ * elements, so blocks that aren't neighbours never share a term and their
+ * improvements add up exactly; for Griewangk, whose product joins every
+ * element, a combination that turns out worse is replaced by adding the
+ * blocks one at a time and keeping only those that still improve the
+ * vector. Every cycle shifts the scan grid by a random fraction of its step
+ * so later cycles look between the points of the earlier ones.
+ *
+ * @note This function makes a call to SearchAlgorithms.h --> coordinateSearch().
+ * @note This function makes a call to utilities.h --> calculateFitnessOfVector().
+ *
+ * @param iterations The number of cycles (the resolution of the scan for a separable function).
  * @param functionID The ID of the function to use for calculating the fitness.
- * @param alpha The value used to mutate the original vector.
+ * @param dimensions The number of elements in each vector.
+ * @param minBound, maxBound The max/min boundaries of the search space.
+ * @param numThreads The number of threads the 1-D problems or blocks are split across.
+ * @param evaluations Set to the total number of term and full evaluations performed.
  *
- * @return The neighborhood of the original vector.
+ * @return A vector of the best fitness found after each cycle.
  */
-vector<double> createNeighborhood(vector<double> origVect, double origFitness, int functionID, double alpha)
+vector<double> decompositionSearch(int iterations, int functionID, int dimensions, double minBound, double maxBound, int numThreads, long long &evaluations)
 {
-    // Declare the neighborhood and neighbor variables.
-    vector<double> neighborhood;
-    double neighbor;
+    // Declare vector that will hold best fitness from each cycle.
+    vector<double> bestFitnessList;
+    int separability = functionSeparability(functionID);
+    if(numThreads < 1)
+        numThreads = 1;
 
-    // Make a temp variable to hold the temp fitness values.
-    double tempfitness;
+    // Every worker counts its own evaluations, they are added up at the end.
+    vector<long long> workerEvaluations(numThreads, 0);
+    evaluations = 0;
 
-    // Create the neighborhood.
-    for(int i = 0; i < origVect.size(); i++)
+    // Runs work(t) for every thread t on the worker's CPU with the caller's fitness memo, the calling thread doing t = 0.
+    FitnessMemo *memo = getFitnessMemo();
+    auto runOnThreads = [&numThreads, memo](auto work)
+    {
+        auto placedWork = [&work, memo](int t)
+        {
+            WorkerPlacement placement(t);
+            FitnessMemoScope memoScope(memo);
+            work(t);
+        };
+        vector<thread> workers;
+        for(int t = 1; t < numThreads; t++)
+            workers.emplace_back(placedWork, t);
+        placedWork(0);
+        for(int t = 0; t < workers.size(); t++)
+            workers[t].join();
+    };
+
+    // ------------------------------- Separable -------------------------------
+    if(separability != SEPARABLE_NONE)
+    {
+        // The change in fitness only depends on the element being moved, so
+        // every 1-D problem is solved from the same vector.
+        vector<double> vect(dimensions, minBound);
+        vector<double> best(vect);
+        int points = max(2, iterations * DS_SCAN_POINTS_PER_ITERATION);
+
+        if(separability == SEPARABLE_IDENTICAL)
+        {
+            coordinateSearch(vect, functionID, 0, minBound, maxBound, points, 0.0, 0.0, evaluations);
+            fill(best.begin(), best.end(), vect[0]);
+        }
+        else
+        {
+            if(numThreads > dimensions)
+                numThreads = dimensions;
+
+            // Each thread solves every numThreads-th element on its own copy of the vector.
+            runOnThreads([&](int t)
+            {
+                vector<double> local(vect);
+                for(int i = t; i < dimensions; i += numThreads)
+                {
+                    coordinateSearch(local, functionID, i, minBound, maxBound, points, 0.0, 0.0, workerEvaluations[t]);
+                    best[i] = local[i];
+                }
+            });
+        }
+
+        // Put the elements back together and score the vector exactly.
+        bestFitnessList.push_back(calculateFitnessOfVector(best, functionID));
+        evaluations++;
+        for(int t = 0; t < numThreads; t++)
+            evaluations += workerEvaluations[t];
+        return bestFitnessList;
+    }
+
+    // ------------------------- Cooperative Coevolution -----------------------
+    bestFitnessList.reserve(iterations);
+
+    // Split the elements into blocks, at most one element each for small vectors.
+    int numBlocks = min(dimensions, DS_BLOCKS_PER_THREAD * numThreads);
+    int blockSize = (dimensions + numBlocks - 1) / numBlocks;
+    numBlocks = (dimensions + blockSize - 1) / blockSize;
+
+    // Start from a random context vector.
+    mt19937 randGenerator(nextRandomSeed());
+    uniform_real_distribution<double> dis(0.0, 1.0);
+    vector<double> context(dimensions);
+    for(int i = 0; i < dimensions; i++)
+        context[i] = minBound + (maxBound - minBound) * dis(randGenerator);
+    double fitness = calculateFitnessOfVector(context, functionID);
+    evaluations = 1;
+
+    // The improved elements and the change in fitness each block proposes.
+    vector<double> proposal(context);
+    vector<double> blockDelta(numBlocks);
+    vector<double> shifts(numBlocks);
+
+    for(int cycle = 0; cycle < iterations; cycle++)
+    {
+        for(int phase = 0; phase < 2; phase++)
+        {
+            for(int b = phase; b < numBlocks; b += 2)
+                shifts[b] = dis(randGenerator);
+
+            // Each thread improves every numThreads-th block of the phase on its own copy of the context vector.
+            runOnThreads([&](int t)
+            {
+                vector<double> local;
+                for(int b = phase + 2 * t; b < numBlocks; b += 2 * numThreads)
+                {
+                    local = context;
+                    double localFitness = fitness;
+                    for(int i = b * blockSize; i < min(dimensions, (b + 1) * blockSize); i++)
+                    {
+                        localFitness += coordinateSearch(local, functionID, i, minBound, maxBound, DS_BLOCK_SCAN_POINTS, shifts[b], localFitness, workerEvaluations[t]);
+                        proposal[i] = local[i];
+                    }
+                    blockDelta[b] = localFitness - fitness;
+                }
+            });
+
+            // Apply every block of the phase at once.
+            vector<double> previous(context);
+            for(int b = phase; b < numBlocks; b += 2)
+                for(int i = b * blockSize; i < min(dimensions, (b + 1) * blockSize); i++)
+                    context[i] = proposal[i];
+            double newFitness = calculateFitnessOfVector(context, functionID);
+            evaluations++;
+
+            // If the blocks interfered, add them one at a time and keep the ones that still help.
+            if(newFitness > fitness)
+            {
+                context = previous;
+                for(int b = phase; b < numBlocks; b += 2)
+                {
+                    if(blockDelta[b] >= 0)
+                        continue;
+                    for(int i = b * blockSize; i < min(dimensions, (b + 1) * blockSize); i++)
+                        context[i] = proposal[i];
+                    double blockFitness = calculateFitnessOfVector(context, functionID);
+                    evaluations++;
+                    if(blockFitness < fitness)
+                        fitness = blockFitness;
+                    else
+                        for(int i = b * blockSize; i < min(dimensions, (b + 1) * blockSize); i++)
+                            context[i] = previous[i];
+                }
+            }
+            else
+                fitness = newFitness;
+            proposal = context;
+        }
+
+        // Add the fitness of the context vector to the list of best fitness values.
+        bestFitnessList.push_back(fitness);
+    }
+
+    for(int t = 0; t < numThreads; t++)
+        evaluations += workerEvaluations[t];
+
+    // Return the list of best fitness values.
+    return bestFitnessList;
+}
+
+/**
+ * @brief Minimizes the fitness over a single element of a vector.
+ *
+ * The element is scanned at points evenly spaced over the bounds (the
+ * grid shifted by shift steps), and the best point is refined with
+ * DS_REFINE_STEPS steps of a golden-section search over the step on each
+ * side of it. Every point is scored with calculateFitnessDelta(), which only
+ * re-evaluates the terms that contain the element; the refinement is scored
+ * against the best point of the scan, so its small changes aren't lost to
+ * round-off. The element only changes if a point improves on its current value.
+ *
+ * @note This function makes a call to utilities.h --> calculateFitnessDelta().
+ *
+ * @param vect The vector, whose element at index is set to the best value found.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param index The index of the element to minimize over.
+ * @param minBound, maxBound The max/min boundaries of the search space.
+ * @param points The number of points in the scan (at least 2).
+ * @param shift The fraction of a step, in [0, 1), the scan grid is shifted by.
+ * @param fitness The fitness of vect (only used by functions without separate terms).
+ * @param evaluations Increased by the number of points scored.
+ *
+ * @return The change in fitness caused by the new value of the element (0 if it didn't change).
+ */
+double coordinateSearch(vector<double> &vect, int functionID, int index, double minBound, double maxBound, int points, double shift, double fitness, long long &evaluations)
+{
+    double step = (maxBound - minBound) / (points - 1);
+    double bestValue = vect[index];
+    double bestDelta = 0;
+
+    // Scores a value of the element and keeps it if it is the best so far.
+    auto score = [&](double value)
     {
-        // Copy the original vector to a temporary vector.
-        vector<double> tempVect = origVect;
+        double delta = calculateFitnessDelta(vect, functionID, index, value, fitness);
+        evaluations++;
+        if(delta < bestDelta)
+        {
+            bestDelta = delta;
+            bestValue = value;
+        }
+        return delta;
+    };
 
-        // Mutate the temporary vector using alpha.
-        tempVect[i] = tempVect[i] + alpha;
+    // Dense scan of the whole range.
+    double scanValue = bestValue;
+    double scanDelta = HUGE_VAL;
+    for(int k = 0; k < points; k++)
+    {
+        double value = minBound + (k + shift) * step;
+        if(value > maxBound)
+            break;
+        double delta = score(value);
+        if(delta < scanDelta)
+        {
+            scanDelta = delta;
+            scanValue = value;
+        }
+    }
 
-        // Get the fitness of tempVect.
-        tempfitness = calculateFitnessOfVector(tempVect, functionID);
+    // Move the element to the best point so far, so the refinement measures
+    // its (small) changes against a close value instead of the old one.
+    double moved = bestDelta;
+    vect[index] = bestValue;
+    fitness += moved;
+    bestDelta = 0;
 
-        // Calculate the neighbor value.
-        neighbor = origVect[i] - (alpha * (tempfitness - origFitness));
+    // Golden-section search between the neighbours of the best point of the scan.
+    const double golden = (sqrt(5.0) - 1) / 2;
+    double a = max(minBound, scanValue - step), b = min(maxBound, scanValue + step);
+    double c = b - golden * (b - a), d = a + golden * (b - a);
+    double fc = score(c), fd = score(d);
+    for(int s = 0; s < DS_REFINE_STEPS; s++)
+    {
+        if(fc < fd)
+        {
+            b = d;
+            d = c;
+            fd = fc;
+            c = b - golden * (b - a);
+            fc = score(c);
+        }
+        else
+        {
+            a = c;
+            c = d;
+            fc = fd;
+            d = a + golden * (b - a);
+            fd = score(d);
+        }
+    }
+
+    vect[index] = bestValue;
+    return moved + bestDelta;
+}
 
-        // Add the neighbor to neighborhood.
-        neighborhood.push_back(neighbor);
+/**
+ * @brief Implementation of a multi-start L-BFGS.
+ *
+ * Each start is a random vector, descended with lbfgsDescent() until it
+ * converges. The starts are split evenly across the threads, and every
+ * thread reuses one LBFGSHistory, so the descents don't allocate.
+ *
+ * @note This function makes a call to SearchAlgorithms.h --> lbfgsDescent().
+ *
+ * @param starts The number of random starts.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param dimensions The number of elements in each vector.
+ * @param minBound, maxBound The max/min boundaries of the search space.
+ * @param numThreads The number of threads the starts are run on.
+ * @param evaluations Set to the total number of fitness (and gradient) evaluations performed.
+ *
+ * @return A vector of the best fitness found from each start.
+ */
+vector<double> limitedMemoryBFGS(int starts, int functionID, int dimensions, double minBound, double maxBound, int numThreads, long long &evaluations)
+{
+    // Declare vectors that will hold the best fitness and evaluation count of each start.
+    vector<double> bestFitnessList(starts);
+    vector<long long> startEvaluations(starts, 0);
+
+    // Every start gets its own seed derived from the same base seed.
+    unsigned int baseSeed = nextRandomSeed();
+
+    // Never use more threads than there are starts.
+    if(numThreads > starts)
+        numThreads = starts;
+    if(numThreads < 1)
+        numThreads = 1;
+
+    // Hands out the starts, the worker's own node's first.
+    NodeWorkQueue startQueue(starts, numThreads);
+
+    // Runs starts on the worker's CPU until there are none left, its buffers are created once it's there.
+    FitnessMemo *memo = getFitnessMemo();
+    auto runStarts = [&](int worker)
+    {
+        WorkerPlacement placement(worker);
+        FitnessMemoScope memoScope(memo);
+        LBFGSHistory history;
+        vector<double> vect(dimensions);
+        for(int s = startQueue.next(worker); s >= 0; s = startQueue.next(worker))
+        {
+            seed_seq seeds{baseSeed, (unsigned int)s};
+            vector<unsigned int> startSeed(1);
+            seeds.generate(startSeed.begin(), startSeed.end());
+            mt19937 randGenerator(startSeed[0]);
+            uniform_real_distribution<double> dis(minBound, maxBound);
+            for(int i = 0; i < dimensions; i++)
+                vect[i] = dis(randGenerator);
+            bestFitnessList[s] = lbfgsDescent(vect, functionID, minBound, maxBound, history, startEvaluations[s]);
+        }
+    };
+
+    // Start the descents on their threads and wait for them to finish.
+    vector<thread> workers;
+    for(int t = 1; t < numThreads; t++)
+        workers.emplace_back(runStarts, t);
+    runStarts(0);
+    for(int t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    // Add up the evaluations of all the starts.
+    evaluations = 0;
+    for(int s = 0; s < starts; s++)
+        evaluations += startEvaluations[s];
+
+    // Return the list of best fitness values.
+    return bestFitnessList;
+}
+
+/**
+ * @brief Descends from a vector with a bounded L-BFGS.
+ *
+ * The direction comes from the two-loop recursion over the last
+ * LBFGS_MEMORY steps and changes in gradient, kept as rings in the
+ * preallocated rows of the history. Elements sitting on a bound that the
+ * gradient pushes outwards are held fixed. The line search backtracks along
+ * the path projected onto the bounds (every trial vector is clamped) until
+ * the step achieves LBFGS_ARMIJO of the decrease the gradient predicts. A
+ * step whose change in gradient doesn't curve upwards isn't remembered, and
+ * a direction that doesn't descend, or a line search that fails, forgets the
+ * history and falls back to steepest descent.
+ *
+ * The fitness and gradient are calculated in one pass, analytically for the
+ * smooth functions (see utilities.h --> calculateFitnessAndGradient()).
+ *
+ * @note This function makes a call to utilities.h --> calculateFitnessAndGradient().
+ *
+ * @param vect The starting vector, left holding the best vector found.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param minBound, maxBound The max/min boundaries of the search space.
+ * @param history The memory and work vectors of the descent (sized on first use, then reused).
+ * @param evaluations Increased by the number of fitness (and gradient) evaluations performed.
+ *
+ * @return The best fitness found.
+ */
+double lbfgsDescent(vector<double> &vect, int functionID, double minBound, double maxBound, LBFGSHistory &history, long long &evaluations)
+{
+    int size = vect.size();
+    int memory = LBFGS_MEMORY;
+    double step = LBFGS_DIFFERENCE_FRACTION * (maxBound - minBound);
+
+    // Size the history, which is a no-op once it has held a vector of this size.
+    history.steps.resize((long)memory * size);
+    history.gradientChanges.resize((long)memory * size);
+    history.rho.resize(memory);
+    history.alpha.resize(memory);
+    history.direction.resize(size);
+    history.trial.resize(size);
+    vector<double> &gradient = history.gradient, &trialGradient = history.trialGradient;
+    vector<double> &direction = history.direction, &trial = history.trial;
+
+    for(int i = 0; i < size; i++)
+        vect[i] = min(max(vect[i], minBound), maxBound);
+    double fitness = calculateFitnessAndGradient(vect, functionID, gradient, step);
+    evaluations++;
+
+    // The number of remembered steps, and the row of the newest one.
+    int stored = 0, newest = memory - 1;
+
+    // True if an element sits on a bound and the gradient pushes it outwards.
+    auto isFixed = [&](int i)
+    {
+        return (vect[i] <= minBound && gradient[i] > 0) || (vect[i] >= maxBound && gradient[i] < 0);
+    };
+
+    for(int iteration = 0; iteration < LBFGS_MAX_STEPS; iteration++)
+    {
+        // Stop once the gradient of every free element vanishes.
+        double largest = 0;
+        for(int i = 0; i < size; i++)
+            if(!isFixed(i))
+                largest = max(largest, abs(gradient[i]));
+        if(largest <= LBFGS_GRADIENT_TOLERANCE)
+            break;
+
+        // Two-loop recursion: direction = -H * gradient, on the free elements.
+        for(int i = 0; i < size; i++)
+            direction[i] = isFixed(i) ? 0.0 : -gradient[i];
+        for(int k = 0; k < stored; k++)
+        {
+            int row = (newest - k + memory) % memory;
+            const double *s = &history.steps[(long)row * size], *y = &history.gradientChanges[(long)row * size];
+            double a = 0;
+            for(int i = 0; i < size; i++)
+                a += s[i] * direction[i];
+            a *= history.rho[row];
+            history.alpha[row] = a;
+            for(int i = 0; i < size; i++)
+                direction[i] -= a * y[i];
+        }
+
+        // Scale by the curvature of the newest step, or keep the first step within a fraction of the range.
+        double scale = min(1.0, LBFGS_FIRST_STEP_FRACTION * (maxBound - minBound) / largest);
+        if(stored > 0)
+        {
+            const double *y = &history.gradientChanges[(long)newest * size];
+            double yy = 0;
+            for(int i = 0; i < size; i++)
+                yy += y[i] * y[i];
+            scale = 1.0 / (history.rho[newest] * yy);
+        }
+        for(int i = 0; i < size; i++)
+            direction[i] *= scale;
+
+        for(int k = stored - 1; k >= 0; k--)
+        {
+            int row = (newest - k + memory) % memory;
+            const double *s = &history.steps[(long)row * size], *y = &history.gradientChanges[(long)row * size];
+            double b = 0;
+            for(int i = 0; i < size; i++)
+                b += y[i] * direction[i];
+            b = history.alpha[row] - history.rho[row] * b;
+            for(int i = 0; i < size; i++)
+                direction[i] += b * s[i];
+        }
+
+        // Hold the fixed elements, and fall back to steepest descent if the direction doesn't descend.
+        double slope = 0;
+        for(int i = 0; i < size; i++)
+        {
+            if(isFixed(i))
+                direction[i] = 0;
+            slope += gradient[i] * direction[i];
+        }
+        if(!(slope < 0))
+        {
+            if(stored == 0)
+                break;
+            stored = 0;
+            continue;
+        }
+
+        // Backtracking line search along the path projected onto the bounds.
+        double t = 1;
+        double trialFitness = fitness;
+        bool accepted = false;
+        for(int b = 0; b < LBFGS_MAX_BACKTRACKS && !accepted; b++, t *= LBFGS_BACKTRACK)
+        {
+            double predicted = 0;
+            for(int i = 0; i < size; i++)
+            {
+                trial[i] = min(max(vect[i] + t * direction[i], minBound), maxBound);
+                predicted += gradient[i] * (trial[i] - vect[i]);
+            }
+            trialFitness = calculateFitnessAndGradient(trial, functionID, trialGradient, step);
+            evaluations++;
+            accepted = trialFitness <= fitness + LBFGS_ARMIJO * predicted;
+        }
+
+        // A failed line search forgets the history once, then gives up.
+        if(!accepted)
+        {
+            if(stored == 0)
+                break;
+            stored = 0;
+            continue;
+        }
+
+        // Remember the step and its change in gradient if they curve upwards.
+        double sy = 0, yy = 0;
+        for(int i = 0; i < size; i++)
+        {
+            double s = trial[i] - vect[i], y = trialGradient[i] - gradient[i];
+            sy += s * y;
+            yy += y * y;
+        }
+        if(sy > LBFGS_CURVATURE_TOLERANCE * yy)
+        {
+            newest = (newest + 1) % memory;
+            double *s = &history.steps[(long)newest * size], *y = &history.gradientChanges[(long)newest * size];
+            for(int i = 0; i < size; i++)
+            {
+                s[i] = trial[i] - vect[i];
+                y[i] = trialGradient[i] - gradient[i];
+            }
+            history.rho[newest] = 1.0 / sy;
+            stored = min(stored + 1, memory);
+        }
+
+        // Move to the trial vector.
+        double previousFitness = fitness;
+        vect.swap(trial);
+        gradient.swap(trialGradient);
+        fitness = trialFitness;
+
+        // Stop once the fitness stops improving.
+        if(previousFitness - fitness <= LBFGS_FITNESS_TOLERANCE * max(1.0, abs(fitness)))
+            break;
     }
 
+    return fitness;
+}
+
+
+
+/**
+ * @brief Create a neighborhood of the original vector.
+ *
+ * Every element takes a step against its forward difference:
+ * neighbor_i = x_i - alpha * (f(x + alpha*e_i) - f(x)).
+ *
+ * @note This is used in Local Search and Iterative Local Search algorithms.
+ * @note This function makes a call to utilities.h --> calculateFitnessDifferences().
+ *
+ * @param origVect The original vector.
+ * @param origFitness The fitness or origVect.
+ * @param functionID The ID of the function to use for calculating the fitness.
+ * @param alpha The value used to mutate the original vector.
+ *
+ * @return The neighborhood of the original vector.
+ */
+vector<double> createNeighborhood(vector<double> &origVect, double origFitness, int functionID, double alpha)
+{
+    // Get the change in fitness from stepping each element by alpha, all in one pass.
+    vector<double> neighborhood = calculateFitnessDifferences(origVect, functionID, alpha, origFitness);
+
+    // Calculate the neighbor values.
+    for(int i = 0; i < origVect.size(); i++)
+        neighborhood[i] = origVect[i] - (alpha * neighborhood[i]);
+
     // Return the neighborhood.
     return neighborhood;
 }
\ No newline at end of file
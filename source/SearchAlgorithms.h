@@ -9,21 +9,192 @@
 #define BENCHMARKFUNCTIONS2_SEARCHALGORITHMS_H
 
 #include <vector>
+#include <numeric>
+#include <atomic>
+#include <limits>
+#include <thread>
 #include "utilities.h"
+#include "DataStructs.h"
+#include "LinearAlgebra.h"
+#include "SharedBest.h"
+#include "Sampler.h"
+#include "TermTable.h"
+#include "Topology.h"
+#include "PopulationEvaluator.h"
 
 using namespace std;
 
+// -------------- CONSTANTS --------------
+/** The inertia weight used in the Particle Swarm velocity update. */
+#define PSO_INERTIA 0.7298
+/** The cognitive (personal best) acceleration coefficient of the Particle Swarm. */
+#define PSO_COGNITIVE 1.49618
+/** The social (global best) acceleration coefficient of the Particle Swarm. */
+#define PSO_SOCIAL 1.49618
+
+/** The most steps a local descent takes (a descent crawling along a flat region could otherwise go on for hours). */
+#define LS_MAX_STEPS 1000000
+
+/** The number of local descents localSearchBatch() runs in lockstep. */
+#define LS_BATCH_LANES 8
+
+/** Local Search steps every element by alpha times its forward difference (the original scheme). */
+#define LS_MODE_FIXED 0
+/** Local Search moves one element at a time, each with its own step length that grows and shrinks. */
+#define LS_MODE_ADAPTIVE 1
+/** The central difference that finds an element's downhill direction probes this fraction of its step length. */
+#define LS_ADAPTIVE_PROBE_FRACTION 1e-3
+/** The fraction of the decrease predicted by the slope a move has to achieve (the Armijo condition). */
+#define LS_ADAPTIVE_ARMIJO 1e-4
+/** The factor an element's step length grows by after a successful move. */
+#define LS_ADAPTIVE_GROWTH 2.0
+/** The factor an element's step length shrinks by after a rejected move. */
+#define LS_ADAPTIVE_SHRINK 0.5
+/** The most times an element's move is shrunk in one sweep. */
+#define LS_ADAPTIVE_BACKTRACKS 30
+/** An adaptive descent stops once a sweep improves the fitness by less than this fraction of it. */
+#define LS_ADAPTIVE_TOLERANCE 1e-12
+
+/** The probability that an Iterated Local Search restart starts from a random point instead of a perturbed optimum. */
+#define ILS_RESTART_PROBABILITY 0.2
+/** The standard deviation of an Iterated Local Search perturbation, as a fraction of the bound range. */
+#define ILS_PERTURBATION_FRACTION 0.1
+
+/** Simulated Annealing cooling schedule: T = T0 * (Tf/T0)^progress. */
+#define COOLING_EXPONENTIAL 1
+/** Simulated Annealing cooling schedule: T = T0 + (Tf - T0) * progress. */
+#define COOLING_LINEAR 2
+/** Simulated Annealing cooling schedule: T = T0 / (1 + c*log(1 + step)), with c chosen to end at Tf. */
+#define COOLING_LOGARITHMIC 3
+/** The number of single-coordinate moves per chain, per iteration and dimension. */
+#define SA_MOVES_PER_DIMENSION 100
+/** The number of moves made at each temperature before cooling. */
+#define SA_MOVES_PER_TEMPERATURE 100
+/** The number of random moves used to calibrate the initial temperature. */
+#define SA_CALIBRATION_MOVES 100
+/** The probability of accepting an average uphill move at the initial temperature. */
+#define SA_INITIAL_ACCEPTANCE 0.8
+/** The ratio of the final temperature to the initial temperature. */
+#define SA_FINAL_TEMPERATURE_RATIO 1e-4
+/** The largest move, as a fraction of the bound range, made at the initial temperature. */
+#define SA_STEP_FRACTION 0.1
+/** The smallest move, as a fraction of the bound range. */
+#define SA_MIN_STEP_FRACTION 1e-4
+/** The number of moves per dimension after which a chain's fitness is re-evaluated to remove drift. */
+#define SA_RESYNC_MOVES_PER_DIMENSION 100
+
+/** The number of CMA-ES generations per configured iteration. */
+#define CMAES_GENERATIONS_PER_ITERATION 10
+/** The initial CMA-ES step size, as a fraction of the bound range. */
+#define CMAES_INITIAL_SIGMA_FRACTION 0.3
+/** Divisor used to space out the lazy covariance/eigen updates: every 1/((c1+cmu)*n*factor) generations. */
+#define CMAES_EIGEN_INTERVAL_FACTOR 10
+/** CMA-ES stops once its largest step, as a fraction of the bound range, falls below this. */
+#define CMAES_STEP_TOLERANCE 1e-12
+
+/** The number of Genetic Algorithm generations per configured iteration. */
+#define GA_GENERATIONS_PER_ITERATION 10
+/** Genetic Algorithm blend crossover (BLX-alpha). */
+#define GA_CROSSOVER_BLEND 1
+/** Genetic Algorithm simulated binary crossover (SBX). */
+#define GA_CROSSOVER_SBX 2
+/** The number of parents competing in each tournament selection. */
+#define GA_TOURNAMENT_SIZE 2
+/** The probability that a pair of parents is recombined rather than copied. */
+#define GA_CROSSOVER_RATE 0.9
+/** The alpha of the blend crossover: how far children may land outside their parents. */
+#define GA_BLX_ALPHA 0.5
+/** The distribution index of the simulated binary crossover: larger keeps children closer to their parents. */
+#define GA_SBX_ETA 15.0
+/** The standard deviation of the Gaussian mutation, as a fraction of the bound range. */
+#define GA_MUTATION_SIGMA_FRACTION 0.1
+/** The fraction of each generation copied unchanged into the next. */
+#define GA_ELITE_FRACTION 0.1
+
+/** The number of points in the dense scan of each 1-D problem of a separable function, per configured iteration. */
+#define DS_SCAN_POINTS_PER_ITERATION 1000
+/** The number of points scanned for each coordinate of a block in every cooperative coevolution cycle. */
+#define DS_BLOCK_SCAN_POINTS 100
+/** The number of golden-section steps that refine the best point of a scan. */
+#define DS_REFINE_STEPS 60
+/** The number of coordinate blocks per thread in the cooperative coevolution (half of them are optimized at a time). */
+#define DS_BLOCKS_PER_THREAD 2
+
+/** The number of steps (and changes in gradient) an L-BFGS descent remembers. */
+#define LBFGS_MEMORY 10
+/** The most steps an L-BFGS descent takes. */
+#define LBFGS_MAX_STEPS 10000
+/** An L-BFGS descent stops once no free element has a derivative larger than this. */
+#define LBFGS_GRADIENT_TOLERANCE 1e-10
+/** An L-BFGS descent stops once a step improves the fitness by less than this fraction of it. */
+#define LBFGS_FITNESS_TOLERANCE 1e-15
+/** A step is only remembered if step . change in gradient is above this fraction of |change in gradient|^2. */
+#define LBFGS_CURVATURE_TOLERANCE 1e-10
+/** The fraction of the decrease predicted by the gradient a step has to achieve (the Armijo condition). */
+#define LBFGS_ARMIJO 1e-4
+/** The factor the line search shrinks a rejected step by. */
+#define LBFGS_BACKTRACK 0.5
+/** The most times the line search shrinks a step. */
+#define LBFGS_MAX_BACKTRACKS 50
+/** The largest first step of a descent (before it has any history), as a fraction of the bound range. */
+#define LBFGS_FIRST_STEP_FRACTION 0.1
+/** The step of the central differences of the functions without an analytic gradient, as a fraction of the bound range. */
+#define LBFGS_DIFFERENCE_FRACTION 1e-7
+
 /** Uses Blind Search algorithm and returns the best fitness found. */
-double blindSearch(int iterations, vector<double> argBest, double fitness0, int functionID, int rows, int columns, double minBound, double maxBound);
+double blindSearch(int iterations, vector<double> argBest, double fitness0, int functionID, int rows, int columns, double minBound, double maxBound, int samplerType = SAMPLER_RANDOM, const TermTable *table = nullptr);
 
 /** Uses Local Search algorithm and returns the best fitness found. */
-double localSearch(vector<double> argBest, int functionID, double alpha);
+double localSearch(vector<double> argBest, int functionID, double alpha, long long &evaluations, int mode = LS_MODE_FIXED);
+
+/** Descends from a vector with Local Search and returns the best fitness found, leaving the best vector in argBest. */
+double localDescent(vector<double> &argBest, int functionID, double alpha, long long &evaluations);
+
+/** Descends from a vector one element at a time, with adaptive step lengths, and returns the best fitness found, leaving the best vector in argBest. */
+double adaptiveLocalDescent(vector<double> &argBest, int functionID, double alpha, long long &evaluations);
+
+/** Returns the Local Search mode named fixed or adaptive, or -1. */
+int parseLocalSearchMode(string name);
+
+/** Runs independent local descents in lockstep (interleaved lanes, refilled as descents end) and returns the best fitness found from each start.*/
+vector<double> localSearchBatch(vector<vector<double>> &starts, int functionID, double alpha, int lanes = LS_BATCH_LANES);
+
+/** Uses multi-start Iterated Local Search with parallel restarts and returns a list of the best fitness found. */
+vector<double> iterativeLocalSearch(int iterations, vector<double> argBest, int functionID, double alpha, double minBound, double maxBound, int numThreads, long long &evaluations,
+                                   int samplerType = SAMPLER_RANDOM, int localSearchMode = LS_MODE_FIXED);
+
+/** Uses Particle Swarm Optimization and returns a list of the best fitness found in each iteration. */
+vector<double> particleSwarmOptimization(int iterations, int particles, int functionID, int dimensions, double minBound, double maxBound, int numThreads, long long &evaluations);
+
+/** Uses Simulated Annealing on independent parallel chains and returns the best fitness found by each chain. */
+vector<double> simulatedAnnealing(int chains, long long movesPerChain, int functionID, int dimensions, double minBound, double maxBound, int coolingSchedule, int numThreads, long long &evaluations);
+
+/** Runs a single Simulated Annealing chain and returns the best fitness found. */
+double annealingChain(long long moves, int functionID, int dimensions, double minBound, double maxBound, int coolingSchedule, unsigned int seed, long long &evaluations);
+
+/** Returns the annealing temperature after a number of moves for a cooling schedule.*/
+double coolingTemperature(int coolingSchedule, double initialTemp, double finalTemp, long long move, long long totalMoves);
+
+/** Uses the CMA-ES (Covariance Matrix Adaptation Evolution Strategy) and returns a list of the best fitness found in each generation. */
+vector<double> covarianceMatrixAdaptation(int generations, int functionID, int dimensions, double minBound, double maxBound, int numThreads, long long &evaluations);
+
+/** Uses a real-coded Genetic Algorithm and returns a list of the best fitness found in each generation. */
+vector<double> geneticAlgorithm(int generations, int populationSize, int functionID, int dimensions, double minBound, double maxBound, int crossoverType, int numThreads, long long &evaluations);
+
+/** Solves a separable function as independent 1-D problems (cooperative coevolution over coordinate blocks for the others) and returns a list of the best fitness found in each cycle. */
+vector<double> decompositionSearch(int iterations, int functionID, int dimensions, double minBound, double maxBound, int numThreads, long long &evaluations);
+
+/** Minimizes the fitness over one element of a vector with a dense scan and a golden-section refinement, and returns the change in fitness.*/
+double coordinateSearch(vector<double> &vect, int functionID, int index, double minBound, double maxBound, int points, double shift, double fitness, long long &evaluations);
+
+/** Uses L-BFGS from random starts, split across threads, and returns the best fitness found from each start. */
+vector<double> limitedMemoryBFGS(int starts, int functionID, int dimensions, double minBound, double maxBound, int numThreads, long long &evaluations);
 
-/** Uses Iterative Local Search algorithm and returns a list of the best fitness found. */
-vector<double> iterativeLocalSearch(int iterations, vector<double> argBest, int functionID, double alpha);
+/** Descends from a vector with a bounded L-BFGS and returns the best fitness found, leaving the best vector in vect. */
+double lbfgsDescent(vector<double> &vect, int functionID, double minBound, double maxBound, LBFGSHistory &history, long long &evaluations);
 
 /** Creates a neighborhood of a vector using an alpha value and original vector.*/
-vector<double> createNeighborhood(vector<double> origVect, double origFitness, int functionID, double alpha);
+vector<double> createNeighborhood(vector<double> &origVect, double origFitness, int functionID, double alpha);
 
 
 
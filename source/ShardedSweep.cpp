@@ -0,0 +1,404 @@
+/**
+ * @file ShardedSweep.cpp
+ * @class ShardedSweep ShardedSweep.h "ShardedSweep.h"
+ * @author  Al Timofeyev
+ * @date    May 10, 2019
+ * @brief   Splits the dimension x function sweep of a configuration file
+ *          into shards that are run by separate worker processes (on this
+ *          machine or any machine sharing the shard directory), and merges
+ *          their results back into the usual analysis files.
+ *
+ * Every function line of the configuration file, at every listed dimension,
+ * is one shard. The coordinator lists the shards in the manifest of the shard
+ * directory; a worker claims a shard by creating its claim file, which only
+ * one worker can do, runs the search algorithms on it and saves the raw
+ * results next to the claim. Once every shard has its results, they are
+ * merged in configuration file order and analyzed exactly as a normal run
+ * would, so the search algorithm analysis files come out the same.
+ *
+ * Shards that already have results are never run again, so an interrupted
+ * sweep is resumed by running the coordinator (or workers) again. If a worker
+ * died while running a shard, delete that shard's claim file first.
+ */
+
+#include "ShardedSweep.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define SHARDED_SWEEP_HAS_PROCESSES
+#endif
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief The constructor for the ShardedSweep class.
+ * @param shardDirectory The directory shared by the coordinator and the workers.
+ */
+ShardedSweep::ShardedSweep(string shardDirectory)
+{
+    shardDir = shardDirectory;
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PUBLIC FUNCTIONS BELOW ------------------
+// ----------------------------------------------------------
+/**
+ * @brief Shards a sweep, runs it on local worker processes and merges the results.
+ *
+ * The local workers are forked processes, so each one has its own heap and
+ * its own copy of every matrix; they split the hardware threads between them.
+ * Workers started on other machines with the same shard directory help out
+ * while the local ones run. Where processes can't be forked, the shards are
+ * run by this process.
+ *
+ * @param configFilename    The configuration file with the dimensions and functions to sweep.
+ * @param localWorkers      The number of worker processes started on this machine.
+ *
+ * @return True if every shard finished and the results were merged, false otherwise.
+ */
+bool ShardedSweep::coordinate(string configFilename, int localWorkers)
+{
+    if(!writeManifest(configFilename))
+        return false;
+
+    // Split the hardware threads between the workers.
+    if(localWorkers < 1)
+        localWorkers = 1;
+    int threads = thread::hardware_concurrency() / localWorkers;
+    if(threads < 1)
+        threads = 1;
+
+#ifdef SHARDED_SWEEP_HAS_PROCESSES
+    // Start the workers.
+    vector<pid_t> workers;
+    cout.flush();
+    for(int i = 0; i < localWorkers; i++)
+    {
+        pid_t pid = fork();
+        if(pid == 0)
+        {
+            // Give every worker its own random numbers.
+            setRandomSeed(random_device()());
+            work(threads);
+            cout.flush();
+            _exit(0);
+        }
+        if(pid > 0)
+            workers.push_back(pid);
+    }
+
+    // Run the shards here if no worker could be started.
+    if(workers.size() == 0)
+        work(threads);
+
+    // Wait for the workers to finish.
+    for(int i = 0; i < workers.size(); i++)
+    {
+        int status;
+        waitpid(workers[i], &status, 0);
+    }
+#else
+    work(threads);
+#endif
+
+    return merge();
+}
+
+/**
+ * @brief Claims and runs shards until none are left.
+ *
+ * The shards are tried in manifest order; those that are already claimed,
+ * or already have results, are skipped.
+ *
+ * @param threads The number of threads used by the multithreaded search algorithms.
+ *
+ * @return The number of shards this worker ran, or -1 if the manifest couldn't be read.
+ */
+int ShardedSweep::work(int threads)
+{
+    if(!readManifest())
+        return -1;
+
+    int shardsRun = 0;
+    for(int i = 0; i < shards.size(); i++)
+    {
+        if(!claimShard(shards[i]))
+            continue;
+
+        if(runShard(shards[i], threads))
+            shardsRun++;
+        else
+            cout << "Failed to save the results of " << shards[i].name << endl;
+    }
+
+    return shardsRun;
+}
+
+/**
+ * @brief Merges the shard results into the search algorithm analysis files.
+ *
+ * The results of every dimension are loaded in configuration file order,
+ * analyzed and saved to the same file a normal run of the configuration
+ * file saves to.
+ *
+ * @note This function makes a call to ProcessFunctions.h --> loadSearchAlgResultsFromFile().
+ *
+ * @return True if every shard had results, false otherwise.
+ */
+bool ShardedSweep::merge()
+{
+    if(!readManifest())
+        return false;
+
+    // The dimensions, in the order they were listed.
+    vector<int> dimensions;
+    for(int i = 0; i < shards.size(); i++)
+        if(find(dimensions.begin(), dimensions.end(), shards[i].dimensions) == dimensions.end())
+            dimensions.push_back(shards[i].dimensions);
+
+    bool isComplete = true;
+    for(int d = 0; d < dimensions.size(); d++)
+    {
+        ProcessFunctions procFuncs;
+        procFuncs.setNumOfDimensions(dimensions[d]);
+
+        // Load the results of every shard with this dimension.
+        bool hasAllResults = true;
+        for(int i = 0; i < shards.size(); i++)
+        {
+            if(shards[i].dimensions != dimensions[d])
+                continue;
+
+            if(!procFuncs.loadSearchAlgResultsFromFile(shardPath(shards[i], SHARD_RESULT_EXTENSION)))
+            {
+                cout << "Missing the results of " << shards[i].name << " (" << shards[i].dimensions;
+                cout << " dimensions: " << shards[i].configLine << ")" << endl;
+                hasAllResults = false;
+            }
+        }
+
+        if(!hasAllResults)
+        {
+            isComplete = false;
+            continue;
+        }
+
+        // Analyze the results and save them to file.
+        procFuncs.analyzeAllSearchAlgorithmResults();
+        procFuncs.saveAllAnalyzedSearchAlgDataToFile(configFilename);
+    }
+
+    return isComplete;
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PRIVATE FUNCTIONS BELOW -----------------
+// ----------------------------------------------------------
+/**
+ * @brief Splits the configuration file into shards and lists them in the manifest.
+ *
+ * The first line of the manifest is the configuration filename, and every
+ * other line is one shard:
+ *      <name>,<dimensions>,<functionID>,<minBound>,<maxBound>
+ *
+ * @note This function makes a call to utilities.h --> parseNumbers().
+ *
+ * @param configFilename The configuration file with the dimensions and functions to sweep.
+ *
+ * @return True if the manifest was written, false otherwise.
+ */
+bool ShardedSweep::writeManifest(string configFilename)
+{
+    ifstream configFile;
+    configFile.open(configFilename);
+    if(configFile.fail())
+    {
+        cout << "Failed to open file: " << configFilename << endl;
+        return false;
+    }
+
+    // The first line holds the dimensions, every other line a function.
+    string line, error;
+    vector<int> dimensions;
+    vector<double> vals;
+    vector<string> functionLines;
+    getline(configFile, line);
+    if(!parseNumbers(line, ",", dimensions, error))
+    {
+        cout << lineError(configFilename, 1, error) << endl;
+        return false;
+    }
+    for(int lineNumber = 2; getline(configFile, line); lineNumber++)
+    {
+        if(line.size() > 0 && line.back() == '\r')
+            line.pop_back();
+
+        // Check the line here, so workers never get a shard they can't parse.
+        if(!parseNumbers(line, ",", vals, error))
+        {
+            cout << lineError(configFilename, lineNumber, error) << endl;
+            return false;
+        }
+        if(vals.size() > 0)
+            functionLines.push_back(line);
+    }
+    configFile.close();
+
+    // One shard for every function at every dimension.
+    this->configFilename = configFilename;
+    shards.resize(0);
+    for(int d = 0; d < dimensions.size(); d++)
+    {
+        for(int f = 0; f < functionLines.size(); f++)
+        {
+            SweepShard shard;
+            shard.name = "shard-" + to_string(d) + "-" + to_string(f);
+            shard.dimensions = dimensions[d];
+            shard.configLine = functionLines[f];
+            shards.push_back(shard);
+        }
+    }
+
+#ifdef SHARDED_SWEEP_HAS_PROCESSES
+    mkdir(shardDir.c_str(), 0755);
+#endif
+
+    // Write the manifest under a temporary name, so workers never read half of it.
+    string manifestFilename = shardDir + "/" + SHARD_MANIFEST_FILENAME;
+    ofstream manifestFile;
+    manifestFile.open(manifestFilename + SHARD_PARTIAL_EXTENSION);
+    if(manifestFile.fail())
+    {
+        cout << "Failed to create the manifest in: " << shardDir << endl;
+        return false;
+    }
+
+    manifestFile << configFilename << "\n";
+    for(int i = 0; i < shards.size(); i++)
+        manifestFile << shards[i].name << "," << shards[i].dimensions << "," << shards[i].configLine << "\n";
+    manifestFile.close();
+
+    return !manifestFile.fail() && rename((manifestFilename + SHARD_PARTIAL_EXTENSION).c_str(), manifestFilename.c_str()) == 0;
+}
+
+/**
+ * @brief Reads the configuration filename and the shards from the manifest.
+ * @return True if the manifest was read, false otherwise.
+ */
+bool ShardedSweep::readManifest()
+{
+    ifstream manifestFile;
+    manifestFile.open(shardDir + "/" + SHARD_MANIFEST_FILENAME);
+    if(manifestFile.fail())
+    {
+        cout << "Failed to open the manifest in: " << shardDir << endl;
+        return false;
+    }
+
+    getline(manifestFile, configFilename);
+
+    // Every other line is <name>,<dimensions>,<function line>.
+    string line;
+    shards.resize(0);
+    for(int lineNumber = 2; getline(manifestFile, line); lineNumber++)
+    {
+        string_view rest = line, name, dimensions;
+        SweepShard shard;
+        if(!nextToken(rest, ",", name) || !nextToken(rest, ",", dimensions) || !parseNumber(dimensions, shard.dimensions))
+        {
+            cout << lineError(shardDir + "/" + SHARD_MANIFEST_FILENAME, lineNumber, "expected <name>,<dimensions>,<function line>") << endl;
+            return false;
+        }
+
+        shard.name = string(name);
+        rest.remove_prefix(rest.size() > 0 ? 1 : 0);
+        shard.configLine = string(rest);
+        shards.push_back(shard);
+    }
+
+    manifestFile.close();
+    return true;
+}
+
+/**
+ * @brief Claims a shard, returns false if another worker already has.
+ *
+ * The claim file is created exclusively, so when several workers try to
+ * claim the same shard only one of them succeeds.
+ *
+ * @param shard The shard to claim.
+ *
+ * @return True if this worker now owns the shard, false otherwise.
+ */
+bool ShardedSweep::claimShard(SweepShard &shard)
+{
+    // Finished by an earlier run.
+    ifstream resultFile(shardPath(shard, SHARD_RESULT_EXTENSION));
+    if(resultFile.good())
+        return false;
+
+    FILE *claimFile = fopen(shardPath(shard, SHARD_CLAIM_EXTENSION).c_str(), "wx");
+    if(claimFile == NULL)
+        return false;
+
+    // Record who claimed it, to help clean up after a worker that died.
+#ifdef SHARDED_SWEEP_HAS_PROCESSES
+    char hostname[256] = "";
+    gethostname(hostname, sizeof(hostname) - 1);
+    fprintf(claimFile, "%s,%d\n", hostname, (int)getpid());
+#endif
+    fclose(claimFile);
+    return true;
+}
+
+/**
+ * @brief Runs the search algorithms for one shard and saves the raw results.
+ *
+ * The results are written to a temporary file that is renamed once it's
+ * complete, so a shard only has results if they were saved in full.
+ *
+ * @note This function makes a call to utilities.h --> parseStringDbl() and prepForFunctionMatrix().
+ * @note This function makes a call to ProcessFunctions.h --> saveSearchAlgResultsToFile().
+ *
+ * @param shard     The shard to run.
+ * @param threads   The number of threads used by the multithreaded search algorithms.
+ *
+ * @return True if the results were saved, false otherwise.
+ */
+bool ShardedSweep::runShard(SweepShard &shard, int threads)
+{
+    ProcessFunctions procFuncs;
+    procFuncs.setNumOfThreads(threads);
+    procFuncs.setNumOfDimensions(shard.dimensions);
+
+    // Construct the matrix from the function line.
+    vector<double> vals = parseStringDbl(shard.configLine, ",");
+    prepForFunctionMatrix(vals);
+    procFuncs.constructMatrix(vals[0], vals[1], vals[2]);
+
+    // Run all the search algorithms.
+    procFuncs.calculateFitnessOfAllMatrices();
+    procFuncs.performAllSearchAlgorithms();
+
+    // Save the results and publish them.
+    string partialFilename = shardPath(shard, SHARD_PARTIAL_EXTENSION);
+    if(!procFuncs.saveSearchAlgResultsToFile(partialFilename))
+        return false;
+    return rename(partialFilename.c_str(), shardPath(shard, SHARD_RESULT_EXTENSION).c_str()) == 0;
+}
+
+/**
+ * @brief Returns the path of one of a shard's files.
+ * @param shard     The shard.
+ * @param extension One of the SHARD_..._EXTENSION constants.
+ * @return The path of the file in the shard directory.
+ */
+string ShardedSweep::shardPath(SweepShard &shard, string extension)
+{
+    return shardDir + "/" + shard.name + extension;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file ShardedSweep.h
+ * @author  Al Timofeyev
+ * @date    May 10, 2019
+ * @brief   Splits the dimension x function sweep of a configuration file
+ *          into shards that are run by separate worker processes (on this
+ *          machine or any machine sharing the shard directory), and merges
+ *          their results back into the usual analysis files.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_SHARDEDSWEEP_H
+#define BENCHMARKFUNCTIONS2_SHARDEDSWEEP_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdio>
+#include "ProcessFunctions.h"
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** The file in the shard directory that lists the configuration file and every shard. */
+#define SHARD_MANIFEST_FILENAME "manifest.txt"
+/** Created (exclusively) by the worker that runs a shard. */
+#define SHARD_CLAIM_EXTENSION ".claim"
+/** Holds the raw results of a finished shard. */
+#define SHARD_RESULT_EXTENSION ".csv"
+/** Holds the results of a shard while they are written, renamed once complete. */
+#define SHARD_PARTIAL_EXTENSION ".tmp"
+
+class ShardedSweep{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    ShardedSweep(string shardDirectory);
+
+    // --------------------- Functions Declarations ---------------------
+    bool coordinate(string configFilename, int localWorkers);   /**< Shards a sweep, runs it on local worker processes and merges the results.*/
+    int work(int threads);                                      /**< Claims and runs shards until none are left, returns how many were run.*/
+    bool merge();                                               /**< Merges the shard results into the search algorithm analysis files.*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    string shardDir;
+    string configFilename;
+    vector<SweepShard> shards;
+
+    // --------------------- Functions Declarations ---------------------
+    bool writeManifest(string configFilename);  /**< Splits the configuration file into shards and lists them in the manifest.*/
+    bool readManifest();                        /**< Reads the configuration filename and the shards from the manifest.*/
+    bool claimShard(SweepShard &shard);         /**< Claims a shard, returns false if another worker already has.*/
+    bool runShard(SweepShard &shard, int threads);  /**< Runs the search algorithms for one shard and saves the raw results.*/
+    string shardPath(SweepShard &shard, string extension);  /**< Returns the path of one of a shard's files.*/
+};
+
+
+#endif //BENCHMARKFUNCTIONS2_SHARDEDSWEEP_H
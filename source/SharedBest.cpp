@@ -0,0 +1,117 @@
+/**
+ * @file SharedBest.cpp
+ * @class SharedBest SharedBest.h "SharedBest.h"
+ * @author  Al Timofeyev
+ * @date    May 6, 2019
+ * @brief   A best-so-far board that concurrent searches share without
+ *          taking a lock on the hot path.
+ *
+ * The best fitness is an atomic that is only ever lowered with
+ * compare-and-swap, so a search can check it (e.g. to prune) at the cost
+ * of one load. The vector that produced it is protected by a seqlock:
+ * writers make the sequence odd while they copy the vector in, and
+ * readers copy it out and retry if the sequence changed under them.
+ * Readers never block writers, and writers only wait on each other.
+ */
+
+#include "SharedBest.h"
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief The constructor for the SharedBest class.
+ * @param dimensions The number of elements in each vector published.
+ */
+SharedBest::SharedBest(int dimensions) : bestVect(dimensions)
+{
+    bestFitness = numeric_limits<double>::infinity();
+    vectorFitness = numeric_limits<double>::infinity();
+    sequence = 0;
+}
+
+// -------------------------------------------------------------------------------------------
+// --------------------------------- PUBLIC FUNCTIONS BELOW ----------------------------------
+// -------------------------------------------------------------------------------------------
+/**
+ * @brief Publishes a vector if its fitness is better than the best so far.
+ *
+ * The fitness is published first, so other searches see it right away. The
+ * vector is then copied in under the seqlock, unless an even better vector
+ * was published in the meantime.
+ *
+ * @param vect The vector that produced the fitness.
+ * @param fitness The fitness of vect.
+ *
+ * @return True if vect became the best vector, false otherwise.
+ */
+bool SharedBest::offer(const vector<double> &vect, double fitness)
+{
+    // Lower the best fitness, retrying if another search changed it first.
+    double current = bestFitness.load();
+    do
+    {
+        if(!(fitness < current))
+            return false;
+    } while(!bestFitness.compare_exchange_weak(current, fitness));
+
+    // Take the write side of the seqlock (make the sequence odd).
+    unsigned long seq = sequence.load(memory_order_relaxed);
+    do
+    {
+        while(seq & 1)
+            seq = sequence.load(memory_order_relaxed);
+    } while(!sequence.compare_exchange_weak(seq, seq + 1, memory_order_acquire, memory_order_relaxed));
+    atomic_thread_fence(memory_order_release);
+
+    // Only write the vector if nothing better was published in the meantime.
+    bool isBest = fitness < vectorFitness.load(memory_order_relaxed) && fitness == bestFitness.load(memory_order_relaxed);
+    if(isBest)
+    {
+        for(size_t i = 0; i < bestVect.size(); i++)
+            bestVect[i].store(vect[i], memory_order_relaxed);
+        vectorFitness.store(fitness, memory_order_relaxed);
+    }
+
+    // Release the seqlock (make the sequence even again).
+    sequence.store(seq + 2, memory_order_release);
+    return isBest;
+}
+
+/**
+ * @brief Returns the best fitness published so far.
+ * @return The best fitness, or infinity if nothing was published.
+ */
+double SharedBest::getFitness()
+{
+    return bestFitness.load();
+}
+
+/**
+ * @brief Copies the best vector published so far.
+ *
+ * The copy is retried until no writer changed the vector during it, so the
+ * vector and the returned fitness always belong together.
+ *
+ * @param vect Where to copy the best vector (resized to the number of dimensions).
+ *
+ * @return The fitness of the copied vector, or infinity if nothing was published.
+ */
+double SharedBest::read(vector<double> &vect)
+{
+    vect.resize(bestVect.size());
+    while(true)
+    {
+        unsigned long before = sequence.load(memory_order_acquire);
+        if(before & 1)
+            continue;
+
+        for(size_t i = 0; i < bestVect.size(); i++)
+            vect[i] = bestVect[i].load(memory_order_relaxed);
+        double fitness = vectorFitness.load(memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        if(sequence.load(memory_order_relaxed) == before)
+            return fitness;
+    }
+}
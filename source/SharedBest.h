@@ -0,0 +1,37 @@
+/**
+ * @file SharedBest.h
+ * @author  Al Timofeyev
+ * @date    May 6, 2019
+ * @brief   A best-so-far board that concurrent searches share without
+ *          taking a lock on the hot path.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_SHAREDBEST_H
+#define BENCHMARKFUNCTIONS2_SHAREDBEST_H
+
+#include <vector>
+#include <atomic>
+#include <limits>
+
+using namespace std;
+
+class SharedBest{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    SharedBest(int dimensions); // Starts empty, with a best fitness of infinity.
+
+    // --------------------- Functions Declarations ---------------------
+    bool offer(const vector<double> &vect, double fitness); /**< Publishes vect if its fitness is the best so far.*/
+    double getFitness();                                    /**< Returns the best fitness published so far.*/
+    double read(vector<double> &vect);                      /**< Copies the best vector into vect and returns its fitness.*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    atomic<double> bestFitness;         /**< The best fitness, lowered with compare-and-swap.*/
+    atomic<unsigned long> sequence;     /**< Seqlock counter, odd while the vector is being written.*/
+    atomic<double> vectorFitness;       /**< The fitness of the vector currently on the board.*/
+    vector<atomic<double>> bestVect;    /**< The best vector, guarded by sequence.*/
+};
+
+
+#endif //BENCHMARKFUNCTIONS2_SHAREDBEST_H
@@ -0,0 +1,297 @@
+/**
+ * @file TermTable.cpp
+ * @class TermTable TermTable.h "TermTable.h"
+ * @author  Al Timofeyev
+ * @date    May 16, 2019
+ * @brief   A lookup table of the term a separable Benchmark Function applies
+ *          to every element, interpolated (linearly or with cubic Hermite
+ *          polynomials) between points spread over the bounds of the
+ *          function, so the sin, cos and sqrt calls of a term become a table
+ *          read and a few multiply-adds.
+ *
+ * Schefel, Rastrigin, Alpine and (apart from its first and last elements)
+ * Levy add up the same function of one element for every element, and the
+ * elements never leave the bounds of the function. The table splits the
+ * bounds into equal intervals and stores the polynomial of each one, so a
+ * term costs one read of 2 or 4 neighbouring doubles. The cubic polynomials
+ * match the term and its slope at both ends of their interval. The table
+ * starts with TERM_TABLE_MIN_INTERVALS intervals and doubles them until the
+ * error measured inside the intervals is below the error asked for. The
+ * intervals around a kink of the term (Schefel's sqrt(|x|) at 0, the zeros
+ * inside Alpine's |x*sin(x) + 0.1*x|) never get there, so they are marked
+ * and left to the exact term, as long as they are no more than
+ * TERM_TABLE_MAX_EXACT_FRACTION of the intervals. A table that can't get
+ * there in TERM_TABLE_MAX_INTERVALS intervals isn't usable, and the exact
+ * terms are used instead.
+ *
+ * The fitness of a tabulated vector is only close to its true fitness, so
+ * the tables are only used to explore (Blind Search), and the best vector
+ * found is scored again with the exact function.
+ */
+
+#include "TermTable.h"
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief Builds the table of a Benchmark Function over its bounds.
+ *
+ * @param functionID The ID of the Benchmark Function (see supports()).
+ * @param minBound, maxBound The bounds of the elements.
+ * @param interpolation TERM_TABLE_LINEAR or TERM_TABLE_CUBIC.
+ * @param maxError The largest error allowed in an interpolated term.
+ */
+TermTable::TermTable(int functionID, double minBound, double maxBound, int interpolation, double maxError)
+{
+    this->functionID = functionID;
+    this->minBound = minBound;
+    scale = 0;
+    intervals = 0;
+    stride = interpolation == TERM_TABLE_LINEAR ? 2 : 4;
+    error = HUGE_VAL;
+    exactIntervals = 0;
+
+    switch(functionID)
+    {
+        case 1:  exactTerm = schefelsTerm; break;
+        case 4:  exactTerm = rastriginTerm; break;
+        case 16: exactTerm = levyTerm; break;
+        case 18: exactTerm = alpineTerm; break;
+        default: exactTerm = nullptr;
+    }
+    if(exactTerm == nullptr || interpolation == TERM_TABLE_OFF || !(maxBound > minBound))
+        return;
+
+    // Double the intervals until the table is accurate enough.
+    for(int numIntervals = TERM_TABLE_MIN_INTERVALS; numIntervals <= TERM_TABLE_MAX_INTERVALS; numIntervals *= 2)
+    {
+        build(maxBound, interpolation, numIntervals);
+        markExactIntervals(maxError);
+        if(exactIntervals <= intervals * TERM_TABLE_MAX_EXACT_FRACTION)
+            return;
+    }
+
+    // Not accurate enough, leave the table empty.
+    intervals = 0;
+    coefficients.clear();
+}
+
+// -------------------------------------------------------------------------------------------
+// --------------------------------- PUBLIC FUNCTIONS BELOW ----------------------------------
+// -------------------------------------------------------------------------------------------
+/**
+ * @brief Checks that the table was built and is as accurate as asked.
+ * @return True if the table can be used, false otherwise.
+ */
+bool TermTable::isUsable()
+{
+    return intervals > 0;
+}
+
+/**
+ * @brief Returns the number of intervals of the table.
+ * @return The number of intervals (0 if the table isn't usable).
+ */
+int TermTable::getIntervals()
+{
+    return intervals;
+}
+
+/**
+ * @brief Returns the largest error measured in the interpolated intervals.
+ * @return The largest difference between an interpolated and an exact term.
+ */
+double TermTable::getError()
+{
+    return error;
+}
+
+/**
+ * @brief Returns the number of intervals left to the exact term.
+ * @return The number of intervals whose interpolation wasn't accurate enough.
+ */
+int TermTable::getExactIntervals()
+{
+    return exactIntervals;
+}
+
+/**
+ * @brief Calculates the fitness of a vector with the interpolated terms, giving up once it can't beat a threshold.
+ *
+ * The terms are summed in the order of the Benchmark Function, and the
+ * functions with bounded versions (Rastrigin, Levy and Alpine) are
+ * abandoned the same way, once every BOUNDED_EVALUATION_BLOCK terms.
+ *
+ * @param vect The vector of elements on which the Benchmark Function operates.
+ * @param threshold The fitness the vector has to reach to be of any use.
+ *
+ * @return The approximate fitness of the vector, or FITNESS_REJECTED if it is certain to be above threshold.
+ */
+double TermTable::calculateFitnessBounded(vector<double> &vect, double threshold) const
+{
+    int size = vect.size();
+
+    // Sums the terms (plus extra) of the first count elements, false if the sum can't reach the threshold.
+    auto boundedSum = [&](int count, double extra, double minTerm, double scale, double offset, double &sum)
+    {
+        double summedUp = 0;
+        for(int blockStart = 0; blockStart < count; blockStart += BOUNDED_EVALUATION_BLOCK)
+        {
+            int blockEnd = min(blockStart + BOUNDED_EVALUATION_BLOCK, count);
+            for(int i = blockStart; i < blockEnd; ++i)
+                summedUp += term(vect[i]) + extra;
+            if(scale * (summedUp + minTerm * (count - blockEnd)) + offset > threshold)
+                return false;
+        }
+        sum = summedUp;
+        return true;
+    };
+
+    double summedUp = 0;
+    switch(functionID)
+    {
+        case 1:
+            for(int i = 0; i < size; ++i)
+                summedUp += term(vect[i]);
+            return (418.9829 * size) - summedUp;
+        case 4:
+            if(!boundedSum(size, 0.0, -10.0, 10 * size, 0.0, summedUp))
+                return FITNESS_REJECTED;
+            return 10 * size * summedUp;
+        case 16:
+        {
+            double firstTerm = levyFirstTerm(vect[0]);
+            if(!boundedSum(size-1, levyLastTerm(vect[size-1]), 0.0, 1.0, firstTerm, summedUp))
+                return FITNESS_REJECTED;
+            return firstTerm + summedUp;
+        }
+        case 18:
+            if(!boundedSum(size, 0.0, 0.0, 1.0, 0.0, summedUp))
+                return FITNESS_REJECTED;
+            return summedUp;
+
+        default:
+            cout << "Term Table Failed for Function ID: " << functionID << endl;
+            return 1.0;
+    }
+}
+
+/**
+ * @brief Checks if the terms of a Benchmark Function can be tabulated.
+ *
+ * Only the functions that apply the same function of one element to every
+ * element (and whose terms call sin, cos or sqrt, so a table is worth it)
+ * are tabulated. Michalewicz's term also depends on the index of the
+ * element, so it would take one table per dimension.
+ *
+ * @param functionID The ID of the Benchmark Function.
+ *
+ * @return True for Schefel (1), Rastrigin (4), Levy (16) and Alpine (18), false otherwise.
+ */
+bool TermTable::supports(int functionID)
+{
+    return functionID == 1 || functionID == 4 || functionID == 16 || functionID == 18;
+}
+
+/**
+ * @brief Returns the interpolation with the given name.
+ * @param name off, linear or cubic.
+ * @return TERM_TABLE_OFF, TERM_TABLE_LINEAR or TERM_TABLE_CUBIC, or -1 if the name is unknown.
+ */
+int TermTable::parseInterpolation(string name)
+{
+    if(name == "off")
+        return TERM_TABLE_OFF;
+    if(name == "linear")
+        return TERM_TABLE_LINEAR;
+    if(name == "cubic")
+        return TERM_TABLE_CUBIC;
+    return -1;
+}
+
+// ----------------------------------------------------------
+// ---------------- PRIVATE FUNCTIONS BELOW -----------------
+// ----------------------------------------------------------
+/**
+ * @brief Fills the coefficients of every interval.
+ *
+ * A linear interval is y0 + f*(y1 - y0). A cubic interval is the Hermite
+ * polynomial through y0 and y1 with the slopes of the term at both ends
+ * (central differences a thousandth of an interval wide), in powers of
+ * the fraction f of the interval.
+ *
+ * @param maxBound The upper bound of the elements.
+ * @param interpolation TERM_TABLE_LINEAR or TERM_TABLE_CUBIC.
+ * @param numIntervals The number of intervals.
+ */
+void TermTable::build(double maxBound, int interpolation, int numIntervals)
+{
+    intervals = numIntervals;
+    double width = (maxBound - minBound) / intervals;
+    scale = intervals / (maxBound - minBound);
+    coefficients.assign((size_t)intervals * stride, 0.0);
+
+    // The term, and its slope per interval, at every point of the table.
+    vector<double> values(intervals + 1), slopes(intervals + 1);
+    double delta = width * 1e-3;
+    for(int p = 0; p <= intervals; p++)
+    {
+        double x = minBound + p * width;
+        values[p] = exactTerm(x);
+        if(interpolation == TERM_TABLE_CUBIC)
+            slopes[p] = (exactTerm(x + delta) - exactTerm(x - delta)) / (2 * delta) * width;
+    }
+
+    for(int i = 0; i < intervals; i++)
+    {
+        double *c = &coefficients[(size_t)i * stride];
+        double y0 = values[i], y1 = values[i+1];
+        c[0] = y0;
+        if(interpolation == TERM_TABLE_LINEAR)
+        {
+            c[1] = y1 - y0;
+            continue;
+        }
+        double m0 = slopes[i], m1 = slopes[i+1];
+        c[1] = m0;
+        c[2] = 3 * (y1 - y0) - 2 * m0 - m1;
+        c[3] = 2 * (y0 - y1) + m0 + m1;
+    }
+}
+
+/**
+ * @brief Leaves the intervals that aren't accurate enough to the exact term.
+ *
+ * Every interval is checked at TERM_TABLE_CHECKS_PER_INTERVAL points
+ * between its ends (where it matches the term exactly). An interval whose
+ * error is above maxError is marked with a NaN first coefficient, which
+ * term() takes as a call for the exact term. The error of the table is the
+ * largest error of the other intervals.
+ *
+ * @param maxError The largest error allowed in an interpolated term.
+ */
+void TermTable::markExactIntervals(double maxError)
+{
+    error = 0;
+    exactIntervals = 0;
+    for(int i = 0; i < intervals; i++)
+    {
+        double largest = 0;
+        for(int check = 1; check <= TERM_TABLE_CHECKS_PER_INTERVAL; check++)
+        {
+            double x = minBound + (i + (double)check / (TERM_TABLE_CHECKS_PER_INTERVAL + 1)) / scale;
+            double difference = abs(term(x) - exactTerm(x));
+            if(!(difference <= largest))
+                largest = difference;
+        }
+
+        if(largest <= maxError)
+            error = max(error, largest);
+        else
+        {
+            coefficients[(size_t)i * stride] = NAN;
+            exactIntervals++;
+        }
+    }
+}
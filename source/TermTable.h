@@ -0,0 +1,101 @@
+/**
+ * @file TermTable.h
+ * @author  Al Timofeyev
+ * @date    May 16, 2019
+ * @brief   A lookup table of the term a separable Benchmark Function applies
+ *          to every element, interpolated (linearly or with cubic Hermite
+ *          polynomials) between points spread over the bounds of the
+ *          function, so the sin, cos and sqrt calls of a term become a table
+ *          read and a few multiply-adds.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_TERMTABLE_H
+#define BENCHMARKFUNCTIONS2_TERMTABLE_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "BenchmarkFunctions.h"
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** The terms are calculated exactly. */
+#define TERM_TABLE_OFF 0
+/** The terms are interpolated linearly between the points of the table. */
+#define TERM_TABLE_LINEAR 1
+/** The terms are interpolated with cubic Hermite polynomials between the points of the table. */
+#define TERM_TABLE_CUBIC 2
+/** The largest error of an interpolated term, unless one is given. */
+#define TERM_TABLE_DEFAULT_ERROR 1e-6
+/** The number of intervals a table starts with, doubled until the table is accurate enough. */
+#define TERM_TABLE_MIN_INTERVALS 256
+/** The most intervals a table can have (1 MB of cubic coefficients, so it stays in the cache). */
+#define TERM_TABLE_MAX_INTERVALS 32768
+/** The number of points checked inside each interval when measuring the error of a table. */
+#define TERM_TABLE_CHECKS_PER_INTERVAL 4
+/** The largest fraction of a table's intervals left to the exact term (the ones around a kink of the term). */
+#define TERM_TABLE_MAX_EXACT_FRACTION 0.01
+
+class TermTable{
+public:
+    // --------------------- Constructor Declarations ---------------------
+    TermTable(int functionID, double minBound, double maxBound, int interpolation, double maxError);
+
+    // --------------------- Functions Declarations ---------------------
+    bool isUsable();                    /**< Checks that the table was built and is as accurate as asked.*/
+    int getIntervals();                 /**< Returns the number of intervals of the table.*/
+    double getError();                  /**< Returns the largest error measured in the interpolated intervals.*/
+    int getExactIntervals();            /**< Returns the number of intervals left to the exact term.*/
+    double term(double x) const;        /**< Returns the interpolated term of x (the exact term outside the bounds).*/
+    double calculateFitnessBounded(vector<double> &vect, double threshold) const;  /**< Calculates the fitness of a vector with the interpolated terms.*/
+
+    static bool supports(int functionID);           /**< Checks if the terms of a Benchmark Function can be tabulated.*/
+    static int parseInterpolation(string name);     /**< Returns the interpolation named off, linear or cubic, or -1.*/
+
+private:
+    // --------------------------- Variables ----------------------------
+    int functionID;
+    double minBound;
+    double scale;                       /**< The number of intervals per unit of x.*/
+    int intervals;
+    int stride;                         /**< The number of coefficients per interval: 2 (linear) or 4 (cubic).*/
+    double error;
+    int exactIntervals;
+    double (*exactTerm)(double);
+    vector<double> coefficients;        /**< The polynomial of each interval, in powers of the fraction of the interval.*/
+
+    // --------------------- Functions Declarations ---------------------
+    void build(double maxBound, int interpolation, int numIntervals);  /**< Fills the coefficients of every interval.*/
+    void markExactIntervals(double maxError);                           /**< Leaves the intervals that aren't accurate enough to the exact term.*/
+};
+
+/**
+ * @brief Returns the interpolated term of x.
+ *
+ * Defined here so the searches can inline it into their sums.
+ *
+ * @param x The element.
+ *
+ * @return The interpolated term, or the exact term if x is outside the bounds of the table or in an exact interval.
+ */
+inline double TermTable::term(double x) const
+{
+    double t = (x - minBound) * scale;
+    if(!(t >= 0 && t <= intervals))
+        return exactTerm(x);
+
+    int i = min((int)t, intervals - 1);
+    double f = t - i;
+    const double *c = &coefficients[i * stride];
+    if(isnan(c[0]))
+        return exactTerm(x);
+    if(stride == 2)
+        return c[0] + f * c[1];
+    return c[0] + f * (c[1] + f * (c[2] + f * c[3]));
+}
+
+
+#endif //BENCHMARKFUNCTIONS2_TERMTABLE_H
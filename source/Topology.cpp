@@ -0,0 +1,461 @@
+/**
+ * @file Topology.cpp
+ * @class Topology Topology.h "Topology.h"
+ * @author  Al Timofeyev
+ * @date    May 19, 2019
+ * @brief   Places the worker threads of the searches on the machine's NUMA
+ *          nodes: reads the node and CPU layout from sysfs, pins each worker
+ *          to a CPU chosen by the placement policy, and hands out work from
+ *          the worker's own node before taking it from other nodes.
+ *
+ * The nodes are the ones listed in TOPOLOGY_NODE_DIRECTORY/online, each
+ * with the CPUs of its cpulist that the process may run on (a cpuset or
+ * taskset can leave a node with none, and then it isn't used). Where sysfs
+ * doesn't describe any nodes, every CPU is on a single node.
+ *
+ * A worker is numbered 0 to numThreads-1 by the search that starts it, and
+ * its CPU is its position in the policy's order of the CPUs, wrapping around
+ * when there are more workers than CPUs. Memory isn't bound explicitly: the
+ * kernel places a page on the node of the thread that first writes it, so
+ * the buffers a pinned worker creates are already on its node.
+ */
+
+#include "Topology.h"
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <cstring>
+#define TOPOLOGY_HAS_AFFINITY
+#endif
+
+/** How the worker threads are placed. */
+static atomic<int> placementPolicy(PLACEMENT_NONE);
+
+// ----------------------------------------------
+// ---------------- CONSTRUCTORS ----------------
+// ----------------------------------------------
+/**
+ * @brief The constructor for the Topology class, reads the nodes and their CPUs.
+ */
+Topology::Topology()
+{
+    // The CPUs the process may run on.
+    vector<int> allowedCpus;
+#ifdef TOPOLOGY_HAS_AFFINITY
+    cpu_set_t mask;
+    if(sched_getaffinity(0, sizeof(mask), &mask) == 0)
+    {
+        for(int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            if(CPU_ISSET(cpu, &mask))
+                allowedCpus.push_back(cpu);
+    }
+#endif
+    if(allowedCpus.empty())
+    {
+        for(int cpu = 0; cpu < max((int)thread::hardware_concurrency(), 1); cpu++)
+            allowedCpus.push_back(cpu);
+    }
+
+    // The nodes, their allowed CPUs and the distances between them.
+    vector<int> onlineNodes = parseCpuList(readLine(string(TOPOLOGY_NODE_DIRECTORY) + "online"));
+    vector<vector<int>> onlineDistances;
+    vector<int> usedNodes;
+    for(int n = 0; n < onlineNodes.size(); n++)
+    {
+        string nodeDirectory = string(TOPOLOGY_NODE_DIRECTORY) + "node" + to_string(onlineNodes[n]) + "/";
+        vector<int> cpus = parseCpuList(readLine(nodeDirectory + "cpulist"));
+        vector<int> allowed;
+        for(int cpu : cpus)
+            if(binary_search(allowedCpus.begin(), allowedCpus.end(), cpu))
+                allowed.push_back(cpu);
+
+        // The distances are listed to every online node, in the order of the online list.
+        istringstream distanceLine(readLine(nodeDirectory + "distance"));
+        vector<int> distances;
+        int distance;
+        while(distanceLine >> distance)
+            distances.push_back(distance);
+        onlineDistances.push_back(distances);
+
+        if(!allowed.empty())
+        {
+            nodeCpus.push_back(allowed);
+            usedNodes.push_back(n);
+        }
+    }
+
+    // Without sysfs, every CPU is on one node.
+    if(nodeCpus.empty())
+    {
+        nodeCpus.push_back(allowedCpus);
+        usedNodes.assign(1, 0);
+        onlineDistances.assign(1, vector<int>());
+    }
+
+    // The distances between the used nodes, local or remote where they aren't known.
+    nodeDistances.assign(nodeCpus.size(), vector<int>(nodeCpus.size()));
+    for(int i = 0; i < nodeCpus.size(); i++)
+    {
+        for(int j = 0; j < nodeCpus.size(); j++)
+        {
+            vector<int> &distances = onlineDistances[usedNodes[i]];
+            if(usedNodes[j] < distances.size())
+                nodeDistances[i][j] = distances[usedNodes[j]];
+            else
+                nodeDistances[i][j] = (i == j) ? 10 : 20;
+        }
+    }
+
+    // The orders the policies pin the workers in, and the node of every CPU.
+    int maxCpu = 0;
+    size_t mostCpus = 0;
+    for(int n = 0; n < nodeCpus.size(); n++)
+    {
+        compactOrder.insert(compactOrder.end(), nodeCpus[n].begin(), nodeCpus[n].end());
+        maxCpu = max(maxCpu, nodeCpus[n].back());
+        mostCpus = max(mostCpus, nodeCpus[n].size());
+    }
+    for(size_t i = 0; i < mostCpus; i++)
+        for(int n = 0; n < nodeCpus.size(); n++)
+            if(i < nodeCpus[n].size())
+                spreadOrder.push_back(nodeCpus[n][i]);
+
+    cpuNodes.assign(maxCpu + 1, 0);
+    for(int n = 0; n < nodeCpus.size(); n++)
+        for(int cpu : nodeCpus[n])
+            cpuNodes[cpu] = n;
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PUBLIC FUNCTIONS BELOW ------------------
+// ----------------------------------------------------------
+/**
+ * @brief Returns the topology of the machine.
+ *
+ * It's read the first time it's asked for, which should be before any thread
+ * is pinned (setThreadPlacement() asks for it), since only the CPUs the
+ * asking thread may run on are used.
+ *
+ * @return The topology.
+ */
+Topology &Topology::system()
+{
+    static Topology topology;
+    return topology;
+}
+
+/**
+ * @brief Returns the number of nodes with a CPU the process may run on.
+ * @return The number of nodes.
+ */
+int Topology::getNumNodes()
+{
+    return nodeCpus.size();
+}
+
+/**
+ * @brief Returns the number of CPUs the process may run on.
+ * @return The number of CPUs.
+ */
+int Topology::getNumCpus()
+{
+    return compactOrder.size();
+}
+
+/**
+ * @brief Returns the CPU a worker is pinned to.
+ *
+ * @param worker The number of the worker, from 0.
+ * @param policy The PLACEMENT_ constant.
+ *
+ * @return The CPU, or -1 if the policy doesn't pin workers.
+ */
+int Topology::workerCpu(int worker, int policy)
+{
+    if(policy == PLACEMENT_COMPACT)
+        return compactOrder[worker % compactOrder.size()];
+    if(policy == PLACEMENT_SPREAD)
+        return spreadOrder[worker % spreadOrder.size()];
+    return -1;
+}
+
+/**
+ * @brief Returns the node a worker runs on.
+ *
+ * @param worker The number of the worker, from 0.
+ * @param policy The PLACEMENT_ constant.
+ *
+ * @return The node (0 to getNumNodes()-1), 0 if the policy doesn't pin workers.
+ */
+int Topology::workerNode(int worker, int policy)
+{
+    int cpu = workerCpu(worker, policy);
+    return (cpu < 0) ? 0 : cpuNodes[cpu];
+}
+
+/**
+ * @brief Returns the other nodes, nearest first.
+ * @param node The node (0 to getNumNodes()-1).
+ * @return The other nodes, ties in order.
+ */
+vector<int> Topology::nodesByDistance(int node)
+{
+    vector<int> others;
+    for(int n = 0; n < nodeCpus.size(); n++)
+        if(n != node)
+            others.push_back(n);
+    stable_sort(others.begin(), others.end(), [this, node](int x, int y) { return nodeDistances[node][x] < nodeDistances[node][y]; });
+    return others;
+}
+
+/**
+ * @brief Returns a line describing the nodes and CPUs.
+ * @return For example "2 nodes, 32 CPUs (16 + 16)".
+ */
+string Topology::describe()
+{
+    ostringstream line;
+    line << nodeCpus.size() << (nodeCpus.size() == 1 ? " node, " : " nodes, ") << compactOrder.size() << " CPUs (";
+    for(int n = 0; n < nodeCpus.size(); n++)
+        line << (n > 0 ? " + " : "") << nodeCpus[n].size();
+    line << ")";
+    return line.str();
+}
+
+/**
+ * @brief Returns the PLACEMENT_ constant of a name.
+ * @param name none, compact or spread.
+ * @return The constant, or -1 if the name isn't a policy.
+ */
+int Topology::parsePolicy(string name)
+{
+    if(name == "none")
+        return PLACEMENT_NONE;
+    if(name == "compact")
+        return PLACEMENT_COMPACT;
+    if(name == "spread")
+        return PLACEMENT_SPREAD;
+    return -1;
+}
+
+/**
+ * @brief Returns the name of a policy.
+ * @param policy The PLACEMENT_ constant.
+ * @return The name parsePolicy() accepts.
+ */
+string Topology::getPolicyName(int policy)
+{
+    switch(policy)
+    {
+        case PLACEMENT_COMPACT:
+            return "compact";
+        case PLACEMENT_SPREAD:
+            return "spread";
+        default:
+            return "none";
+    }
+}
+
+
+// ----------------------------------------------------------
+// ---------------- PRIVATE FUNCTIONS BELOW -----------------
+// ----------------------------------------------------------
+/**
+ * @brief Parses a sysfs list of numbers and ranges.
+ * @param list For example "0-3,8-11".
+ * @return The numbers, in order, empty if the list can't be parsed.
+ */
+vector<int> Topology::parseCpuList(string list)
+{
+    vector<int> numbers;
+    istringstream ranges(list);
+    string range;
+    while(getline(ranges, range, ','))
+    {
+        int first, last;
+        char dash;
+        istringstream bounds(range);
+        if(!(bounds >> first))
+            return vector<int>();
+        last = first;
+        if(bounds >> dash && !(dash == '-' && bounds >> last))
+            return vector<int>();
+        for(int n = first; n <= last; n++)
+            numbers.push_back(n);
+    }
+    sort(numbers.begin(), numbers.end());
+    return numbers;
+}
+
+/**
+ * @brief Returns the first line of a file.
+ * @param filename The file.
+ * @return The line, empty if the file can't be read.
+ */
+string Topology::readLine(string filename)
+{
+    ifstream file(filename);
+    string line;
+    getline(file, line);
+    return line;
+}
+
+
+// ----------------------------------------------
+// -------------- WORKER PLACEMENT --------------
+// ----------------------------------------------
+/**
+ * @brief Pins the calling thread to the CPU of a worker, if the placement policy isn't PLACEMENT_NONE.
+ * @param worker The number of the worker, from 0.
+ */
+WorkerPlacement::WorkerPlacement(int worker)
+{
+    node = 0;
+    isPinned = false;
+    int policy = getThreadPlacement();
+    if(policy == PLACEMENT_NONE)
+        return;
+
+    int cpu = Topology::system().workerCpu(worker, policy);
+    node = Topology::system().workerNode(worker, policy);
+#ifdef TOPOLOGY_HAS_AFFINITY
+    cpu_set_t mask;
+    if(sched_getaffinity(0, sizeof(mask), &mask) != 0)
+        return;
+    savedMask.resize((sizeof(mask) + sizeof(unsigned long) - 1) / sizeof(unsigned long));
+    memcpy(savedMask.data(), &mask, sizeof(mask));
+
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    isPinned = sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#endif
+}
+
+/**
+ * @brief Restores the CPU mask the thread had before it was pinned.
+ */
+WorkerPlacement::~WorkerPlacement()
+{
+#ifdef TOPOLOGY_HAS_AFFINITY
+    if(isPinned)
+    {
+        cpu_set_t mask;
+        memcpy(&mask, savedMask.data(), sizeof(mask));
+        sched_setaffinity(0, sizeof(mask), &mask);
+    }
+#endif
+}
+
+/**
+ * @brief Returns the node of the worker.
+ * @return The node (0 to Topology::getNumNodes()-1), 0 if the worker isn't pinned.
+ */
+int WorkerPlacement::getNode()
+{
+    return node;
+}
+
+
+// ----------------------------------------------
+// --------------- NODE WORK QUEUE --------------
+// ----------------------------------------------
+/**
+ * @brief Splits the items between the nodes the workers run on.
+ * @param items The number of items, handed out as 0 to items-1.
+ * @param numWorkers The number of workers, numbered 0 to numWorkers-1.
+ */
+NodeWorkQueue::NodeWorkQueue(int items, int numWorkers)
+{
+    int policy = getThreadPlacement();
+    Topology &topology = Topology::system();
+
+    // The share of every node that has a worker, and the share of every worker.
+    vector<int> nodeShares(topology.getNumNodes(), -1);
+    vector<int> shareNodes, shareWorkers;
+    workerShares.resize(numWorkers);
+    for(int w = 0; w < numWorkers; w++)
+    {
+        int node = topology.workerNode(w, policy);
+        if(nodeShares[node] < 0)
+        {
+            nodeShares[node] = shareNodes.size();
+            shareNodes.push_back(node);
+            shareWorkers.push_back(0);
+        }
+        workerShares[w] = nodeShares[node];
+        shareWorkers[nodeShares[node]]++;
+    }
+    if(shareNodes.empty())
+    {
+        shareNodes.push_back(0);
+        shareWorkers.push_back(1);
+        numWorkers = 1;
+    }
+
+    // Contiguous ranges of items, in proportion to the workers of each share.
+    shares = vector<NodeShare>(shareNodes.size());
+    long long workersBefore = 0;
+    for(int s = 0; s < shares.size(); s++)
+    {
+        shares[s].next = items * workersBefore / numWorkers;
+        workersBefore += shareWorkers[s];
+        shares[s].end = items * workersBefore / numWorkers;
+    }
+
+    // The shares a worker steals from once its own is empty, nearest node first.
+    stealOrders.resize(shares.size());
+    for(int s = 0; s < shares.size(); s++)
+        for(int node : topology.nodesByDistance(shareNodes[s]))
+            if(nodeShares[node] >= 0)
+                stealOrders[s].push_back(nodeShares[node]);
+}
+
+/**
+ * @brief Returns the next item for a worker.
+ * @param worker The number of the worker, from 0.
+ * @return The item, or -1 once there are none left.
+ */
+int NodeWorkQueue::next(int worker)
+{
+    int share = workerShares[worker];
+    int item = shares[share].next++;
+    if(item < shares[share].end)
+        return item;
+
+    for(int other : stealOrders[share])
+    {
+        item = shares[other].next++;
+        if(item < shares[other].end)
+            return item;
+    }
+    return -1;
+}
+
+
+// ----------------------------------------------------------
+// ----------------- FREE FUNCTIONS BELOW -------------------
+// ----------------------------------------------------------
+/**
+ * @brief Sets how the worker threads of the searches are placed.
+ *
+ * Reads the topology of the machine, if it hasn't been read yet, so it's read
+ * before any thread is pinned.
+ *
+ * @param policy PLACEMENT_NONE, PLACEMENT_COMPACT or PLACEMENT_SPREAD.
+ */
+void setThreadPlacement(int policy)
+{
+    Topology::system();
+    placementPolicy = policy;
+}
+
+/**
+ * @brief Returns how the worker threads of the searches are placed.
+ * @return The PLACEMENT_ constant.
+ */
+int getThreadPlacement()
+{
+    return placementPolicy;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file Topology.h
+ * @author  Al Timofeyev
+ * @date    May 19, 2019
+ * @brief   Places the worker threads of the searches on the machine's NUMA
+ *          nodes: reads the node and CPU layout from sysfs, pins each worker
+ *          to a CPU chosen by the placement policy, and hands out work from
+ *          the worker's own node before taking it from other nodes.
+ */
+
+#ifndef BENCHMARKFUNCTIONS2_TOPOLOGY_H
+#define BENCHMARKFUNCTIONS2_TOPOLOGY_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+// -------------- CONSTANTS --------------
+/** Workers aren't pinned, the operating system places them (the default). */
+#define PLACEMENT_NONE 0
+/** Workers fill the CPUs of one node before the next node is used. */
+#define PLACEMENT_COMPACT 1
+/** Consecutive workers go to different nodes, in turn. */
+#define PLACEMENT_SPREAD 2
+/** Where the kernel describes the NUMA nodes. */
+#define TOPOLOGY_NODE_DIRECTORY "/sys/devices/system/node/"
+
+class Topology{
+public:
+    // --------------------- Functions Declarations ---------------------
+    static Topology &system();              /**< Returns the topology of the machine, read the first time it's asked for.*/
+    int getNumNodes();                      /**< Returns the number of nodes with a CPU the process may run on.*/
+    int getNumCpus();                       /**< Returns the number of CPUs the process may run on.*/
+    int workerCpu(int worker, int policy);  /**< Returns the CPU a worker is pinned to, -1 if it isn't pinned.*/
+    int workerNode(int worker, int policy); /**< Returns the node (0 to getNumNodes()-1) a worker runs on, 0 if it isn't pinned.*/
+    vector<int> nodesByDistance(int node);  /**< Returns the other nodes, nearest first.*/
+    string describe();                      /**< Returns a line describing the nodes and CPUs.*/
+
+    static int parsePolicy(string name);    /**< Returns the PLACEMENT_ constant of a name, -1 if there's none.*/
+    static string getPolicyName(int policy);    /**< Returns the name of a policy.*/
+
+private:
+    // --------------------- Constructor Declarations ---------------------
+    Topology();     // Reads the nodes from sysfs, or makes every CPU one node.
+
+    // --------------------------- Variables ----------------------------
+    vector<vector<int>> nodeCpus;           /**< The CPUs of every node that the process may run on.*/
+    vector<vector<int>> nodeDistances;      /**< The distance from every node to every node (sysfs units, 10 is local).*/
+    vector<int> compactOrder;               /**< The CPUs of node 0, then of node 1...*/
+    vector<int> spreadOrder;                /**< The first CPU of every node, then the second...*/
+    vector<int> cpuNodes;                   /**< The node of every CPU in the orders above, by CPU number.*/
+
+    // --------------------- Functions Declarations ---------------------
+    static vector<int> parseCpuList(string list);   /**< Parses a sysfs list like "0-3,8-11".*/
+    static string readLine(string filename);        /**< Returns the first line of a file, empty if it can't be read.*/
+};
+
+/**
+ * @brief Pins the calling thread to the CPU of a worker for as long as it lives.
+ *
+ * Buffers the worker allocates and first writes while it's pinned are placed
+ * on its node by the kernel's first-touch policy, so a worker should create
+ * its placement before its buffers. The thread's previous CPU mask is
+ * restored when the placement is destroyed, so the calling thread can be
+ * one of the workers.
+ */
+class WorkerPlacement{
+public:
+    WorkerPlacement(int worker);    // Pins the thread, if the placement policy isn't PLACEMENT_NONE.
+    ~WorkerPlacement();             // Restores the thread's previous CPU mask.
+
+    int getNode();                  /**< Returns the node of the worker, 0 if it isn't pinned.*/
+
+private:
+    int node;
+    bool isPinned;
+    vector<unsigned long> savedMask;    /**< The CPU mask of the thread before it was pinned.*/
+};
+
+/**
+ * @brief Hands out the items 0 to items-1 to a fixed number of workers.
+ *
+ * The items are split into one contiguous share per node the workers run on,
+ * in proportion to the node's workers. A worker takes items from its own
+ * node's share, and once that's empty from the other shares, nearest node
+ * first. With the placement policy PLACEMENT_NONE there is a single share,
+ * and the items are handed out in order, one at a time, to whichever worker
+ * asks next.
+ */
+class NodeWorkQueue{
+public:
+    NodeWorkQueue(int items, int numWorkers);   // Splits the items between the nodes of the workers.
+
+    int next(int worker);   /**< Returns the next item for a worker, -1 once there are none left.*/
+
+private:
+    /** The items of one node, on their own cache line so the nodes don't share one. */
+    struct alignas(64) NodeShare
+    {
+        atomic<int> next;
+        int end;
+    };
+
+    vector<NodeShare> shares;
+    vector<int> workerShares;           /**< The share of every worker.*/
+    vector<vector<int>> stealOrders;    /**< The other shares of every share, nearest node first.*/
+};
+
+/** Sets how the worker threads of the searches are placed (one of the PLACEMENT_ constants). */
+void setThreadPlacement(int policy);
+/** Returns how the worker threads of the searches are placed. */
+int getThreadPlacement();
+
+
+#endif //BENCHMARKFUNCTIONS2_TOPOLOGY_H
@@ -1,12 +1,61 @@
 #include <iostream>
 #include <fstream>
 #include "ProcessFunctions.h"
+#include "JobServer.h"
+#include "ShardedSweep.h"
+#include "ParameterSweep.h"
 
 
 using namespace std;
 
 int main(int argc, char** argv)
 {
+    // Server mode: run search jobs from stdin, or from a Unix domain socket if a path is given.
+    if (argc > 1 && string(argv[1]) == "--serve")
+    {
+        JobServer server(thread::hardware_concurrency());
+        if (argc > 2)
+            return server.serveSocket(argv[2]) ? 0 : 1;
+        server.serveStream();
+        return 0;
+    }
+
+    // Sharded mode: split the sweep of a configuration file into shards run by worker processes.
+    if (argc > 3 && string(argv[1]) == "--coordinate")
+    {
+        ShardedSweep sweep(argv[3]);
+        int workers = thread::hardware_concurrency();
+        if (argc > 4 && !parseNumber(argv[4], workers))
+        {
+            cout << "The number of workers must be a number: " << argv[4] << endl;
+            return 1;
+        }
+        return sweep.coordinate(argv[2], workers) ? 0 : 1;
+    }
+    if (argc > 2 && string(argv[1]) == "--worker")
+    {
+        ShardedSweep sweep(argv[2]);
+        return sweep.work(thread::hardware_concurrency()) >= 0 ? 0 : 1;
+    }
+    if (argc > 2 && string(argv[1]) == "--merge")
+    {
+        ShardedSweep sweep(argv[2]);
+        return sweep.merge() ? 0 : 1;
+    }
+
+    // Sweep mode: expand a sweep file (or a classic configuration file) into jobs and run them all.
+    if (argc > 2 && string(argv[1]) == "--sweep")
+    {
+        string searchConfigFilename = "SearchAlgorithmConfig.txt";
+        if (argc > 4 && string(argv[3]) == "--search-config")
+            searchConfigFilename = argv[4];
+
+        ParameterSweep sweep;
+        if (!sweep.load(argv[2], searchConfigFilename))
+            return 1;
+        return sweep.run() ? 0 : 1;
+    }
+
     // Default configuration filename.
     string configFilename = "config.txt";
 
@@ -14,6 +63,146 @@ int main(int argc, char** argv)
     if (argc > 1)
         configFilename = argv[1];
 
+    // Create a ProcessFunctions object.
+    ProcessFunctions procFuncs;
+
+    // Write the output files in the background.
+    AsyncWriter outputWriter(true);
+    procFuncs.setOutputWriter(&outputWriter);
+
+    // Results of earlier runs, if a cache is given.
+    ResultCache resultCache;
+
+    // Optional flags after the filename:
+    //      --seed <n>          repeatable run, every random stream is derived from n.
+    //      --checkpoint <file> save a checkpoint to file as the run goes.
+    //      --resume <file>     resume the run saved in the checkpoint, and keep saving to it.
+    //      --search-config <file>  read the search algorithm settings from file instead of SearchAlgorithmConfig.txt.
+    //      --sampler <name>    random (default), sobol, halton or lhs points for the matrices, BS and ILS restarts.
+    //      --local-search <name>   fixed (default) or adaptive: the descent of LS and of every ILS restart.
+    //      --cache <file>      reuse the matrix fitness and seeded search results of earlier runs saved in file, and add to it.
+    //      --term-table <name> off (default), linear or cubic: BS interpolates the terms of Schefel, Rastrigin, Levy and Alpine.
+    //      --term-table-error <e>  the largest error of an interpolated term (1e-6 by default).
+    //      --memo <n>          remember the fitness of up to n vectors per function, so the searches don't evaluate them twice.
+    //      --memo-quantum <q>  vectors in the same cell of size q share a memoized fitness (0, exact vectors only, by default).
+    //      --placement <name>  none (default), compact or spread: pins the search workers to CPUs of the NUMA nodes.
+    int termTableInterpolation = TERM_TABLE_OFF;
+    double termTableError = TERM_TABLE_DEFAULT_ERROR;
+    unsigned int memoCapacity = 0;
+    double memoQuantum = 0;
+    if (argc > 2 && (argc - 2) % 2 != 0)
+    {
+        cout << "The flag " << argv[argc - 1] << " must be followed by a value" << endl;
+        return 1;
+    }
+    for (int arg = 2; arg + 1 < argc; arg += 2)
+    {
+        string flag = argv[arg];
+        if (flag == "--seed")
+        {
+            unsigned int seed;
+            if (!parseNumber(argv[arg + 1], seed))
+            {
+                cout << "The seed must be a number: " << argv[arg + 1] << endl;
+                return 1;
+            }
+            procFuncs.setRunSeed(seed);
+        }
+        else if (flag == "--checkpoint")
+            procFuncs.setCheckpointFile(argv[arg + 1]);
+        else if (flag == "--resume")
+        {
+            if (!procFuncs.resumeFromCheckpoint(argv[arg + 1]))
+            {
+                cout << "Failed to resume from checkpoint: " << argv[arg + 1] << endl;
+                return 1;
+            }
+            procFuncs.setCheckpointFile(argv[arg + 1]);
+        }
+        else if (flag == "--search-config")
+            procFuncs.setSearchConfigFile(argv[arg + 1]);
+        else if (flag == "--sampler")
+        {
+            int samplerType = Sampler::parseType(argv[arg + 1]);
+            if (samplerType < 0)
+            {
+                cout << "The sampler must be random, sobol, halton or lhs: " << argv[arg + 1] << endl;
+                return 1;
+            }
+            procFuncs.setSamplerType(samplerType);
+        }
+        else if (flag == "--local-search")
+        {
+            int localSearchMode = parseLocalSearchMode(argv[arg + 1]);
+            if (localSearchMode < 0)
+            {
+                cout << "The local search must be fixed or adaptive: " << argv[arg + 1] << endl;
+                return 1;
+            }
+            procFuncs.setLocalSearchMode(localSearchMode);
+        }
+        else if (flag == "--cache")
+        {
+            if (!resultCache.open(argv[arg + 1]))
+                return 1;
+            procFuncs.setResultCache(&resultCache);
+        }
+        else if (flag == "--term-table")
+        {
+            termTableInterpolation = TermTable::parseInterpolation(argv[arg + 1]);
+            if (termTableInterpolation < 0)
+            {
+                cout << "The term table must be off, linear or cubic: " << argv[arg + 1] << endl;
+                return 1;
+            }
+        }
+        else if (flag == "--term-table-error")
+        {
+            if (!parseNumber(argv[arg + 1], termTableError) || !(termTableError > 0))
+            {
+                cout << "The term table error must be a positive number: " << argv[arg + 1] << endl;
+                return 1;
+            }
+        }
+        else if (flag == "--placement")
+        {
+            int placementPolicy = Topology::parsePolicy(argv[arg + 1]);
+            if (placementPolicy < 0)
+            {
+                cout << "The placement must be none, compact or spread: " << argv[arg + 1] << endl;
+                return 1;
+            }
+            setThreadPlacement(placementPolicy);
+            if (placementPolicy != PLACEMENT_NONE)
+                cout << "Thread placement: " << Topology::getPolicyName(placementPolicy) << " over " << Topology::system().describe() << endl;
+        }
+        else if (flag == "--memo")
+        {
+            if (!parseNumber(argv[arg + 1], memoCapacity))
+            {
+                cout << "The memo size must be a number: " << argv[arg + 1] << endl;
+                return 1;
+            }
+        }
+        else if (flag == "--memo-quantum")
+        {
+            if (!parseNumber(argv[arg + 1], memoQuantum) || !(memoQuantum >= 0))
+            {
+                cout << "The memo quantum must be 0 or a positive number: " << argv[arg + 1] << endl;
+                return 1;
+            }
+        }
+        else
+        {
+            cout << "The flag must be one of --seed, --checkpoint, --resume, --search-config, --sampler, --local-search, --cache, "
+                 << "--term-table, --term-table-error, --memo, --memo-quantum or --placement: " << flag << endl;
+            return 1;
+        }
+    }
+
+    procFuncs.setTermTable(termTableInterpolation, termTableError);
+    procFuncs.setFitnessMemo(memoCapacity, memoQuantum);
+
     // Open the text file.
     ifstream configFile;
     configFile.open(configFilename);
@@ -32,16 +221,36 @@ int main(int argc, char** argv)
     }
 
     // Set the number of dimensions to test, from file.
-    string line, dummyLine;
+    string line, error;
+    vector<int> dimensions;
     getline(configFile, line);
-    vector<int> dimensions = parseStringInt(line, ",");
+    if (!parseNumbers(line, ",", dimensions, error))
+    {
+        cout << lineError(configFilename, 1, error) << endl;
+        cout << "**** Terminating Program Execution ****\n\n";
+        return 1;
+    }
 
-    // Reset the file pointer to the beginning of file.
-    configFile.clear();
-    configFile.seekg(0, ios::beg);
+    // Read the functions to run (one per line), skipping blank lines.
+    vector<vector<double>> functionSetups;
+    vector<double> vals;
+    for (int lineNumber = 2; getline(configFile, line); lineNumber++)
+    {
+        // Get the function parameters from file and prep them for matrix.
+        if (!parseNumbers(line, ",", vals, error))
+        {
+            cout << lineError(configFilename, lineNumber, error) << endl;
+            cout << "**** Terminating Program Execution ****\n\n";
+            return 1;
+        }
+        if (vals.size() == 0)
+            continue;
+        prepForFunctionMatrix(vals);
+        functionSetups.push_back(vals);
+    }
 
-    // Create a ProcessFunctions object.
-    ProcessFunctions procFuncs;
+    // CLose the text file.
+    configFile.close();
 
     // Print all Function IDs to user.
     //procFuncs.printAllFunctionIDs();
@@ -49,47 +258,35 @@ int main(int argc, char** argv)
     // For every dimension that was listed in the configuration file.
     for(int i = 0; i < dimensions.size(); i++)
     {
-        // Consume the first line (skip it).
-        getline(configFile, dummyLine);
+        // Skip the dimensions finished before the run was resumed.
+        if (procFuncs.isDimensionCompleted(dimensions[i]))
+            continue;
 
         // Set the number of dimensions.
         procFuncs.setNumOfDimensions(dimensions[i]);
 
-        // Create matrices with the current number of dimensions.
-        while(configFile.good())
-        {
-            // Get the function parameters from file and prep them for matrix.
-            getline(configFile, line);
-            vector<double> vals = parseStringDbl(line, ",");
-            prepForFunctionMatrix(vals);
+        // Create the matrices, calculate their fitness, analyze them and run all the
+        // search algorithms on them, one function after the other through a pipeline.
+        procFuncs.processAllFunctionsPipelined(functionSetups, configFilename, false);
 
-            // Construct the matrix.
-            procFuncs.constructMatrix(vals[0], vals[1], vals[2]);
-        }
-
-        // Calculate the fitness for all matrices and save them to file.
-        procFuncs.calculateFitnessOfAllMatrices();
-        //procFuncs.saveAllProcessedFunctionDataToFile(configFilename);
-
-        // Analyze all function results and save them to file.
-        procFuncs.analyzeAllFunctionResults();
+        // Save the analysis of all function results to file.
         procFuncs.saveAllAnalyzedDataToFile(configFilename);
 
-        // Run all the search algorithms and save them to file.
-        procFuncs.performAllSearchAlgorithms();
+        // Analyze the search algorithm results and save them to file.
         procFuncs.analyzeAllSearchAlgorithmResults();
         procFuncs.saveAllAnalyzedSearchAlgDataToFile(configFilename);
+        procFuncs.completeDimension();
 
         // Print the results of the analysis.
         procFuncs.printFunctionResultsAnalysis();
-
-        // Reset the file pointer to the beginning of file.
-        configFile.clear();
-        configFile.seekg(0, ios::beg);
     }
 
-    // CLose the text file.
-    configFile.close();
+    if (resultCache.isOpen())
+        cout << "Result cache: " << resultCache.getHits() << " hits, " << resultCache.getMisses() << " misses" << endl;
+
+    // Make sure every output file is on disk.
+    if (!outputWriter.finish())
+        return 1;
 
     return 0;
 }
\ No newline at end of file
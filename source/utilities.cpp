@@ -16,7 +16,7 @@
  * Constructs and returns a vector of doubles, given a string list of
  * numbers and a delimiter.
  *
- * @note The input string str MUST be a list of doubles!
+ * @note The input string str MUST be a list of doubles, otherwise invalid_argument is thrown!
  *
  * @param str  A string list of numbers.
  * @param delimiter A string of character(s) used to separate the numbers in the string list.
@@ -25,30 +25,13 @@
  */
 vector<double> parseStringDbl(string str, string delimiter)
 {
-    // Copy the string str over to a char[] array.
-    char list[str.size()+1];
-    strcpy(list, str.c_str());
-
-    // Copy the delimiter into a char[] array.
-    char delims[delimiter.size()+1];
-    strcpy(delims, delimiter.c_str());
-
     // Set up a vector where to store the numbers.
     vector<double> numList;
 
-    // Set up a tokenizing variable.
-    char * token;
-    token = strtok (list,delims);
-
-    // While there are still tokens
-    while(token != 0)
-    {
-        if(strcmp(token, "pi") == 0)
-            numList.push_back(M_PI);
-        else
-            numList.push_back(stod(token));
-        token = strtok(NULL, delims);
-    }
+    // Parse the numbers (pi is accepted), and reject anything that isn't one.
+    string error;
+    if(!parseNumbers(str, delimiter, numList, error))
+        throw invalid_argument(error);
 
     // Return the vector of doubles.
     return numList;
@@ -60,7 +43,7 @@ vector<double> parseStringDbl(string str, string delimiter)
  * Constructs and returns a vector of integers, given a string list of
  * numbers and a delimiter.
  *
- * @note The input string list MUST be a list of integers!
+ * @note The input string list MUST be a list of integers, otherwise invalid_argument is thrown!
  *
  * @param str  A string list of numbers.
  * @param delimiter A string of character(s) used to separate the numbers in the string list.
@@ -69,30 +52,13 @@ vector<double> parseStringDbl(string str, string delimiter)
  */
 vector<int> parseStringInt(string str, string delimiter)
 {
-    // Copy the string str over to a char[] array.
-    char list[str.size()+1];
-    strcpy(list, str.c_str());
-
-    // Copy the delimiter into a char[] array.
-    char delims[delimiter.size()+1];
-    strcpy(delims, delimiter.c_str());
-
     // Set up a vector where to store the numbers.
     vector<int> numList;
 
-    // Set up a tokenizing variable.
-    char * token;
-    token = strtok (list,delims);
-
-    // While there are still tokens
-    while(token != 0)
-    {
-        if(strcmp(token, "pi") == 0)
-            numList.push_back((int)M_PI);
-        else
-            numList.push_back(stoi(token));
-        token = strtok(NULL, delims);
-    }
+    // Parse the numbers (pi is accepted), and reject anything that isn't one.
+    string error;
+    if(!parseNumbers(str, delimiter, numList, error))
+        throw invalid_argument(error);
 
     // Return the vector of integers.
     return numList;
@@ -111,30 +77,181 @@ vector<int> parseStringInt(string str, string delimiter)
  */
 vector<string> parseStringStr(string str, string delimiter)
 {
-    // Copy the string str over to a char[] array.
-    char list[str.size()+1];
-    strcpy(list, str.c_str());
-
-    // Copy the delimiter into a char[] array.
-    char delims[delimiter.size()+1];
-    strcpy(delims, delimiter.c_str());
-
     // Set up a vector where to store the string elements.
     vector<string> strList;
 
-    // Set up a tokenizing variable.
-    char * token;
-    token = strtok (list,delims);
+    // Copy out every token.
+    string_view text = str, token;
+    while(nextToken(text, delimiter, token))
+        strList.push_back(string(token));
 
-    // While there are still tokens
-    while(token != 0)
+    // Return the vector of strings.
+    return strList;
+}
+
+/**
+ * @brief Splits the next token off a string.
+ *
+ * Skips any delimiters at the start of text, then cuts the token off up to
+ * the next delimiter (or the end) and moves text past it. The token is a view
+ * into the same characters, trimmed of spaces, tabs and carriage returns, so
+ * nothing is copied or allocated and any number of threads can tokenize at
+ * the same time.
+ *
+ * @param text The rest of the string, moved past the token.
+ * @param delimiters The character(s) that separate the tokens.
+ * @param token Set to the token.
+ *
+ * @return False if there are no tokens left.
+ */
+bool nextToken(string_view &text, string_view delimiters, string_view &token)
+{
+    // Skip the delimiters before the token.
+    size_t start = text.find_first_not_of(delimiters);
+    if(start == string_view::npos)
     {
-        strList.push_back(token);
-        token = strtok(NULL, delims);
+        text = string_view();
+        return false;
     }
 
-    // Return the vector of strings.
-    return strList;
+    // Cut the token off (a single delimiter is found with a plain, much faster, search).
+    size_t end = delimiters.size() == 1 ? text.find(delimiters[0], start) : text.find_first_of(delimiters, start);
+    if(end == string_view::npos)
+        end = text.size();
+    token = text.substr(start, end - start);
+    text.remove_prefix(end);
+
+    // Trim the white space around it.
+    size_t first = token.find_first_not_of(" \t\r");
+    if(first == string_view::npos)
+        return nextToken(text, delimiters, token);
+    token = token.substr(first, token.find_last_not_of(" \t\r") - first + 1);
+    return true;
+}
+
+/**
+ * @brief Parses a token into a double without allocating.
+ *
+ * Accepts everything from_chars() does (like 12, -0.5, 1e-3, inf), a
+ * leading '+', and the tokens pi and -pi.
+ *
+ * @param token The token, without any surrounding white space.
+ * @param value Set to the number.
+ *
+ * @return False if the whole token isn't a number.
+ */
+bool parseNumber(string_view token, double &value)
+{
+    if(token == "pi" || token == "-pi")
+    {
+        value = token[0] == '-' ? -M_PI : M_PI;
+        return true;
+    }
+    if(token.size() > 1 && token[0] == '+' && token[1] != '-')
+        token.remove_prefix(1);
+
+    from_chars_result result = from_chars(token.data(), token.data() + token.size(), value);
+    return token.size() > 0 && result.ec == errc() && result.ptr == token.data() + token.size();
+}
+
+/**
+ * @brief Parses a token into an int without allocating.
+ *
+ * Accepts a decimal integer with an optional sign, and the token pi (as 3).
+ *
+ * @param token The token, without any surrounding white space.
+ * @param value Set to the number.
+ *
+ * @return False if the whole token isn't an integer that fits in an int.
+ */
+bool parseNumber(string_view token, int &value)
+{
+    if(token == "pi")
+    {
+        value = (int)M_PI;
+        return true;
+    }
+    if(token.size() > 1 && token[0] == '+' && token[1] != '-')
+        token.remove_prefix(1);
+
+    from_chars_result result = from_chars(token.data(), token.data() + token.size(), value);
+    return token.size() > 0 && result.ec == errc() && result.ptr == token.data() + token.size();
+}
+
+/**
+ * @brief Parses a token into an unsigned int without allocating.
+ * @param token The token, without any surrounding white space.
+ * @param value Set to the number.
+ * @return False if the whole token isn't an integer that fits in an unsigned int.
+ */
+bool parseNumber(string_view token, unsigned int &value)
+{
+    if(token.size() > 1 && token[0] == '+')
+        token.remove_prefix(1);
+
+    from_chars_result result = from_chars(token.data(), token.data() + token.size(), value);
+    return token.size() > 0 && result.ec == errc() && result.ptr == token.data() + token.size();
+}
+
+/**
+ * @brief Parses every number on a line into a vector.
+ *
+ * The vector is cleared and refilled, so a vector reused from line to line
+ * stops allocating once it's big enough for the longest line.
+ *
+ * @param line The line of numbers.
+ * @param delimiters The character(s) that separate the numbers.
+ * @param values Set to the numbers.
+ * @param error Set to what's wrong if a token isn't a number.
+ *
+ * @return False at the first token that isn't a number.
+ */
+template <typename T>
+static bool parseNumberList(string_view line, string_view delimiters, vector<T> &values, string &error)
+{
+    values.clear();
+    string_view token;
+    while(nextToken(line, delimiters, token))
+    {
+        T value;
+        if(!parseNumber(token, value))
+        {
+            error = "expected a number but found '" + string(token) + "'";
+            return false;
+        }
+        values.push_back(value);
+    }
+    return true;
+}
+
+/**
+ * @brief Parses every number on a line into a vector of doubles.
+ * @note See parseNumberList().
+ */
+bool parseNumbers(string_view line, string_view delimiters, vector<double> &values, string &error)
+{
+    return parseNumberList(line, delimiters, values, error);
+}
+
+/**
+ * @brief Parses every number on a line into a vector of integers.
+ * @note See parseNumberList().
+ */
+bool parseNumbers(string_view line, string_view delimiters, vector<int> &values, string &error)
+{
+    return parseNumberList(line, delimiters, values, error);
+}
+
+/**
+ * @brief Formats a parse error with where it happened.
+ * @param filename The file that was read.
+ * @param lineNumber The number of the line, starting at 1.
+ * @param error What's wrong with the line.
+ * @return filename:lineNumber: error
+ */
+string lineError(string filename, int lineNumber, string error)
+{
+    return filename + ":" + to_string(lineNumber) + ": " + error;
 }
 
 
@@ -154,6 +271,35 @@ void prepForFunctionMatrix(vector<double> &setup)
 }
 
 
+// The generator every search on this thread draws its seeds from.
+static thread_local mt19937 seedGenerator(random_device{}());
+
+/**
+ * @brief Seeds the random number generators created on this thread from now on.
+ *
+ * Every random number generator in the searches (and createMatrix()) is seeded
+ * with nextRandomSeed(), so after this call a search run on this thread is
+ * reproducible.
+ *
+ * @param seed The seed of the sequence of seeds.
+ */
+void setRandomSeed(unsigned int seed)
+{
+    seedGenerator.seed(seed);
+}
+
+/**
+ * @brief Returns a new seed for a random number generator.
+ *
+ * @note Unless setRandomSeed() was called, each thread starts from a random seed.
+ *
+ * @return The next seed in this thread's sequence of seeds.
+ */
+unsigned int nextRandomSeed()
+{
+    return seedGenerator();
+}
+
 /**
  * @brief Creates a matrix of doubles using Mersenne Twister.
  *
@@ -170,7 +316,7 @@ void prepForFunctionMatrix(vector<double> &setup)
 vector<vector<double>> createMatrix(int rows, int columns, double minBound, double maxBound)
 {
     // Create a Mersenne Twister pseudo-random number generator.
-    mt19937 randGenerator(time(NULL));
+    mt19937 randGenerator(nextRandomSeed());
     uniform_real_distribution<double> dis(0.0, 1.0);
 
     // Declare the matrix
@@ -205,13 +351,209 @@ vector<vector<double>> createMatrix(int rows, int columns, double minBound, doub
     return matrix;
 }
 
+/**
+ * @brief Draws the next element of a random vector, exactly as createMatrix() does.
+ *
+ * @param randGenerator The Mersenne Twister the vector is drawn from.
+ * @param dis The distribution of the random numbers (0 to 1).
+ * @param minBound, maxBound The max/min boundaries of the elements.
+ *
+ * @return The element.
+ */
+static inline double drawElement(mt19937 &randGenerator, uniform_real_distribution<double> &dis, double minBound, double maxBound)
+{
+    return (maxBound-minBound) / (1 - 0) * (dis(randGenerator)-0) + minBound;
+}
+
+/**
+ * @brief Sums term(i) for i in [0, count), each term drawing its own element, giving up once the fitness can't reach threshold.
+ *
+ * The same check as the bounded Benchmark Functions, made once per
+ * BOUNDED_EVALUATION_BLOCK terms. The elements of an abandoned sum are still
+ * drawn (and dropped), so the generator ends up where a full sum leaves it.
+ *
+ * @param term The i-th term, drawing the next element of the vector.
+ * @param count The number of terms.
+ * @param minTerm The smallest value a term can have.
+ * @param scale, offset The fitness is scale * sum + offset.
+ * @param threshold The fitness above which the sum is abandoned.
+ * @param skip Drops the given number of elements.
+ * @param sum Set to the sum of the terms summed.
+ *
+ * @return False if the sum was abandoned, true otherwise.
+ */
+template <typename Term, typename Skip>
+static bool sampledSum(Term term, int count, double minTerm, double scale, double offset, double threshold, Skip skip, double &sum)
+{
+    double summedUp = 0;
+    for(int blockStart = 0; blockStart < count; blockStart += BOUNDED_EVALUATION_BLOCK)
+    {
+        int blockEnd = min(blockStart + BOUNDED_EVALUATION_BLOCK, count);
+        for(int i = blockStart; i < blockEnd; ++i)
+            summedUp += term(i);
+        if(scale * (summedUp + minTerm * (count - blockEnd)) + offset > threshold)
+        {
+            skip(count - blockEnd);
+            sum = summedUp;
+            return false;
+        }
+    }
+
+    sum = summedUp;
+    return true;
+}
+
+/**
+ * @brief Draws a random vector and calculates its fitness, without ever storing the vector.
+ *
+ * Each element is drawn, scaled to the bounds and added straight into the
+ * sum of the Benchmark Function, so a vector of any size costs no memory
+ * at all. The elements are the ones createMatrix() would draw from the same
+ * generator, and (apart from Levy, whose terms all need the last element)
+ * they are summed in the same order, so the fitness is exactly the one
+ * calculateFitnessOfVector() gives the stored vector. The functions that
+ * have bounded versions are abandoned the same way, once the fitness is
+ * certain to end up above the threshold.
+ *
+ * With a TermTable, the terms it covers are interpolated from the table
+ * instead, so the fitness is only close to the exact one.
+ *
+ * @note The generator always moves past exactly columns elements, rejected or not.
+ * @note This function makes a call to BenchmarkFunctions.h.
+ * @note This function makes a call to TermTable.h --> term().
+ *
+ * @param randGenerator The Mersenne Twister the vector is drawn from.
+ * @param columns The number of elements in the vector.
+ * @param minBound, maxBound The max/min boundaries of the elements.
+ * @param functionID The ID that references which Benchmark Function to use.
+ * @param threshold The fitness the vector has to reach to be of any use.
+ * @param table The table of the function's terms, or nullptr to calculate them exactly.
+ *
+ * @return The fitness of the vector, or FITNESS_REJECTED if it is certain to be above threshold.
+ */
+double sampleFitnessOfVector(mt19937 &randGenerator, int columns, double minBound, double maxBound, int functionID, double threshold, const TermTable *table)
+{
+    uniform_real_distribution<double> dis(0.0, 1.0);
+    auto draw = [&]() { return drawElement(randGenerator, dis, minBound, maxBound); };
+    auto skip = [&](int count) { for(int i = 0; i < count; i++) dis(randGenerator); };
+
+    // The term of each element, and of each pair of neighbouring elements (the first element is drawn up front).
+    double previous = 0, summedUp = 0;
+    auto single = [&](double (*term)(double)) { return [&draw, term](int i) { return term(draw()); }; };
+    auto tabulated = [&](double (*term)(double)) {
+        return [&draw, term, table](int i) { return table != nullptr ? table->term(draw()) : term(draw()); }; };
+    auto indexed = [&](double (*term)(double, int)) { return [&draw, term](int i) { return term(draw(), i); }; };
+    auto pair = [&](double (*term)(double, double))
+    {
+        previous = draw();
+        return [&draw, &previous, term](int i) { double x = draw(); double t = term(previous, x); previous = x; return t; };
+    };
+    auto sum = [&](auto term, int count) { sampledSum(term, count, 0.0, 1.0, 0.0, HUGE_VAL, skip, summedUp); return summedUp; };
+    auto bounded = [&](auto term, int count, double minTerm, double scale) {
+        return sampledSum(term, count, minTerm, scale, 0.0, threshold, skip, summedUp) ? scale * summedUp : FITNESS_REJECTED; };
+
+    switch(functionID)
+    {
+        case 1:
+            return (418.9829 * columns) - sum(tabulated(schefelsTerm), columns);
+        case 2:
+            return bounded(single(deJongsTerm), columns, 0.0, 1.0);
+        case 3:
+            return bounded(pair(rosenbrockTerm), columns-1, 0.0, 1.0);
+        case 4:
+            return bounded(tabulated(rastriginTerm), columns, -10.0, 10 * columns);
+        case 5:
+        {
+            // The sum and the product are each accumulated in the order griewangkFunc() uses.
+            double productUp = 1;
+            sum([&draw, &productUp](int i) { double x = draw(); productUp *= cos(x / sqrt(i+1)); return pow(x, 2) / 4000; }, columns);
+            return 1 + summedUp - productUp;
+        }
+        case 6:
+            return -sum(pair(sineEnvelopeSineWaveTerm), columns-1);
+        case 7:
+            return sum(pair(stretchedVSineWaveTerm), columns-1);
+        case 8:
+            return sum(pair(ackleysOneTerm), columns-1);
+        case 9:
+            return sum(pair(ackleysTwoTerm), columns-1);
+        case 10:
+            return sum(pair(eggHolderTerm), columns-1);
+        case 11:
+            return sum(pair(ranaTerm), columns-1);
+        case 12:
+            return sum(pair(pathologicalTerm), columns-1);
+        case 13:
+            return -sum(indexed(michalewiczTerm), columns);
+        case 14:
+            return -sum(pair(mastersCosWaveTerm), columns-1);
+        case 15:
+            return bounded(indexed(quarticTerm), columns, 0.0, 1.0);
+        case 16:
+        {
+            // Every term needs the last element, so sum the terms of the others first and add the last ones at the end
+            // (no term is below 0, so the sum can still be abandoned before the last element is drawn).
+            double first = draw();
+            if(columns < 2)
+                return levyFirstTerm(first);
+            double firstTerms = levyFirstTerm(first) + levyTerm(first);
+            if(!sampledSum(tabulated(levyTerm), columns-2, 0.0, 1.0, firstTerms, threshold, skip, summedUp))
+            {
+                skip(1);
+                return FITNESS_REJECTED;
+            }
+            double last = draw();
+            return levyFirstTerm(first) + (levyTerm(first) + summedUp + (columns-1) * levyLastTerm(last));
+        }
+        case 17:
+            return bounded(single(stepTerm), columns, 0.0, 1.0);
+        case 18:
+            return bounded(tabulated(alpineTerm), columns, 0.0, 1.0);
+
+        default:
+            skip(columns);
+            cout << "Fitness Process Failed for Function ID: " << functionID << endl;
+            cout << "Possible Function IDs: 1 - 18\n\n";
+            return 1.0;
+    }
+}
+
+/**
+ * @brief Regenerates a vector drawn by sampleFitnessOfVector() (or a row of createMatrix()).
+ *
+ * @param seed The seed of the Mersenne Twister the vector was drawn from.
+ * @param index The number of vectors drawn from it before this one.
+ * @param columns The number of elements in the vector.
+ * @param minBound, maxBound The max/min boundaries of the elements.
+ *
+ * @return The vector.
+ */
+vector<double> regenerateVector(unsigned int seed, int index, int columns, double minBound, double maxBound)
+{
+    mt19937 randGenerator(seed);
+    uniform_real_distribution<double> dis(0.0, 1.0);
+
+    // Move past the vectors drawn before it.
+    for(long long i = 0; i < (long long)index * columns; i++)
+        dis(randGenerator);
+
+    vector<double> vect(columns);
+    for(int col = 0; col < columns; col++)
+        vect[col] = drawElement(randGenerator, dis, minBound, maxBound);
+    return vect;
+}
+
 /**
  * @brief Calculates the fitness of a vector.
  *
  * The fitness of a vector is calculated by the Benchmark Function
  * referenced by the functionID.
  *
- * @note This function makes a call to BenchmarkFunctions.h.
+ * If a FitnessMemo is installed on the calling thread (setFitnessMemo()),
+ * the fitness of the expensive functions is looked up first and stored after it's calculated,
+ * so a vector a search comes back to isn't evaluated twice.
+ *
+ * @note This function makes a call to utilities.h --> evaluateBenchmarkFunction().
  *
  * @param vect The vector of elements on which the Benchmark Functions operate.
  * @param functionID The ID that references which Benchmark Function to use.
@@ -219,6 +561,31 @@ vector<vector<double>> createMatrix(int rows, int columns, double minBound, doub
  * @return The fitness of the vector.
  */
 double calculateFitnessOfVector(vector<double> &vect, int functionID)
+{
+    FitnessMemo *memo = getFitnessMemo();
+    if(memo == nullptr || !functionIsExpensive(functionID))
+        return evaluateBenchmarkFunction(vect, functionID);
+
+    double fitness;
+    uint64_t hash;
+    if(memo->lookup(functionID, vect, fitness, hash))
+        return fitness;
+    fitness = evaluateBenchmarkFunction(vect, functionID);
+    memo->insert(functionID, vect, fitness, hash);
+    return fitness;
+}
+
+/**
+ * @brief Calls the Benchmark Function referenced by the functionID.
+ *
+ * @note This function makes a call to BenchmarkFunctions.h.
+ *
+ * @param vect The vector of elements on which the Benchmark Functions operate.
+ * @param functionID The ID that references which Benchmark Function to use.
+ *
+ * @return The fitness of the vector.
+ */
+double evaluateBenchmarkFunction(vector<double> &vect, int functionID)
 {
     switch(functionID)
     {
@@ -266,6 +633,554 @@ double calculateFitnessOfVector(vector<double> &vect, int functionID)
     }
 }
 
+/**
+ * @brief Calculates the fitness of a vector, giving up once it can't beat a threshold.
+ *
+ * Functions whose terms have a known lower bound (De Jong, Rosenbrock,
+ * Rastrigin, Quartic, Levy, Step and Alpine) use their bounded versions,
+ * which stop summing as soon as the fitness is certain to end up above the
+ * threshold. In a search most candidates are worse than the best so far,
+ * so most of them are rejected after only a fraction of their elements.
+ * The other functions are evaluated in full.
+ *
+ * @note A vector that isn't rejected gets exactly the fitness calculateFitnessOfVector() gives it.
+ * @note This function makes a call to BenchmarkFunctions.h.
+ *
+ * @param vect The vector of elements on which the Benchmark Functions operate.
+ * @param functionID The ID that references which Benchmark Function to use.
+ * @param threshold The fitness the vector has to reach to be of any use.
+ *
+ * @return The fitness of the vector, or FITNESS_REJECTED if it is certain to be above threshold.
+ */
+double calculateFitnessOfVectorBounded(vector<double> &vect, int functionID, double threshold)
+{
+    switch(functionID)
+    {
+        case 2:
+            return deJongsFuncBounded(vect, vect.size(), threshold);
+        case 3:
+            return rosenbrockFuncBounded(vect, vect.size(), threshold);
+        case 4:
+            return rastriginFuncBounded(vect, vect.size(), threshold);
+        case 15:
+            return quarticFuncBounded(vect, vect.size(), threshold);
+        case 16:
+            return levyFuncBounded(vect, vect.size(), threshold);
+        case 17:
+            return stepFuncBounded(vect, vect.size(), threshold);
+        case 18:
+            return alpineFuncBounded(vect, vect.size(), threshold);
+
+        default:
+            return calculateFitnessOfVector(vect, functionID);
+    }
+}
+
+/**
+ * @brief Calculates the change in fitness caused by replacing one element of a vector.
+ *
+ * Only the Benchmark Function terms that contain vect[index] are re-evaluated:
+ * one term for separable functions, and the (up to) two neighbouring pair terms
+ * for the others. This makes scoring a single-coordinate move O(1) instead of
+ * O(size). The Griewangk function couples every element through its product,
+ * so it falls back to a full evaluation of the moved vector.
+ *
+ * @note The vector is left unchanged; the caller applies the move if accepted.
+ * @note This function makes a call to BenchmarkFunctions.h.
+ *
+ * @param vect The vector of elements on which the Benchmark Functions operate.
+ * @param functionID The ID that references which Benchmark Function to use.
+ * @param index The index of the element being replaced.
+ * @param newValue The value that would replace vect[index].
+ * @param currentFitness The current fitness of vect (only used by the full evaluation fallback).
+ *
+ * @return The new fitness minus the current fitness.
+ */
+double calculateFitnessDelta(vector<double> &vect, int functionID, int index, double newValue, double currentFitness)
+{
+    int size = vect.size();
+    double oldValue = vect[index];
+
+    // Sums the change of the (up to two) neighbouring pair terms that contain vect[index].
+    auto pairDelta = [&vect, size, index, oldValue, newValue](double (*term)(double, double))
+    {
+        double delta = 0;
+        if(index > 0)
+            delta += term(vect[index-1], newValue) - term(vect[index-1], oldValue);
+        if(index < size-1)
+            delta += term(newValue, vect[index+1]) - term(oldValue, vect[index+1]);
+        return delta;
+    };
+
+    switch(functionID)
+    {
+        case 1:
+            return -(schefelsTerm(newValue) - schefelsTerm(oldValue));
+        case 2:
+            return deJongsTerm(newValue) - deJongsTerm(oldValue);
+        case 3:
+            return pairDelta(rosenbrockTerm);
+        case 4:
+            return 10 * size * (rastriginTerm(newValue) - rastriginTerm(oldValue));
+        case 5:
+        {
+            // The product term couples every element, so re-evaluate the whole vector.
+            vect[index] = newValue;
+            double newFitness = griewangkFunc(vect, size);
+            vect[index] = oldValue;
+            return newFitness - currentFitness;
+        }
+        case 6:
+            return -pairDelta(sineEnvelopeSineWaveTerm);
+        case 7:
+            return pairDelta(stretchedVSineWaveTerm);
+        case 8:
+            return pairDelta(ackleysOneTerm);
+        case 9:
+            return pairDelta(ackleysTwoTerm);
+        case 10:
+            return pairDelta(eggHolderTerm);
+        case 11:
+            return pairDelta(ranaTerm);
+        case 12:
+            return pairDelta(pathologicalTerm);
+        case 13:
+            return -(michalewiczTerm(newValue, index) - michalewiczTerm(oldValue, index));
+        case 14:
+            return -pairDelta(mastersCosWaveTerm);
+        case 15:
+            return quarticTerm(newValue, index) - quarticTerm(oldValue, index);
+        case 16:
+        {
+            // The first element has its own term, and the last element's term is added size-1 times.
+            double delta = 0;
+            if(index == 0)
+                delta += levyFirstTerm(newValue) - levyFirstTerm(oldValue);
+            if(index < size-1)
+                delta += levyTerm(newValue) - levyTerm(oldValue);
+            else
+                delta += (size-1) * (levyLastTerm(newValue) - levyLastTerm(oldValue));
+            return delta;
+        }
+        case 17:
+            return stepTerm(newValue) - stepTerm(oldValue);
+        case 18:
+            return alpineTerm(newValue) - alpineTerm(oldValue);
+
+        default:
+            cout << "Fitness Delta Failed for Function ID: " << functionID << endl;
+            cout << "Possible Function IDs: 1 - 18\n\n";
+            return 0.0;
+    }
+}
+
+/**
+ * @brief Calculates the forward differences f(vect + step*e_i) - f(vect) for every element i.
+ *
+ * This is the finite-difference gradient estimate (scaled by step) in one
+ * pass. Every function except Griewangk only re-scores the terms that
+ * contain the stepped element (see calculateFitnessDelta()), so the whole
+ * estimate costs O(size) instead of size full evaluations. Griewangk's
+ * product is handled with running prefix/suffix products, which is O(size)
+ * as well.
+ *
+ * @note This function makes a call to utilities.h --> calculateFitnessDelta().
+ *
+ * @param vect The vector of elements on which the Benchmark Functions operate.
+ * @param functionID The ID that references which Benchmark Function to use.
+ * @param step The amount added to each element.
+ * @param fitness The fitness of vect.
+ *
+ * @return A vector of the change in fitness caused by stepping each element.
+ */
+vector<double> calculateFitnessDifferences(vector<double> &vect, int functionID, double step, double fitness)
+{
+    int size = vect.size();
+    vector<double> differences(size);
+
+    if(functionID == 5)
+    {
+        // Griewangk: 1 + sum(x^2/4000) - prod(cos(x/sqrt(i+1))). Stepping x_i scales the
+        // product by the product of every other cosine, kept as prefix * suffix.
+        vector<double> cosines(size), suffix(size + 1);
+        for(int i = 0; i < size; ++i)
+            cosines[i] = cos(vect[i] / sqrt(i+1));
+        suffix[size] = 1;
+        for(int i = size-1; i >= 0; --i)
+            suffix[i] = suffix[i+1] * cosines[i];
+
+        double prefix = 1;
+        for(int i = 0; i < size; ++i)
+        {
+            double newValue = vect[i] + step;
+            double sumDelta = (pow(newValue, 2) - pow(vect[i], 2)) / 4000;
+            double productDelta = prefix * suffix[i+1] * (cos(newValue / sqrt(i+1)) - cosines[i]);
+            differences[i] = sumDelta - productDelta;
+            prefix *= cosines[i];
+        }
+        return differences;
+    }
+
+    // Every other function only changes the terms that contain the stepped element.
+    for(int i = 0; i < size; ++i)
+        differences[i] = calculateFitnessDelta(vect, functionID, i, vect[i] + step, fitness);
+
+    return differences;
+}
+
+/**
+ * @brief Calculates the fitness of a vector and its gradient.
+ *
+ * The smooth functions (see BenchmarkFunctions.h --> functionHasGradient())
+ * calculate their analytic gradient in the same pass as the fitness. The
+ * gradient of every other function is estimated with central differences,
+ * each one scored with calculateFitnessDelta(), so it costs O(size) terms
+ * rather than 2*size full evaluations.
+ *
+ * @note This function makes a call to BenchmarkFunctions.h.
+ * @note This function makes a call to utilities.h --> calculateFitnessDelta().
+ *
+ * @param vect The vector of elements on which the Benchmark Functions operate.
+ * @param functionID The ID that references which Benchmark Function to use.
+ * @param gradient Set to the gradient of the fitness (resized to the size of vect).
+ * @param step The step of the central differences (only used by functions without an analytic gradient).
+ *
+ * @return The fitness of vect.
+ */
+double calculateFitnessAndGradient(vector<double> &vect, int functionID, vector<double> &gradient, double step)
+{
+    int size = vect.size();
+    gradient.resize(size);
+
+    switch(functionID)
+    {
+        case 2:
+            return deJongsFuncGradient(vect, size, gradient);
+        case 3:
+            return rosenbrockFuncGradient(vect, size, gradient);
+        case 5:
+            return griewangkFuncGradient(vect, size, gradient);
+        case 14:
+            return mastersCosWaveFuncGradient(vect, size, gradient);
+        case 15:
+            return quarticFuncGradient(vect, size, gradient);
+    }
+
+    double fitness = calculateFitnessOfVector(vect, functionID);
+    for(int i = 0; i < size; ++i)
+    {
+        double forward = calculateFitnessDelta(vect, functionID, i, vect[i] + step, fitness);
+        double backward = calculateFitnessDelta(vect, functionID, i, vect[i] - step, fitness);
+        gradient[i] = (forward - backward) / (2 * step);
+    }
+
+    return fitness;
+}
+
+/**
+ * @brief Calculates the forward differences of several vectors at once, interleaved lane by lane.
+ *
+ * The vectors are stored interleaved: element d of the vector in lane l is
+ * interleaved[d*width + l]. The function switch is made once, and every
+ * loop runs across the lanes, over contiguous memory. Each lane gets exactly
+ * the differences calculateFitnessDifferences() gives its vector.
+ *
+ * @param interleaved The interleaved vectors (size*width elements).
+ * @param width The number of lanes (vectors).
+ * @param size The number of elements in each vector.
+ * @param functionID The ID that references which Benchmark Function to use.
+ * @param step The amount added to each element.
+ * @param differences Set to the interleaved differences (resized to size*width).
+ */
+void calculateFitnessDifferencesInterleaved(vector<double> &interleaved, int width, int size, int functionID, double step, vector<double> &differences)
+{
+    int count = size * width;
+    double *x = interleaved.data();
+    differences.resize(count);
+
+    // The differences of the functions with one term per element, and with one term per pair of neighbouring elements.
+    auto single = [&](double (*term)(double), double scale)
+    {
+        for(int k = 0; k < count; ++k)
+            differences[k] = scale * (term(x[k] + step) - term(x[k]));
+    };
+    auto indexed = [&](double (*term)(double, int), double scale)
+    {
+        for(int d = 0; d < size; ++d)
+            for(int k = d * width; k < (d+1) * width; ++k)
+                differences[k] = scale * (term(x[k] + step, d) - term(x[k], d));
+    };
+    auto pair = [&](double (*term)(double, double), double scale)
+    {
+        for(int d = 0; d < size; ++d)
+        {
+            for(int k = d * width; k < (d+1) * width; ++k)
+            {
+                double oldValue = x[k], newValue = x[k] + step;
+                double delta = 0;
+                if(d > 0)
+                    delta += term(x[k-width], newValue) - term(x[k-width], oldValue);
+                if(d < size-1)
+                    delta += term(newValue, x[k+width]) - term(oldValue, x[k+width]);
+                differences[k] = scale * delta;
+            }
+        }
+    };
+
+    switch(functionID)
+    {
+        case 1:
+            return single(schefelsTerm, -1.0);
+        case 2:
+            return single(deJongsTerm, 1.0);
+        case 3:
+            return pair(rosenbrockTerm, 1.0);
+        case 4:
+            return single(rastriginTerm, 10.0 * size);
+        case 5:
+        {
+            // Griewangk, with the running prefix and suffix products of every lane (see calculateFitnessDifferences()).
+            vector<double> cosines(count), suffix(count + width), prefix(width, 1.0);
+            for(int d = 0; d < size; ++d)
+                for(int k = d * width; k < (d+1) * width; ++k)
+                    cosines[k] = cos(x[k] / sqrt(d+1));
+            for(int l = 0; l < width; ++l)
+                suffix[count + l] = 1;
+            for(int k = count-1; k >= 0; --k)
+                suffix[k] = suffix[k+width] * cosines[k];
+
+            for(int d = 0; d < size; ++d)
+            {
+                for(int l = 0, k = d * width; l < width; ++l, ++k)
+                {
+                    double newValue = x[k] + step;
+                    double sumDelta = (pow(newValue, 2) - pow(x[k], 2)) / 4000;
+                    double productDelta = prefix[l] * suffix[k+width] * (cos(newValue / sqrt(d+1)) - cosines[k]);
+                    differences[k] = sumDelta - productDelta;
+                    prefix[l] *= cosines[k];
+                }
+            }
+            return;
+        }
+        case 6:
+            return pair(sineEnvelopeSineWaveTerm, -1.0);
+        case 7:
+            return pair(stretchedVSineWaveTerm, 1.0);
+        case 8:
+            return pair(ackleysOneTerm, 1.0);
+        case 9:
+            return pair(ackleysTwoTerm, 1.0);
+        case 10:
+            return pair(eggHolderTerm, 1.0);
+        case 11:
+            return pair(ranaTerm, 1.0);
+        case 12:
+            return pair(pathologicalTerm, 1.0);
+        case 13:
+            return indexed(michalewiczTerm, -1.0);
+        case 14:
+            return pair(mastersCosWaveTerm, -1.0);
+        case 15:
+            return indexed(quarticTerm, 1.0);
+        case 16:
+        {
+            // The first element has its own term, and the last element's term is added size-1 times.
+            for(int d = 0; d < size; ++d)
+            {
+                for(int k = d * width; k < (d+1) * width; ++k)
+                {
+                    double oldValue = x[k], newValue = x[k] + step;
+                    double delta = 0;
+                    if(d == 0)
+                        delta += levyFirstTerm(newValue) - levyFirstTerm(oldValue);
+                    if(d < size-1)
+                        delta += levyTerm(newValue) - levyTerm(oldValue);
+                    else
+                        delta += (size-1) * (levyLastTerm(newValue) - levyLastTerm(oldValue));
+                    differences[k] = delta;
+                }
+            }
+            return;
+        }
+        case 17:
+            return single(stepTerm, 1.0);
+        case 18:
+            return single(alpineTerm, 1.0);
+
+        default:
+            fill(differences.begin(), differences.end(), 0.0);
+            cout << "Fitness Delta Failed for Function ID: " << functionID << endl;
+            cout << "Possible Function IDs: 1 - 18\n\n";
+    }
+}
+
+/**
+ * @brief Sums term(i, lane) for i in [0, count) in every lane, giving up on each lane once its fitness can't reach its threshold.
+ *
+ * The same check as the bounded Benchmark Functions, made once per
+ * BOUNDED_EVALUATION_BLOCK terms. A rejected lane is only masked: it goes
+ * on being summed with the others (its sum is never used), and the sum
+ * stops early once every lane is rejected.
+ *
+ * @param term The i-th term of a lane.
+ * @param count The number of terms.
+ * @param width The number of lanes.
+ * @param minTerm The smallest value a term can have.
+ * @param scale The fitness is scale * sum + offset.
+ * @param offsets The offset of each lane.
+ * @param thresholds The fitness above which each lane is rejected, or nullptr to sum every term.
+ * @param sums Set to the sum of each lane.
+ * @param rejected Set to whether each lane was rejected.
+ */
+template <typename Term>
+static void interleavedSum(Term term, int count, int width, double minTerm, double scale, const double *offsets, const double *thresholds, vector<double> &sums, vector<char> &rejected)
+{
+    sums.assign(width, 0.0);
+    rejected.assign(width, false);
+    int remaining = width;
+    for(int blockStart = 0; blockStart < count && remaining > 0; blockStart += BOUNDED_EVALUATION_BLOCK)
+    {
+        int blockEnd = min(blockStart + BOUNDED_EVALUATION_BLOCK, count);
+        for(int i = blockStart; i < blockEnd; ++i)
+            for(int l = 0; l < width; ++l)
+                sums[l] += term(i, l);
+
+        if(thresholds == nullptr)
+            continue;
+        for(int l = 0; l < width; ++l)
+        {
+            if(!rejected[l] && scale * (sums[l] + minTerm * (count - blockEnd)) + offsets[l] > thresholds[l])
+            {
+                rejected[l] = true;
+                remaining--;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Calculates the fitness of several vectors at once, interleaved lane by lane, giving up on each once it can't beat its threshold.
+ *
+ * The vectors are stored as in calculateFitnessDifferencesInterleaved().
+ * Every lane is summed element by element in the order its Benchmark
+ * Function uses, so each lane gets exactly the fitness
+ * calculateFitnessOfVectorBounded() gives its vector (rejected or not).
+ *
+ * @param interleaved The interleaved vectors (size*width elements).
+ * @param width The number of lanes (vectors).
+ * @param size The number of elements in each vector.
+ * @param functionID The ID that references which Benchmark Function to use.
+ * @param thresholds The fitness each lane has to reach to be of any use.
+ * @param fitness Set to the fitness of each lane, or FITNESS_REJECTED (resized to width).
+ */
+void calculateFitnessOfInterleavedBounded(vector<double> &interleaved, int width, int size, int functionID, vector<double> &thresholds, vector<double> &fitness)
+{
+    double *x = interleaved.data();
+    vector<double> sums, zeros(width, 0.0);
+    vector<char> rejected;
+    fitness.resize(width);
+
+    // The term of each element, and of each pair of neighbouring elements.
+    auto single = [x, width](double (*term)(double)) { return [x, width, term](int i, int l) { return term(x[i*width + l]); }; };
+    auto indexed = [x, width](double (*term)(double, int)) { return [x, width, term](int i, int l) { return term(x[i*width + l], i); }; };
+    auto pair = [x, width](double (*term)(double, double)) {
+        return [x, width, term](int i, int l) { return term(x[i*width + l], x[(i+1)*width + l]); }; };
+
+    // A full sum, and a sum abandoned against the thresholds (the fitness is scale * sum).
+    auto sum = [&](auto term, int count) { interleavedSum(term, count, width, 0.0, 1.0, zeros.data(), nullptr, sums, rejected); };
+    auto bounded = [&](auto term, int count, double minTerm, double scale)
+    {
+        interleavedSum(term, count, width, minTerm, scale, zeros.data(), thresholds.data(), sums, rejected);
+        for(int l = 0; l < width; ++l)
+            fitness[l] = rejected[l] ? FITNESS_REJECTED : scale * sums[l];
+    };
+    auto withSign = [&](double sign) {
+        for(int l = 0; l < width; ++l)
+            fitness[l] = sign * sums[l];
+    };
+
+    switch(functionID)
+    {
+        case 1:
+            sum(single(schefelsTerm), size);
+            for(int l = 0; l < width; ++l)
+                fitness[l] = (418.9829 * size) - sums[l];
+            return;
+        case 2:
+            return bounded(single(deJongsTerm), size, 0.0, 1.0);
+        case 3:
+            return bounded(pair(rosenbrockTerm), size-1, 0.0, 1.0);
+        case 4:
+            return bounded(single(rastriginTerm), size, -10.0, 10 * size);
+        case 5:
+        {
+            // The sum and the product are each accumulated in the order griewangkFunc() uses.
+            vector<double> productUp(width, 1.0);
+            sum([x, width](int i, int l) { return pow(x[i*width + l], 2) / 4000; }, size);
+            for(int i = 0; i < size; ++i)
+                for(int l = 0; l < width; ++l)
+                    productUp[l] *= cos(x[i*width + l] / sqrt(i+1));
+            for(int l = 0; l < width; ++l)
+                fitness[l] = 1 + sums[l] - productUp[l];
+            return;
+        }
+        case 6:
+            sum(pair(sineEnvelopeSineWaveTerm), size-1);
+            return withSign(-1.0);
+        case 7:
+            sum(pair(stretchedVSineWaveTerm), size-1);
+            return withSign(1.0);
+        case 8:
+            sum(pair(ackleysOneTerm), size-1);
+            return withSign(1.0);
+        case 9:
+            sum(pair(ackleysTwoTerm), size-1);
+            return withSign(1.0);
+        case 10:
+            sum(pair(eggHolderTerm), size-1);
+            return withSign(1.0);
+        case 11:
+            sum(pair(ranaTerm), size-1);
+            return withSign(1.0);
+        case 12:
+            sum(pair(pathologicalTerm), size-1);
+            return withSign(1.0);
+        case 13:
+            sum(indexed(michalewiczTerm), size);
+            return withSign(-1.0);
+        case 14:
+            sum(pair(mastersCosWaveTerm), size-1);
+            return withSign(-1.0);
+        case 15:
+            return bounded(indexed(quarticTerm), size, 0.0, 1.0);
+        case 16:
+        {
+            // Every term adds the last element's term, and the first element's term is the offset.
+            vector<double> firstTerms(width), lastTerms(width);
+            for(int l = 0; l < width; ++l)
+            {
+                firstTerms[l] = levyFirstTerm(x[l]);
+                lastTerms[l] = levyLastTerm(x[(size-1)*width + l]);
+            }
+            double *last = lastTerms.data();
+            interleavedSum([x, width, last](int i, int l) { return levyTerm(x[i*width + l]) + last[l]; },
+                           size-1, width, 0.0, 1.0, firstTerms.data(), thresholds.data(), sums, rejected);
+            for(int l = 0; l < width; ++l)
+                fitness[l] = rejected[l] ? FITNESS_REJECTED : firstTerms[l] + sums[l];
+            return;
+        }
+        case 17:
+            return bounded(single(stepTerm), size, 0.0, 1.0);
+        case 18:
+            return bounded(single(alpineTerm), size, 0.0, 1.0);
+
+        default:
+            fill(fitness.begin(), fitness.end(), 1.0);
+            cout << "Fitness Process Failed for Function ID: " << functionID << endl;
+            cout << "Possible Function IDs: 1 - 18\n\n";
+    }
+}
+
 /**
  * @brief Calculates the fitness of all vectors of a matrix.
  *
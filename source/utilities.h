@@ -13,11 +13,18 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <charconv>
+#include <stdexcept>
 #include <string.h>
 #include <vector>
 #include <cmath>
 #include <random>
+#include <thread>
+#include <algorithm>
 #include "BenchmarkFunctions.h"
+#include "TermTable.h"
+#include "FitnessMemo.h"
 
 using namespace std;
 
@@ -30,16 +37,54 @@ vector<int> parseStringInt(string str, string delimiter);
 /** Parses a string of characters into a vector of strings.*/
 vector<string> parseStringStr(string str, string delimiter);
 
+/** Splits the next token off a string, without copying it.*/
+bool nextToken(string_view &text, string_view delimiters, string_view &token);
+/** Parses a token (a number or pi) into a double, without allocating.*/
+bool parseNumber(string_view token, double &value);
+/** Parses a token (an integer or pi) into an int, without allocating.*/
+bool parseNumber(string_view token, int &value);
+/** Parses a token into an unsigned int, without allocating.*/
+bool parseNumber(string_view token, unsigned int &value);
+/** Parses every number on a line into a vector of doubles, reusing its storage.*/
+bool parseNumbers(string_view line, string_view delimiters, vector<double> &values, string &error);
+/** Parses every number on a line into a vector of integers, reusing its storage.*/
+bool parseNumbers(string_view line, string_view delimiters, vector<int> &values, string &error);
+/** Formats a parse error as filename:lineNumber: error.*/
+string lineError(string filename, int lineNumber, string error);
+
 /** Preps the setup vector for the matrix of a function by resizing to size 3.*/
 void prepForFunctionMatrix(vector<double> &setup);
 
+/** Seeds the random number generators created on this thread from now on.*/
+void setRandomSeed(unsigned int seed);
+/** Returns a new seed for a random number generator.*/
+unsigned int nextRandomSeed();
+
 /** Creates a matrix with the given min/max bound for the given number of rows/columns.*/
 vector<vector<double>> createMatrix(int rows, int columns, double minBound, double maxBound);
+/** Draws a random vector and calculates its fitness without storing it, or FITNESS_REJECTED once it is certain to be above a threshold.*/
+double sampleFitnessOfVector(mt19937 &randGenerator, int columns, double minBound, double maxBound, int functionID, double threshold, const TermTable *table = nullptr);
+/** Regenerates the vector drawn after index others from a Mersenne Twister with the given seed.*/
+vector<double> regenerateVector(unsigned int seed, int index, int columns, double minBound, double maxBound);
 
 /** Calculates the fitness of a single vector.*/
 double calculateFitnessOfVector(vector<double> &vect, int functionID);
+/** Calculates the fitness of a single vector, never consulting the fitness memo.*/
+double evaluateBenchmarkFunction(vector<double> &vect, int functionID);
+/** Calculates the fitness of a single vector, or FITNESS_REJECTED once it is certain to be above a threshold.*/
+double calculateFitnessOfVectorBounded(vector<double> &vect, int functionID, double threshold);
 /** Calculates the fitness of all vectors in matrix.*/
 vector<double> calculateFitnessOfMatrix(vector<vector<double>> matrix, int functionID);
+/** Calculates the change in fitness caused by replacing a single element of a vector.*/
+double calculateFitnessDelta(vector<double> &vect, int functionID, int index, double newValue, double currentFitness);
+/** Calculates the forward difference of the fitness for every element of a vector (a scaled gradient estimate).*/
+vector<double> calculateFitnessDifferences(vector<double> &vect, int functionID, double step, double fitness);
+/** Calculates the fitness of a vector and its gradient (analytic, or central differences for the functions without one).*/
+double calculateFitnessAndGradient(vector<double> &vect, int functionID, vector<double> &gradient, double step);
+/** Calculates the forward differences of several interleaved vectors (element d of lane l at d*width + l) at once.*/
+void calculateFitnessDifferencesInterleaved(vector<double> &interleaved, int width, int size, int functionID, double step, vector<double> &differences);
+/** Calculates the fitness of several interleaved vectors at once, or FITNESS_REJECTED for each one certain to be above its threshold.*/
+void calculateFitnessOfInterleavedBounded(vector<double> &interleaved, int width, int size, int functionID, vector<double> &thresholds, vector<double> &fitness);
 
 /** Calculates the average value of a vector of doubles.*/
 double calculateAverage(vector<double> vect);